@@ -23,10 +23,34 @@ public class BlueprintHttp : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
-				"HTTP"
+				"HTTP",
+				"Json",
+				"PakFile",
+				"Slate",
+				"SlateCore",
+				"WebSockets"
 			}
 		);
 		
 		PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "Public"));
+
+		// Delta patches and archives are inflated as they are read.
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
+		// The benchmarks spin up a local HTTP server and read baselines from the plugin, keep them out of shipping builds.
+		bool bWithBenchmarks = Target.Configuration != UnrealTargetConfiguration.Shipping;
+
+		if (bWithBenchmarks)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"HTTPServer",
+					"Projects"
+				}
+			);
+		}
+
+		PrivateDefinitions.Add("WITH_BLUEPRINTHTTP_BENCHMARKS=" + (bWithBenchmarks ? "1" : "0"));
 	}
 }
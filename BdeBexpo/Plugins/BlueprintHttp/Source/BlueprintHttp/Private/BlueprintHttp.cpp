@@ -2,6 +2,13 @@
 
 #include "BlueprintHttp.h"
 #include "HttpModule.h"
+#include "HttpTransport.h"
+#include "HttpThreadTuner.h"
+#include "HttpCompletionDispatcher.h"
+#include "HttpRequestScheduler.h"
+#include "HttpCancellation.h"
+#include "HttpRequestWatchdog.h"
+#include "HttpConnectionWarmer.h"
 
 #define LOCTEXT_NAMESPACE "BlueprintHttpModule"
 
@@ -9,11 +16,20 @@ void FBlueprintHttpModule::StartupModule()
 {
 	const FName HttpModuleName = TEXT("HTTP");
 	FHttpModule& Module = FModuleManager::LoadModuleChecked<FHttpModule>(HttpModuleName);
+
+	FHttpTransports::InitFromCommandLine();
+	FHttpCancellation::Startup();
 }
 
 void FBlueprintHttpModule::ShutdownModule()
 {
-
+	FHttpCancellation::Shutdown();
+	FHttpRequestWatchdog::Reset();
+	FHttpConnectionWarmer::Reset();
+	FHttpRequestScheduler::Reset();
+	FHttpCompletionDispatcher::Reset();
+	FHttpThreadTuner::SetPreset(EHttpThreadTuningPreset::Manual);
+	FHttpTransports::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
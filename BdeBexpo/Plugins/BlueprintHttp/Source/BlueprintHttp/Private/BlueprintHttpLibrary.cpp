@@ -4,6 +4,11 @@
 #include "GenericPlatform/GenericPlatformHttp.h"
 #include "Http.h"
 #include "HttpModule.h"
+#include "HttpCompletionDispatcher.h"
+#include "HttpCancellation.h"
+#include "HttpResponseBody.h"
+#include "HttpBase64.h"
+#include "HttpUrlCodec.h"
 #include "Misc/Base64.h"
 #include "EngineMinimal.h"
 
@@ -63,21 +68,25 @@ void UBlueprintHttpLibrary::HttpGlobal_SetHttpTimeout(const float Timeout)
 
 void UBlueprintHttpLibrary::HttpGlobal_SetHttpThreadIdleMinimumSleepTimeInSeconds(const float Time)
 {
+	FHttpThreadTuner::SetPreset(EHttpThreadTuningPreset::Manual);
 	FHttpModule::Get().SetHttpThreadIdleMinimumSleepTimeInSeconds(Time);
 }
 
 void UBlueprintHttpLibrary::HttpGlobal_SetHttpThreadIdleFrameTimeInSeconds(const float Time)
 {
+	FHttpThreadTuner::SetPreset(EHttpThreadTuningPreset::Manual);
 	FHttpModule::Get().SetHttpThreadIdleFrameTimeInSeconds(Time);
 }
 
 void UBlueprintHttpLibrary::HttpGlobal_SetHttpThreadActiveMinimumSleepTimeInSeconds(const float Time)
 {
+	FHttpThreadTuner::SetPreset(EHttpThreadTuningPreset::Manual);
 	FHttpModule::Get().SetHttpThreadActiveMinimumSleepTimeInSeconds(Time);
 }
 
 void UBlueprintHttpLibrary::HttpGlobal_SetHttpThreadActiveFrameTimeInSeconds(const float Time)
 {
+	FHttpThreadTuner::SetPreset(EHttpThreadTuningPreset::Manual);
 	FHttpModule::Get().SetHttpThreadActiveFrameTimeInSeconds(Time);
 }
 
@@ -86,6 +95,178 @@ void UBlueprintHttpLibrary::HttpGlobal_SetHttpDelayTime(const float Delay)
 	FHttpModule::Get().SetHttpDelayTime(Delay);
 }
 
+void UBlueprintHttpLibrary::HttpGlobal_SetHttpThreadTuningPreset(const EHttpThreadTuningPreset Preset)
+{
+	FHttpThreadTuner::SetPreset(Preset);
+}
+
+EHttpThreadTuningPreset UBlueprintHttpLibrary::HttpGlobal_GetHttpThreadTuningPreset()
+{
+	return FHttpThreadTuner::GetPreset();
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetPowerHint(const EHttpPowerHint Hint)
+{
+	FHttpThreadTuner::SetPowerHint(Hint);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetDefaultProgressPolicy(const FHttpProgressPolicy& Policy)
+{
+	UHttpRequest::SetDefaultProgressPolicy(Policy);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetCompletionFrameBudget(const float Milliseconds)
+{
+	FHttpCompletionDispatcher::SetFrameBudget(Milliseconds / 1000.f);
+}
+
+int32 UBlueprintHttpLibrary::HttpGlobal_GetCompletionBacklog()
+{
+	return FHttpCompletionDispatcher::GetBacklog();
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetBandwidthLimit(const FHttpBandwidthLimit& Limit)
+{
+	FHttpRequestScheduler::SetGlobalLimit(Limit);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetHostBandwidthLimit(const FString& Host, const FHttpBandwidthLimit& Limit)
+{
+	FHttpRequestScheduler::SetHostLimit(Host, Limit);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetPriorityBandwidthLimit(const EHttpRequestPriority Priority, const FHttpBandwidthLimit& Limit)
+{
+	FHttpRequestScheduler::SetPriorityLimit(Priority, Limit);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_ClearBandwidthLimits()
+{
+	FHttpRequestScheduler::ClearLimits();
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_PrewarmConnections(const TArray<FString>& Hosts, const float KeepWarmDuration)
+{
+	FHttpConnectionWarmer::Prewarm(Hosts, KeepWarmDuration);
+}
+
+FHttpFirstByteStats UBlueprintHttpLibrary::HttpGlobal_GetTimeToFirstByte(const FString& Host)
+{
+	return FHttpConnectionWarmer::GetFirstByteStats(Host);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetResponseMemoryBudget(const int32 BudgetMB, const int32 SpillThresholdMB)
+{
+	FHttpResponseMemory::SetBudget		 (static_cast<int64>(BudgetMB)		   * 1024 * 1024);
+	FHttpResponseMemory::SetSpillThreshold(static_cast<int64>(SpillThresholdMB) * 1024 * 1024);
+}
+
+int64 UBlueprintHttpLibrary::HttpGlobal_GetBufferedResponseBytes()
+{
+	return FHttpResponseMemory::GetBufferedBytes();
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_BindRequestToOwner(UHttpRequest* const Request, UObject* const Owner)
+{
+	FHttpCancellation::BindToOwner(Request, Owner);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_BindRequestToScope(UHttpRequest* const Request, const FName Scope)
+{
+	FHttpCancellation::BindToScope(Request, Scope);
+}
+
+void UBlueprintHttpLibrary::BindHttpNodeToOwner(UBlueprintAsyncActionBase* const Node, UObject* const Owner)
+{
+	UHttpRequest* const Request = FHttpCancellation::GetNodeRequest(Node);
+
+	if (!Request)
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Bind HTTP Node to Owner: The node isn't an HTTP node or has no request."));
+		return;
+	}
+
+	FHttpCancellation::BindToOwner(Request, Owner, Node);
+}
+
+void UBlueprintHttpLibrary::BindHttpNodeToScope(UBlueprintAsyncActionBase* const Node, const FName Scope)
+{
+	UHttpRequest* const Request = FHttpCancellation::GetNodeRequest(Node);
+
+	if (!Request)
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Bind HTTP Node to Scope: The node isn't an HTTP node or has no request."));
+		return;
+	}
+
+	FHttpCancellation::BindToScope(Request, Scope, Node);
+}
+
+int32 UBlueprintHttpLibrary::CancelHttpScope(const FName Scope, const bool bNotifyListeners)
+{
+	return FHttpCancellation::CancelScope(Scope, bNotifyListeners);
+}
+
+int32 UBlueprintHttpLibrary::CancelHttpRequestsOfOwner(UObject* const Owner, const bool bNotifyListeners)
+{
+	return FHttpCancellation::CancelOwner(Owner, bNotifyListeners);
+}
+
+bool UBlueprintHttpLibrary::HttpGlobal_SetTransportMode(const EHttpTransportMode Mode, const FString& ArchivePath, const bool bReplayOriginalTiming)
+{
+	return FHttpTransports::SetMode(Mode, ArchivePath, bReplayOriginalTiming);
+}
+
+EHttpTransportMode UBlueprintHttpLibrary::HttpGlobal_GetTransportMode()
+{
+	return FHttpTransports::GetMode();
+}
+
+bool UBlueprintHttpLibrary::HttpGlobal_FlushRecording()
+{
+	return FHttpTransports::FlushRecording();
+}
+
+bool UBlueprintHttpLibrary::HttpGlobal_SetNetworkSimulationProfile(const FName ProfileName)
+{
+	return FHttpNetworkSimulator::SetProfile(ProfileName);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_SetNetworkSimulationConditions(const FHttpNetworkConditions& Conditions)
+{
+	FHttpNetworkSimulator::SetConditions(Conditions);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_DisableNetworkSimulation()
+{
+	FHttpNetworkSimulator::Disable();
+}
+
+FName UBlueprintHttpLibrary::HttpGlobal_GetNetworkSimulationProfile()
+{
+	return FHttpNetworkSimulator::GetProfileName();
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_RegisterNetworkSimulationProfile(const FName ProfileName, const FHttpNetworkConditions& Conditions)
+{
+	FHttpNetworkSimulator::RegisterProfile(ProfileName, Conditions);
+}
+
+void UBlueprintHttpLibrary::HttpGlobal_RegisterClientProfile(const FName ProfileName, const FHttpClientProfile& Profile)
+{
+	FHttpClientProfiles::Register(ProfileName, Profile);
+}
+
+bool UBlueprintHttpLibrary::HttpGlobal_UnregisterClientProfile(const FName ProfileName)
+{
+	return FHttpClientProfiles::Unregister(ProfileName);
+}
+
+bool UBlueprintHttpLibrary::HttpGlobal_FindClientProfile(const FName ProfileName, FHttpClientProfile& OutProfile)
+{
+	return FHttpClientProfiles::Find(ProfileName, OutProfile);
+}
+
 const UEnum* GetEHttpResponseCodeEnumPointer()
 {
 	PRAGMA_DISABLE_DEPRECATION_WARNINGS
@@ -167,38 +348,56 @@ EHttpResponseCode UBlueprintHttpLibrary::HttpResponseCodeToEnum(const int32 Resp
 #undef C
 }
 
-UHttpRequest* UBlueprintHttpLibrary::CreateInitializedRequest(const FString& Url, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers)
+UHttpRequest* UBlueprintHttpLibrary::CreateInitializedRequest(const FString& Url, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers, const FName Profile)
 {
 	UHttpRequest* const Request = NewObject<UHttpRequest>();
 
-	Request->SetURL(AddParametersToUrl(Url, UrlParameters));
 	Request->SetVerb(Verb);
 	Request->SetContentAsString(Content);
-	Request->SetMimeType(MimeType);
-	
-	for (const auto& Pair : Headers)
-	{
-		Request->SetHeader(Pair.Key, Pair.Value);
-	}
+
+	InitializeRequest(Request, Profile, Url, UrlParameters, MimeType, Headers);
 
 	return Request;
 }
 
-UHttpRequest* UBlueprintHttpLibrary::CreateInitializedBinaryRequest(const FString& Url, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8>& Content, const TMap<FString, FString>& Headers)
+UHttpRequest* UBlueprintHttpLibrary::CreateInitializedBinaryRequest(const FString& Url, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8>& Content, const TMap<FString, FString>& Headers, const FName Profile)
 {
 	UHttpRequest* const Request = NewObject<UHttpRequest>();
 
-	Request->SetURL(AddParametersToUrl(Url, UrlParameters));
 	Request->SetVerb(Verb);
 	Request->SetContent(Content);
+
+	InitializeRequest(Request, Profile, Url, UrlParameters, MimeType, Headers);
+
+	return Request;
+}
+
+UHttpRequest* UBlueprintHttpLibrary::CreateRequestFromProfile(const FName Profile, const FString& Path, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb)
+{
+	return FHttpClientProfiles::CreateRequest(Profile, Path, UrlParameters, Verb);
+}
+
+void UBlueprintHttpLibrary::InitializeRequest(UHttpRequest* const Request, const FName Profile, const FString& Url, const TMap<FString, FString>& UrlParameters,
+	const EHttpMimeType MimeType, const TMap<FString, FString>& Headers, const FHttpRequestTimeouts& Timeouts)
+{
+	// Set first, so that Content-Type headers replace it.
 	Request->SetMimeType(MimeType);
-	
-	for (const auto& Pair : Headers)
+
+	if (Profile.IsNone())
+	{
+		Request->SetURL(AddParametersToUrl(Url, UrlParameters));
+	}
+	else
 	{
-		Request->SetHeader(Pair.Key, Pair.Value);
+		FHttpClientProfiles::Apply(Profile, Request, Url, UrlParameters);
 	}
 
-	return Request;
+	Request->SetHeaders(Headers);
+
+	if (Timeouts.HasAny())
+	{
+		Request->SetTimeouts(Timeouts);
+	}
 }
 
 FString UBlueprintHttpLibrary::AddParametersToUrl(FString InUrl, const TMap<FString, FString>& Parameters)
@@ -210,12 +409,22 @@ FString UBlueprintHttpLibrary::AddParametersToUrl(FString InUrl, const TMap<FStr
 		return InUrl;
 	}
 
+	// Reserved for the parameters without escapes, the parameters are encoded in place.
+	int32 ParametersLength = 0;
+	for (const auto& Pair : Parameters)
+	{
+		ParametersLength += Pair.Key.Len() + Pair.Value.Len() + 2;
+	}
+
+	InUrl.Reserve(InUrl.Len() + ParametersLength);
 	InUrl += TEXT("?");
 
 	int32 i = 0;
 	for (auto It = Parameters.begin(); It != Parameters.end(); ++i, ++It)
 	{
-		InUrl += FPlatformHttp::UrlEncode(It->Key) + TEXT("=") + FPlatformHttp::UrlEncode(It->Value);
+		BlueprintHttp::AppendUrlEncoded(InUrl, It->Key);
+		InUrl += TEXT("=");
+		BlueprintHttp::AppendUrlEncoded(InUrl, It->Value);
 		if (i != ParametersCount - 1)
 		{
 			InUrl += TEXT("&");
@@ -225,6 +434,37 @@ FString UBlueprintHttpLibrary::AddParametersToUrl(FString InUrl, const TMap<FStr
 	return InUrl; 
 }
 
+FString UBlueprintHttpLibrary::BuildUrl(const FString& BaseUrl, const TArray<FString>& PathSegments, const TMap<FString, FString>& Parameters)
+{
+	FHttpUrlBuilder Builder(BaseUrl);
+
+	for (const FString& Segment : PathSegments)
+	{
+		Builder.AddPathSegment(Segment);
+	}
+
+	Builder.AddQueryParameters(Parameters);
+
+	return Builder.Build();
+}
+
+bool UBlueprintHttpLibrary::ParseUrl(const FString& Url, FHttpUrl& OutUrl)
+{
+	return FHttpUrl::Parse(Url, OutUrl);
+}
+
+bool UBlueprintHttpLibrary::FindUrlQueryParameter(const FHttpUrl& Url, const FString& Name, FString& OutValue)
+{
+	const FString* const Value = Url.FindQueryParameter(Name);
+	OutValue = Value ? *Value : FString();
+	return Value != nullptr;
+}
+
+FString UBlueprintHttpLibrary::Conv_HttpUrlToString(const FHttpUrl& Url)
+{
+	return Url.ToString();
+}
+
 FString UBlueprintHttpLibrary::CreateMimeType(const EHttpMimeType Type)
 {
 	static const TMap<EHttpMimeType, FString> Enum =
@@ -265,17 +505,17 @@ FString UBlueprintHttpLibrary::CreateMimeType(const EHttpMimeType Type)
 
 FString UBlueprintHttpLibrary::UrlEncodeString(const FString& StringToEscape)
 {
-	return FPlatformHttp::UrlEncode(StringToEscape);
+	return BlueprintHttp::UrlEncode(StringToEscape);
 }
 
 FString UBlueprintHttpLibrary::UrlDecodeString(const FString& StringToDecode)
 {
-	return FPlatformHttp::UrlDecode(StringToDecode);
+	return BlueprintHttp::UrlDecode(StringToDecode);
 }
 
 bool UBlueprintHttpLibrary::IsUrlEncoded(const TArray<uint8> Payload)
 {
-	return FPlatformHttp::IsURLEncoded(Payload);
+	return BlueprintHttp::IsUrlEncoded(Payload);
 }
 
 FString UBlueprintHttpLibrary::GetUrlDomain(const FString& Url)
@@ -315,7 +555,7 @@ void UBlueprintHttpLibrary::EncodeToBase64(const FString& Data, FString& OutData
 
 void UBlueprintHttpLibrary::EncodeToBase64Binary(const TArray<uint8>& Data, FString& OutData)
 {
-	OutData = FBase64::Encode(Data);
+	FHttpBase64::Encode(Data, OutData);
 }
 
 bool UBlueprintHttpLibrary::DecodeToBase64(const FString& Data, FString& OutData)
@@ -325,6 +565,6 @@ bool UBlueprintHttpLibrary::DecodeToBase64(const FString& Data, FString& OutData
 
 bool UBlueprintHttpLibrary::DecodeToBase64Binary(const FString& Data, TArray<uint8>& OutData)
 {
-	return FBase64::Decode(Data, OutData);
+	return FHttpBase64::Decode(Data, OutData);
 }
 
@@ -3,12 +3,29 @@
 #include "BlueprintHttpNodes.h"
 #include "BlueprintHttpLibrary.h"
 #include "HttpResponse.h"
+#include "HttpResponseBody.h"
 #include "Http.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 
+namespace
+{
+    bool SaveResponseToFile(UHttpResponse* const Response, const FString& Filename)
+    {
+        // Spilled responses are already on the disk.
+        if (Response->GetBody() && Response->GetBody()->MoveSpilledFileTo(Filename))
+        {
+            return true;
+        }
 
-UHttpDownloadFileProxy* UHttpDownloadFileProxy::HttpDownloadFile(const FString& FileUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers, const FString& SaveFileLocation)
+        TArray<uint8> Content;
+        Response->GetContent(Content);
+        return FFileHelper::SaveArrayToFile(Content, *Filename);
+    }
+}
+
+UHttpDownloadFileProxy* UHttpDownloadFileProxy::HttpDownloadFile(const FString& FileUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers, const FString& SaveFileLocation,
+    const FHttpRequestTimeouts& Timeouts, const FHttpIntegrityCheck& IntegrityCheck, UHttpDeadlineBudget* DeadlineBudget, const FName Profile)
 {
     UHttpDownloadFileProxy* const Proxy = NewObject<UHttpDownloadFileProxy>();
 
@@ -18,10 +35,17 @@ UHttpDownloadFileProxy* UHttpDownloadFileProxy::HttpDownloadFile(const FString&
     Proxy->Request = UHttpRequest::CreateRequest();
 
     Proxy->Request->SetVerb           (Verb);
-    Proxy->Request->SetHeaders        (Headers);
-    Proxy->Request->SetURL            (UBlueprintHttpLibrary::AddParametersToUrl(FileUrl, UrlParameters));
-    Proxy->Request->SetMimeType       (MimeType);
     Proxy->Request->SetContentAsString(Content);
+    Proxy->Request->SetIntegrityCheck (IntegrityCheck);
+    Proxy->Request->SetDeadlineBudget (DeadlineBudget);
+
+    UBlueprintHttpLibrary::InitializeRequest(Proxy->Request, Profile, FileUrl, UrlParameters, MimeType, Headers, Timeouts);
+
+    // Downloaded and the percentage come from the progress, the node keeps reporting it when the default policy is Off.
+    if (Proxy->Request->GetProgressPolicy().Reporting == EHttpProgressReporting::Off)
+    {
+        Proxy->Request->SetProgressPolicy(FHttpProgressPolicy());
+    }
 
     Proxy->SaveLocation = SaveFileLocation;
 
@@ -49,9 +73,7 @@ void UHttpDownloadFileProxy::OnRequestCompleted(UHttpRequest* const Req, UHttpRe
     }
     else if (Response && Response->GetResponseCode() < 400)
     {    
-        TArray<uint8> Content;
-        Response->GetContent(Content);
-        if (!FFileHelper::SaveArrayToFile(Content, *SaveLocation))
+        if (!SaveResponseToFile(Response, SaveLocation))
         {
             UE_LOG(LogHttp, Error, TEXT("Download file error: Failed to save data to \"%s\"."), *FPaths::ConvertRelativePathToFull(SaveLocation));
             OnFileDownloadError.Broadcast(ContentLength, Downloaded, GetPercents());
@@ -112,7 +134,17 @@ UProcessHttpRequestProxy* UProcessHttpRequestProxy::InlineProcessRequest(UHttpRe
 
 void UProcessHttpRequestProxy::OnTickInternal(UHttpRequest* const Request, const int32 InBytesSent, const int32 InBytesReceived)
 {
-    OnResponse.Broadcast(100, FHeaders(), TEXT(""), TEXT(""), Request->GetElapsedTime(),
+    BytesSent     = InBytesSent;
+    BytesReceived = InBytesReceived;
+
+    if (!OnTick.IsBound())
+    {
+        return;
+    }
+
+    static const FHeaders EmptyHeaders;
+
+    OnTick.Broadcast(100, EmptyHeaders, FString(), FString(), Request->GetElapsedTime(),
         Request->GetStatus(), BytesSent, BytesReceived);
 }
 
@@ -172,17 +204,18 @@ void USendHttpRequestProxyBase::SendRequest()
     }
 }
 
-USendHttpRequestProxy* USendHttpRequestProxy::SendHttpRequest(const FString& ServerUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers)
+USendHttpRequestProxy* USendHttpRequestProxy::SendHttpRequest(const FString& ServerUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers,
+    const FHttpRequestTimeouts& Timeouts, UHttpDeadlineBudget* DeadlineBudget, const FName Profile)
 {
     USendHttpRequestProxy* const Proxy = NewObject<USendHttpRequestProxy>();
 
     UHttpRequest* const Request = Proxy->GetRequest();
 
-    Request->SetURL(UBlueprintHttpLibrary::AddParametersToUrl(ServerUrl, UrlParameters));
-    Request->SetMimeType(MimeType);
     Request->SetVerb(Verb);
     Request->SetContentAsString(Content);
-    Request->SetHeaders(Headers);
+    Request->SetDeadlineBudget(DeadlineBudget);
+
+    UBlueprintHttpLibrary::InitializeRequest(Request, Profile, ServerUrl, UrlParameters, MimeType, Headers, Timeouts);
 
     Proxy->SendRequest();
 
@@ -191,7 +224,14 @@ USendHttpRequestProxy* USendHttpRequestProxy::SendHttpRequest(const FString& Ser
 
 void USendHttpRequestProxy::OnTickInternal()
 {
-    OnTick.Broadcast(100, FHeaders(), FString(), FString(), 
+    if (!OnTick.IsBound())
+    {
+        return;
+    }
+
+    static const FHeaders EmptyHeaders;
+
+    OnTick.Broadcast(100, EmptyHeaders, FString(), FString(), 
         GetRequest()->GetElapsedTime(), GetRequest()->GetStatus(), 
         GetBytesSent(), GetBytesReceived());
 }
@@ -212,17 +252,18 @@ void USendHttpRequestProxy::OnErrorInternal(UHttpResponse* const Response)
     SetReadyToDestroy();
 }
 
-USendBinaryHttpRequestProxy* USendBinaryHttpRequestProxy::SendBinaryHttpRequest(const FString& ServerUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8>& Content, const TMap<FString, FString>& Headers)
+USendBinaryHttpRequestProxy* USendBinaryHttpRequestProxy::SendBinaryHttpRequest(const FString& ServerUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8>& Content, const TMap<FString, FString>& Headers,
+    const FHttpRequestTimeouts& Timeouts, UHttpDeadlineBudget* DeadlineBudget, const FName Profile)
 {
     USendBinaryHttpRequestProxy* const Proxy = NewObject<USendBinaryHttpRequestProxy>();
 
     UHttpRequest* const Request = Proxy->GetRequest();
 
-    Request->SetURL(UBlueprintHttpLibrary::AddParametersToUrl(ServerUrl, UrlParameters));
     Request->SetVerb(Verb);
     Request->SetContent(Content);
-    Request->SetMimeType(MimeType);
-    Request->SetHeaders(Headers);
+    Request->SetDeadlineBudget(DeadlineBudget);
+
+    UBlueprintHttpLibrary::InitializeRequest(Request, Profile, ServerUrl, UrlParameters, MimeType, Headers, Timeouts);
 
     Proxy->SendRequest();
 
@@ -232,7 +273,15 @@ USendBinaryHttpRequestProxy* USendBinaryHttpRequestProxy::SendBinaryHttpRequest(
 
 void USendBinaryHttpRequestProxy::OnTickInternal()
 {
-    OnTick.Broadcast(100, FHeaders(), FString(), TArray<uint8>(),
+    if (!OnTick.IsBound())
+    {
+        return;
+    }
+
+    static const FHeaders      EmptyHeaders;
+    static const TArray<uint8> EmptyContent;
+
+    OnTick.Broadcast(100, EmptyHeaders, FString(), EmptyContent,
         GetRequest()->GetElapsedTime(), GetRequest()->GetStatus(),
         GetBytesSent(), GetBytesReceived());
 }
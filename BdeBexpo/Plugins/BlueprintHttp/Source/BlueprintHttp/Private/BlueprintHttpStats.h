@@ -0,0 +1,9 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/* Runtime counters of the plugin, shown with "stat BlueprintHttp". */
+DECLARE_STATS_GROUP(TEXT("BlueprintHttp"), STATGROUP_BlueprintHttp, STATCAT_Advanced);
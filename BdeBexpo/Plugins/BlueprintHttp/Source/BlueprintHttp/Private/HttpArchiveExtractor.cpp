@@ -0,0 +1,920 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpArchiveExtractor.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "BlueprintHttpLibrary.h"
+#include "Http.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace
+{
+	constexpr int32 InflateBufferSize = 64 * 1024;
+	constexpr int32 TarBlockSize	  = 512;
+
+	constexpr uint32 ZipLocalHeaderSignature	  = 0x04034b50;
+	constexpr uint32 ZipDescriptorSignature		  = 0x08074b50;
+	constexpr uint32 ZipCentralDirectorySignature = 0x02014b50;
+	constexpr uint32 ZipEndSignature			  = 0x06054b50;
+	constexpr uint32 Zip64EndSignature			  = 0x06064b50;
+
+	// Zip flags.
+	constexpr uint16 ZipEncrypted	  = 0x01;
+	constexpr uint16 ZipHasDescriptor = 0x08;
+
+	uint16 ReadUInt16(const uint8* const Data)
+	{
+		return uint16(Data[0]) | (uint16(Data[1]) << 8);
+	}
+
+	uint32 ReadUInt32(const uint8* const Data)
+	{
+		return uint32(ReadUInt16(Data)) | (uint32(ReadUInt16(Data + 2)) << 16);
+	}
+
+	uint64 ReadUInt64(const uint8* const Data)
+	{
+		return uint64(ReadUInt32(Data)) | (uint64(ReadUInt32(Data + 4)) << 32);
+	}
+
+	/* Reads a tar number, in octal or in base-256 for large values. */
+	int64 ReadTarNumber(const uint8* const Field, const int32 Length)
+	{
+		int64 Value = 0;
+
+		if (Field[0] & 0x80)
+		{
+			Value = Field[0] & 0x3F;
+
+			for (int32 Index = 1; Index < Length; ++Index)
+			{
+				Value = (Value << 8) | Field[Index];
+			}
+
+			return Value;
+		}
+
+		for (int32 Index = 0; Index < Length && Field[Index] != 0; ++Index)
+		{
+			if (Field[Index] >= '0' && Field[Index] <= '7')
+			{
+				Value = (Value << 3) | (Field[Index] - '0');
+			}
+		}
+
+		return Value;
+	}
+
+	FString ReadTarString(const uint8* const Field, const int32 Length)
+	{
+		int32 StringLength = 0;
+
+		while (StringLength < Length && Field[StringLength] != 0)
+		{
+			++StringLength;
+		}
+
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Field), StringLength);
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	bool IsTarChecksumValid(const uint8* const Header)
+	{
+		int64 Sum = 0;
+
+		for (int32 Index = 0; Index < TarBlockSize; ++Index)
+		{
+			// The checksum field counts as spaces.
+			Sum += (Index >= 148 && Index < 156) ? ' ' : Header[Index];
+		}
+
+		return Sum == ReadTarNumber(Header + 148, 8);
+	}
+
+	/* Entries must stay inside the target directory. */
+	bool IsSafeEntryName(const FString& Name)
+	{
+		return !Name.IsEmpty() && FPaths::IsRelative(Name) && !Name.StartsWith(TEXT("/")) && !Name.Contains(TEXT(":"))
+			&& !Name.Equals(TEXT("..")) && !Name.StartsWith(TEXT("../")) && !Name.Contains(TEXT("/../")) && !Name.EndsWith(TEXT("/.."));
+	}
+}
+
+FHttpArchiveExtractor::FHttpArchiveExtractor(const FString& InTargetDirectory, const TArray<FString>& InIncludeFilters)
+	: TargetDirectory(InTargetDirectory)
+	, IncludeFilters(InIncludeFilters)
+	, Format(EFormat::Unknown)
+	, State(EState::ZipHeader)
+	, EntryStream(nullptr)
+	, GzipStream(nullptr)
+	, EntrySize(0)
+	, EntryWritten(0)
+	, EntryRemaining(0)
+	, EntryCrc(0)
+	, ZipExpectedCrc(0)
+	, ZipMethod(0)
+	, ZipFlags(0)
+	, bZip64(false)
+	, bTarMetadata(false)
+	, TarTypeFlag(0)
+	, TarPadding(0)
+	, EntriesExtracted(0)
+	, BytesWritten(0)
+	, bReceivedData(false)
+{
+	SetIsSaving(true);
+
+	InflateBuffer.SetNumUninitialized(InflateBufferSize);
+}
+
+FHttpArchiveExtractor::~FHttpArchiveExtractor()
+{
+	// A partial entry is never left behind.
+	if (EntryWriter)
+	{
+		EntryWriter.Reset();
+		IFileManager::Get().Delete(*(TargetDirectory / EntryName), false, false, true);
+	}
+
+	for (z_stream_s* const Stream : { EntryStream, GzipStream })
+	{
+		if (Stream)
+		{
+			inflateEnd(Stream);
+			delete Stream;
+		}
+	}
+}
+
+void FHttpArchiveExtractor::Serialize(void* Data, int64 Length)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (Length <= 0 || State == EState::End || State == EState::Error)
+	{
+		return;
+	}
+
+	bReceivedData = true;
+
+	if (Format == EFormat::Unknown)
+	{
+		Pending.Append(static_cast<const uint8*>(Data), Length);
+
+		if (Pending.Num() < 4)
+		{
+			return;
+		}
+
+		const uint8* const Magic = Pending.GetData();
+
+		if (Magic[0] == 0x1f && Magic[1] == 0x8b)
+		{
+			GzipStream = new z_stream_s();
+
+			// Gzip header only.
+			if (inflateInit2(GzipStream, 15 + 16) != Z_OK)
+			{
+				Fail(TEXT("Failed to initialize zlib."));
+				return;
+			}
+
+			Format = EFormat::TarGz;
+			State  = EState::TarHeader;
+		}
+		else if (ReadUInt32(Magic) == ZipLocalHeaderSignature)
+		{
+			Format = EFormat::Zip;
+			State  = EState::ZipHeader;
+		}
+		else
+		{
+			Format = EFormat::Tar;
+			State  = EState::TarHeader;
+		}
+
+		const TArray<uint8> Received = MoveTemp(Pending);
+		Pending.Reset();
+
+		Serialize(const_cast<uint8*>(Received.GetData()), Received.Num());
+		return;
+	}
+
+	if (Format != EFormat::TarGz)
+	{
+		Process(static_cast<const uint8*>(Data), Length);
+		return;
+	}
+
+	GzipStream->next_in	 = static_cast<Bytef*>(Data);
+	GzipStream->avail_in = static_cast<uInt>(Length);
+
+	int32 Result = Z_OK;
+
+	do
+	{
+		GzipStream->next_out  = InflateBuffer.GetData();
+		GzipStream->avail_out = InflateBuffer.Num();
+
+		Result = inflate(GzipStream, Z_NO_FLUSH);
+
+		Process(InflateBuffer.GetData(), InflateBuffer.Num() - GzipStream->avail_out);
+	}
+	while (Result == Z_OK && (GzipStream->avail_in > 0 || GzipStream->avail_out == 0) && State != EState::End && State != EState::Error);
+
+	if (Result != Z_OK && Result != Z_STREAM_END && Result != Z_BUF_ERROR)
+	{
+		Fail(TEXT("The gzip stream is corrupt."));
+	}
+}
+
+void FHttpArchiveExtractor::Process(const uint8* Data, const int64 Length)
+{
+	// Parses the incoming bytes in place, only what can't be parsed yet is kept.
+	const bool bFromPending = Pending.Num() > 0;
+
+	if (bFromPending)
+	{
+		Pending.Append(Data, Length);
+	}
+
+	const uint8* Cursor = bFromPending ? Pending.GetData() : Data;
+	int64 Available		= bFromPending ? Pending.Num()	   : Length;
+
+	while (Available > 0 && State != EState::End && State != EState::Error)
+	{
+		const EState PreviousState = State;
+
+		int64 Consumed = 0;
+
+		switch (State)
+		{
+		case EState::ZipHeader:		Consumed = ProcessZipHeader	   (Cursor, Available); break;
+		case EState::ZipData:		Consumed = ProcessZipData	   (Cursor, Available); break;
+		case EState::ZipDescriptor:	Consumed = ProcessZipDescriptor(Cursor, Available); break;
+		case EState::TarHeader:		Consumed = ProcessTarHeader	   (Cursor, Available); break;
+		case EState::TarData:		Consumed = ProcessTarData	   (Cursor, Available); break;
+
+		case EState::TarPadding:
+			Consumed	= FMath::Min(Available, TarPadding);
+			TarPadding -= Consumed;
+			State		= TarPadding == 0 ? EState::TarHeader : EState::TarPadding;
+			break;
+
+		default:
+			break;
+		}
+
+		if (Consumed == 0 && State == PreviousState)
+		{
+			break;
+		}
+
+		Cursor	  += Consumed;
+		Available -= Consumed;
+	}
+
+	// What follows the end of the archive is ignored.
+	if (State == EState::End || State == EState::Error)
+	{
+		Available = 0;
+	}
+
+	if (bFromPending)
+	{
+		Pending.RemoveAt(0, Pending.Num() - Available, EAllowShrinking::No);
+	}
+	else
+	{
+		Pending.Append(Cursor, Available);
+	}
+}
+
+int64 FHttpArchiveExtractor::ProcessZipHeader(const uint8* Data, const int64 Length)
+{
+	if (Length < 4)
+	{
+		return 0;
+	}
+
+	const uint32 Signature = ReadUInt32(Data);
+
+	// The central directory repeats the entries, the archive is complete.
+	if (Signature == ZipCentralDirectorySignature || Signature == ZipEndSignature || Signature == Zip64EndSignature)
+	{
+		State = EState::End;
+		return Length;
+	}
+
+	if (Signature != ZipLocalHeaderSignature)
+	{
+		Fail(TEXT("The zip archive is corrupt."));
+		return 0;
+	}
+
+	if (Length < 30)
+	{
+		return 0;
+	}
+
+	const int64 NameLength	 = ReadUInt16(Data + 26);
+	const int64 ExtraLength	 = ReadUInt16(Data + 28);
+	const int64 HeaderLength = 30 + NameLength + ExtraLength;
+
+	if (Length < HeaderLength)
+	{
+		return 0;
+	}
+
+	ZipFlags	   = ReadUInt16(Data + 6);
+	ZipMethod	   = ReadUInt16(Data + 8);
+	ZipExpectedCrc = ReadUInt32(Data + 14);
+	bZip64		   = false;
+
+	int64 CompressedSize   = ReadUInt32(Data + 18);
+	int64 UncompressedSize = ReadUInt32(Data + 22);
+
+	const uint8* const ExtraEnd = Data + HeaderLength;
+
+	for (const uint8* Extra = Data + 30 + NameLength; Extra + 4 <= ExtraEnd; Extra += 4 + ReadUInt16(Extra + 2))
+	{
+		// Zip64 sizes, present when the 32-bit sizes are saturated.
+		if (ReadUInt16(Extra) == 0x0001)
+		{
+			const uint8* Field = Extra + 4;
+			const uint8* const FieldEnd = FMath::Min(Extra + 4 + ReadUInt16(Extra + 2), ExtraEnd);
+
+			bZip64 = true;
+
+			if (UncompressedSize == MAX_uint32 && Field + 8 <= FieldEnd)
+			{
+				UncompressedSize = ReadUInt64(Field);
+				Field += 8;
+			}
+
+			if (CompressedSize == MAX_uint32 && Field + 8 <= FieldEnd)
+			{
+				CompressedSize = ReadUInt64(Field);
+			}
+		}
+	}
+
+	const FUTF8ToTCHAR ConvertedName(reinterpret_cast<const ANSICHAR*>(Data + 30), NameLength);
+	const FString Name(ConvertedName.Length(), ConvertedName.Get());
+
+	const bool bHasDescriptor = (ZipFlags & ZipHasDescriptor) != 0;
+
+	if (ZipFlags & ZipEncrypted)
+	{
+		Fail(FString::Printf(TEXT("\"%s\" is encrypted."), *Name));
+		return 0;
+	}
+
+	if (ZipMethod != 0 && ZipMethod != Z_DEFLATED)
+	{
+		Fail(FString::Printf(TEXT("\"%s\" uses the unsupported compression method %d."), *Name, ZipMethod));
+		return 0;
+	}
+
+	if (ZipMethod == 0 && bHasDescriptor)
+	{
+		Fail(FString::Printf(TEXT("\"%s\" is stored without its size and can't be streamed."), *Name));
+		return 0;
+	}
+
+	BeginEntry(Name, bHasDescriptor ? -1 : UncompressedSize, Name.EndsWith(TEXT("/")));
+
+	if (State == EState::Error)
+	{
+		return 0;
+	}
+
+	EntryRemaining = CompressedSize;
+
+	if (ZipMethod == Z_DEFLATED)
+	{
+		if (!EntryStream)
+		{
+			EntryStream = new z_stream_s();
+
+			// Raw deflate, zip entries have no zlib header.
+			if (inflateInit2(EntryStream, -15) != Z_OK)
+			{
+				Fail(TEXT("Failed to initialize zlib."));
+				return 0;
+			}
+		}
+		else
+		{
+			inflateReset(EntryStream);
+		}
+
+		State = EState::ZipData;
+	}
+	else if (EntryRemaining > 0)
+	{
+		State = EState::ZipData;
+	}
+	else
+	{
+		EndEntry(ZipExpectedCrc, true);
+	}
+
+	return HeaderLength;
+}
+
+int64 FHttpArchiveExtractor::ProcessZipData(const uint8* Data, const int64 Length)
+{
+	if (ZipMethod == 0)
+	{
+		const int64 Consumed = FMath::Min(Length, EntryRemaining);
+
+		WriteEntry(Data, Consumed);
+
+		EntryRemaining -= Consumed;
+
+		if (EntryRemaining == 0)
+		{
+			State = EState::ZipHeader;
+			EndEntry(ZipExpectedCrc, true);
+		}
+
+		return Consumed;
+	}
+
+	const uInt Input = static_cast<uInt>(FMath::Min<int64>(Length, MAX_uint32));
+
+	EntryStream->next_in  = const_cast<Bytef*>(Data);
+	EntryStream->avail_in = Input;
+
+	int32 Result = Z_OK;
+
+	do
+	{
+		EntryStream->next_out  = InflateBuffer.GetData();
+		EntryStream->avail_out = InflateBuffer.Num();
+
+		Result = inflate(EntryStream, Z_NO_FLUSH);
+
+		WriteEntry(InflateBuffer.GetData(), InflateBuffer.Num() - EntryStream->avail_out);
+	}
+	while (Result == Z_OK && (EntryStream->avail_in > 0 || EntryStream->avail_out == 0));
+
+	if (Result == Z_STREAM_END)
+	{
+		if (ZipFlags & ZipHasDescriptor)
+		{
+			State = EState::ZipDescriptor;
+		}
+		else
+		{
+			State = EState::ZipHeader;
+			EndEntry(ZipExpectedCrc, true);
+		}
+	}
+	else if (Result != Z_OK && Result != Z_BUF_ERROR)
+	{
+		Fail(FString::Printf(TEXT("\"%s\" is corrupt."), *EntryName));
+		return 0;
+	}
+
+	return Input - EntryStream->avail_in;
+}
+
+int64 FHttpArchiveExtractor::ProcessZipDescriptor(const uint8* Data, const int64 Length)
+{
+	if (Length < 4)
+	{
+		return 0;
+	}
+
+	// The signature of the data descriptor is optional.
+	const int64 CrcOffset		 = ReadUInt32(Data) == ZipDescriptorSignature ? 4 : 0;
+	const int64 DescriptorLength = CrcOffset + 4 + (bZip64 ? 16 : 8);
+
+	if (Length < DescriptorLength)
+	{
+		return 0;
+	}
+
+	State = EState::ZipHeader;
+
+	EndEntry(ReadUInt32(Data + CrcOffset), true);
+
+	return DescriptorLength;
+}
+
+int64 FHttpArchiveExtractor::ProcessTarHeader(const uint8* Data, const int64 Length)
+{
+	if (Length < TarBlockSize)
+	{
+		return 0;
+	}
+
+	bool bEmptyBlock = true;
+
+	for (int32 Index = 0; Index < TarBlockSize && bEmptyBlock; ++Index)
+	{
+		bEmptyBlock = Data[Index] == 0;
+	}
+
+	// Archives end with empty blocks.
+	if (bEmptyBlock)
+	{
+		State = EState::End;
+		return Length;
+	}
+
+	if (!IsTarChecksumValid(Data))
+	{
+		Fail(Format == EFormat::Tar ? TEXT("The response isn't a zip, tar or tar.gz archive.") : TEXT("The tar archive is corrupt."));
+		return 0;
+	}
+
+	FString Name = ReadTarString(Data, 100);
+
+	// The ustar prefix holds the directories of long names.
+	if (FMemory::Memcmp(Data + 257, "ustar", 5) == 0 && Data[345] != 0)
+	{
+		Name = ReadTarString(Data + 345, 155) / Name;
+	}
+
+	if (!TarNextName.IsEmpty())
+	{
+		Name = MoveTemp(TarNextName);
+		TarNextName.Reset();
+	}
+
+	TarTypeFlag	   = Data[156];
+	EntryRemaining = ReadTarNumber(Data + 124, 12);
+	TarPadding	   = (TarBlockSize - EntryRemaining % TarBlockSize) % TarBlockSize;
+
+	// GNU long names and pax headers describe the next entry.
+	bTarMetadata = TarTypeFlag == 'L' || TarTypeFlag == 'K' || TarTypeFlag == 'x' || TarTypeFlag == 'g';
+
+	if (bTarMetadata)
+	{
+		TarMetadata.Reset();
+	}
+	else if (TarTypeFlag == '0' || TarTypeFlag == 0 || TarTypeFlag == '7' || TarTypeFlag == '5')
+	{
+		BeginEntry(Name, EntryRemaining, TarTypeFlag == '5');
+
+		if (State == EState::Error)
+		{
+			return 0;
+		}
+	}
+
+	State = EState::TarData;
+
+	if (EntryRemaining == 0)
+	{
+		ProcessTarData(Data, 0);
+	}
+
+	return TarBlockSize;
+}
+
+int64 FHttpArchiveExtractor::ProcessTarData(const uint8* Data, const int64 Length)
+{
+	const int64 Consumed = FMath::Min(Length, EntryRemaining);
+
+	if (bTarMetadata)
+	{
+		TarMetadata.Append(Data, Consumed);
+	}
+	else
+	{
+		WriteEntry(Data, Consumed);
+	}
+
+	EntryRemaining -= Consumed;
+
+	if (EntryRemaining > 0)
+	{
+		return Consumed;
+	}
+
+	// Set first, a failure to write the entry overrides it.
+	State = TarPadding > 0 ? EState::TarPadding : EState::TarHeader;
+
+	if (!bTarMetadata)
+	{
+		EndEntry(0, false);
+	}
+	else if (TarTypeFlag == 'L')
+	{
+		TarNextName = ReadTarString(TarMetadata.GetData(), TarMetadata.Num());
+	}
+	else if (TarTypeFlag == 'x')
+	{
+		// Records are "<length> <key>=<value>\n".
+		for (int32 Offset = 0; Offset < TarMetadata.Num(); )
+		{
+			const int32 RecordLength = FCString::Atoi(*ReadTarString(TarMetadata.GetData() + Offset, FMath::Min(20, TarMetadata.Num() - Offset)));
+
+			if (RecordLength <= 0 || Offset + RecordLength > TarMetadata.Num())
+			{
+				break;
+			}
+
+			FString Record = ReadTarString(TarMetadata.GetData() + Offset, RecordLength);
+			FString Key, Value;
+
+			if (Record.Split(TEXT(" "), nullptr, &Record) && Record.Split(TEXT("="), &Key, &Value) && Key == TEXT("path"))
+			{
+				TarNextName = Value.TrimEnd();
+			}
+
+			Offset += RecordLength;
+		}
+	}
+
+	return Consumed;
+}
+
+bool FHttpArchiveExtractor::ShouldExtract(const FString& Name) const
+{
+	if (IncludeFilters.IsEmpty())
+	{
+		return true;
+	}
+
+	for (const FString& Filter : IncludeFilters)
+	{
+		if (Name.MatchesWildcard(Filter))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FHttpArchiveExtractor::BeginEntry(const FString& Name, const int64 Size, const bool bDirectory)
+{
+	EntryName	 = Name.Replace(TEXT("\\"), TEXT("/"));
+	EntrySize	 = Size;
+	EntryWritten = 0;
+	EntryCrc	 = 0;
+
+	EntryName.RemoveFromStart(TEXT("./"));
+	EntryName.RemoveFromEnd(TEXT("/"));
+
+	if (!IsSafeEntryName(EntryName))
+	{
+		UE_CLOG(!EntryName.IsEmpty() && EntryName != TEXT("."), LogHttp, Warning, TEXT("Extract archive: \"%s\" is outside of the target directory, it's skipped."), *EntryName);
+		EntryName.Reset();
+		return;
+	}
+
+	const FString Path = TargetDirectory / EntryName;
+
+	if (bDirectory)
+	{
+		if (ShouldExtract(EntryName + TEXT("/")))
+		{
+			IFileManager::Get().MakeDirectory(*Path, true);
+		}
+		return;
+	}
+
+	if (!ShouldExtract(EntryName))
+	{
+		return;
+	}
+
+	EntryWriter.Reset(IFileManager::Get().CreateFileWriter(*Path));
+
+	if (!EntryWriter)
+	{
+		Fail(FString::Printf(TEXT("Failed to create \"%s\"."), *FPaths::ConvertRelativePathToFull(Path)));
+		return;
+	}
+
+	FEntryProgress& EntryProgress = Progress.AddDefaulted_GetRef();
+	EntryProgress.Name = EntryName;
+	EntryProgress.Size = Size;
+}
+
+void FHttpArchiveExtractor::WriteEntry(const uint8* Data, const int64 Length)
+{
+	if (!EntryWriter || Length <= 0)
+	{
+		return;
+	}
+
+	EntryWriter->Serialize(const_cast<uint8*>(Data), Length);
+
+	for (int64 Offset = 0; Offset < Length; Offset += MAX_int32)
+	{
+		EntryCrc = FCrc::MemCrc32(Data + Offset, static_cast<int32>(FMath::Min<int64>(Length - Offset, MAX_int32)), EntryCrc);
+	}
+
+	EntryWritten += Length;
+	BytesWritten += Length;
+
+	// Only the latest progress of an entry is reported.
+	if (Progress.IsEmpty() || Progress.Last().Name != EntryName || Progress.Last().bCompleted)
+	{
+		FEntryProgress& EntryProgress = Progress.AddDefaulted_GetRef();
+		EntryProgress.Name = EntryName;
+		EntryProgress.Size = EntrySize;
+	}
+
+	Progress.Last().BytesWritten = EntryWritten;
+}
+
+void FHttpArchiveExtractor::EndEntry(const uint32 ExpectedCrc, const bool bCheckCrc)
+{
+	if (!EntryWriter)
+	{
+		return;
+	}
+
+	const bool bWritten = EntryWriter->Close();
+	EntryWriter.Reset();
+
+	if (!bWritten || (bCheckCrc && EntryCrc != ExpectedCrc))
+	{
+		IFileManager::Get().Delete(*(TargetDirectory / EntryName), false, false, true);
+		Fail(FString::Printf(bWritten ? TEXT("\"%s\" is corrupt.") : TEXT("Failed to write \"%s\"."), *EntryName));
+		return;
+	}
+
+	++EntriesExtracted;
+
+	FEntryProgress& EntryProgress = Progress.AddDefaulted_GetRef();
+	EntryProgress.Name		   = EntryName;
+	EntryProgress.BytesWritten = EntryWritten;
+	EntryProgress.Size		   = EntryWritten;
+	EntryProgress.bCompleted   = true;
+}
+
+void FHttpArchiveExtractor::Fail(const FString& Reason)
+{
+	if (State == EState::Error)
+	{
+		return;
+	}
+
+	State = EState::Error;
+	Error = Reason;
+
+	if (EntryWriter)
+	{
+		EntryWriter.Reset();
+		IFileManager::Get().Delete(*(TargetDirectory / EntryName), false, false, true);
+	}
+
+	SetError();
+}
+
+TArray<FHttpArchiveExtractor::FEntryProgress> FHttpArchiveExtractor::ConsumeProgress()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return MoveTemp(Progress);
+}
+
+bool FHttpArchiveExtractor::IsComplete() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return State == EState::End;
+}
+
+bool FHttpArchiveExtractor::HasReceivedData() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return bReceivedData;
+}
+
+FString FHttpArchiveExtractor::GetError() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return Error;
+}
+
+int32 FHttpArchiveExtractor::GetEntriesExtracted() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return EntriesExtracted;
+}
+
+int64 FHttpArchiveExtractor::GetBytesWritten() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return BytesWritten;
+}
+
+UHttpExtractArchiveProxy* UHttpExtractArchiveProxy::HttpDownloadArchive(const FString& Url, const TMap<FString, FString>& Headers, const FString& TargetDirectory, const TArray<FString>& IncludeFilters,
+	const FHttpRequestTimeouts& Timeouts, const FName Profile)
+{
+	UHttpExtractArchiveProxy* const Proxy = NewObject<UHttpExtractArchiveProxy>();
+
+	Proxy->Extractor = MakeShared<FHttpArchiveExtractor, ESPMode::ThreadSafe>(TargetDirectory, IncludeFilters);
+
+	Proxy->Request = UHttpRequest::CreateRequest();
+	Proxy->Request->SetVerb			 (EHttpVerb::GET);
+	Proxy->Request->SetResponseStream(Proxy->Extractor);
+
+	UBlueprintHttpLibrary::InitializeRequest(Proxy->Request, Profile, Url, {}, EHttpMimeType::txt, Headers, Timeouts);
+
+	// The entries are reported and extraction errors caught from the progress, it's kept when the default policy is Off.
+	if (Proxy->Request->GetProgressPolicy().Reporting == EHttpProgressReporting::Off)
+	{
+		Proxy->Request->SetProgressPolicy(FHttpProgressPolicy());
+	}
+
+	return Proxy;
+}
+
+void UHttpExtractArchiveProxy::Activate()
+{
+	Request->OnRequestComplete.AddDynamic(this, &UHttpExtractArchiveProxy::OnRequestCompleted);
+	Request->OnRequestProgress.AddDynamic(this, &UHttpExtractArchiveProxy::OnRequestProgress);
+
+	if (!Request->ProcessRequest())
+	{
+		OnFailed.Broadcast(0, 0);
+		SetReadyToDestroy();
+	}
+}
+
+void UHttpExtractArchiveProxy::OnRequestProgress(UHttpRequest* const InRequest, const int32 BytesSent, const int32 BytesReceived)
+{
+	FlushProgress();
+
+	// Nothing more can be extracted, the rest isn't downloaded.
+	if (Extractor->IsError() && Request->IsInFlight())
+	{
+		UE_LOG(LogHttp, Error, TEXT("Extract archive error: %s"), *Extractor->GetError());
+		Request->CancelRequest();
+	}
+}
+
+void UHttpExtractArchiveProxy::FlushProgress()
+{
+	for (const FHttpArchiveExtractor::FEntryProgress& EntryProgress : Extractor->ConsumeProgress())
+	{
+		if (EntryProgress.bCompleted)
+		{
+			OnEntryExtracted.Broadcast(EntryProgress.Name, EntryProgress.BytesWritten, EntryProgress.Size);
+		}
+		else
+		{
+			OnEntryProgress.Broadcast(EntryProgress.Name, EntryProgress.BytesWritten, EntryProgress.Size);
+		}
+	}
+}
+
+void UHttpExtractArchiveProxy::OnRequestCompleted(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	const bool bValidResponse = bConnectedSuccessfully && Response && Response->GetResponseCode() < 400;
+
+	// Responses served by a transport don't go through the stream.
+	if (bValidResponse && !Extractor->HasReceivedData())
+	{
+		TArray<uint8> Content;
+		Response->GetContent(Content);
+		Extractor->Serialize(Content.GetData(), Content.Num());
+	}
+
+	FlushProgress();
+
+	if (!bConnectedSuccessfully)
+	{
+		OnFailed.Broadcast(Extractor->GetEntriesExtracted(), Extractor->GetBytesWritten());
+	}
+	else if (!bValidResponse)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Extract archive error: Server responded with an invalid code: \"%d\"."), Response ? Response->GetResponseCode() : -1);
+		OnFailed.Broadcast(Extractor->GetEntriesExtracted(), Extractor->GetBytesWritten());
+	}
+	else if (!Extractor->IsComplete())
+	{
+		const FString Error = Extractor->GetError();
+		UE_LOG(LogHttp, Error, TEXT("Extract archive error: %s"), Error.IsEmpty() ? TEXT("The archive is truncated.") : *Error);
+		OnFailed.Broadcast(Extractor->GetEntriesExtracted(), Extractor->GetBytesWritten());
+	}
+	else
+	{
+		OnExtracted.Broadcast(Extractor->GetEntriesExtracted(), Extractor->GetBytesWritten());
+	}
+
+	Request->SetResponseStream(nullptr);
+
+	SetReadyToDestroy();
+}
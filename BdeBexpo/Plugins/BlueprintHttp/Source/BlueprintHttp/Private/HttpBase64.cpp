@@ -0,0 +1,676 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpBase64.h"
+#include "HttpVectorIntrinsics.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GHttpBase64Vectorized = 1;
+static FAutoConsoleVariableRef CVarHttpBase64Vectorized(
+	TEXT("http.Base64.Vectorized"),
+	GHttpBase64Vectorized,
+	TEXT("If BlueprintHttp encodes and decodes Base64 with the vector kernels of the platform when it has them."));
+
+namespace
+{
+	constexpr ANSICHAR Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	constexpr uint8 InvalidValue = 0xFF;
+
+	/* Value of each character, InvalidValue for the characters outside of the alphabet. */
+	struct FDecodeTable
+	{
+		FDecodeTable()
+		{
+			FMemory::Memset(Values, InvalidValue, sizeof(Values));
+
+			for (int32 Index = 0; Index < 64; ++Index)
+			{
+				Values[static_cast<uint8>(Alphabet[Index])] = static_cast<uint8>(Index);
+			}
+		}
+
+		uint8 Values[256];
+	};
+
+	const FDecodeTable DecodeTable;
+
+	bool IsVectorized()
+	{
+		return (BLUEPRINTHTTP_SSSE3 || BLUEPRINTHTTP_NEON) && GHttpBase64Vectorized != 0;
+	}
+
+	template<typename CharType>
+	FORCEINLINE uint8 DecodeChar(const CharType Char)
+	{
+		using FUnsignedChar = std::make_unsigned_t<CharType>;
+		return static_cast<FUnsignedChar>(Char) < 256 ? DecodeTable.Values[static_cast<FUnsignedChar>(Char)] : InvalidValue;
+	}
+
+	template<typename CharType>
+	int64 EncodeScalar(const uint8* Source, int64 Size, CharType* Dest)
+	{
+		CharType* const Start = Dest;
+
+		for (; Size >= 3; Size -= 3, Source += 3, Dest += 4)
+		{
+			const uint32 Group = (uint32(Source[0]) << 16) | (uint32(Source[1]) << 8) | Source[2];
+
+			Dest[0] = Alphabet[(Group >> 18) & 0x3F];
+			Dest[1] = Alphabet[(Group >> 12) & 0x3F];
+			Dest[2] = Alphabet[(Group >>  6) & 0x3F];
+			Dest[3] = Alphabet[ Group		 & 0x3F];
+		}
+
+		if (Size > 0)
+		{
+			const uint32 Group = (uint32(Source[0]) << 16) | (Size > 1 ? uint32(Source[1]) << 8 : 0);
+
+			Dest[0] = Alphabet[(Group >> 18) & 0x3F];
+			Dest[1] = Alphabet[(Group >> 12) & 0x3F];
+			Dest[2] = Size > 1 ? Alphabet[(Group >> 6) & 0x3F] : '=';
+			Dest[3] = '=';
+			Dest += 4;
+		}
+
+		return Dest - Start;
+	}
+
+	/* Decodes unpadded text whose length isn't 1 modulo 4. */
+	template<typename CharType>
+	bool DecodeScalar(const CharType* Source, int64 Length, uint8* Dest, int64& OutSize)
+	{
+		uint8* const Start = Dest;
+
+		for (; Length >= 4; Length -= 4, Source += 4, Dest += 3)
+		{
+			const uint32 A = DecodeChar(Source[0]);
+			const uint32 B = DecodeChar(Source[1]);
+			const uint32 C = DecodeChar(Source[2]);
+			const uint32 D = DecodeChar(Source[3]);
+
+			if ((A | B | C | D) & 0x80)
+			{
+				return false;
+			}
+
+			const uint32 Group = (A << 18) | (B << 12) | (C << 6) | D;
+
+			Dest[0] = static_cast<uint8>(Group >> 16);
+			Dest[1] = static_cast<uint8>(Group >> 8);
+			Dest[2] = static_cast<uint8>(Group);
+		}
+
+		if (Length > 1)
+		{
+			const uint32 A = DecodeChar(Source[0]);
+			const uint32 B = DecodeChar(Source[1]);
+			const uint32 C = Length > 2 ? DecodeChar(Source[2]) : 0;
+
+			if ((A | B | C) & 0x80)
+			{
+				return false;
+			}
+
+			const uint32 Group = (A << 18) | (B << 12) | (C << 6);
+
+			*Dest++ = static_cast<uint8>(Group >> 16);
+
+			if (Length > 2)
+			{
+				*Dest++ = static_cast<uint8>(Group >> 8);
+			}
+		}
+
+		OutSize = Dest - Start;
+		return true;
+	}
+
+#if BLUEPRINTHTTP_SSSE3
+
+	/* Stores 16 characters, widened to the character type. */
+	template<typename CharType>
+	FORCEINLINE void StoreChars(CharType* const Dest, const __m128i Chars)
+	{
+		if constexpr (sizeof(CharType) == 1)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest), Chars);
+		}
+		else
+		{
+			static_assert(sizeof(CharType) == 2, "Unsupported character size.");
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest),	   _mm_unpacklo_epi8(Chars, _mm_setzero_si128()));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + 8), _mm_unpackhi_epi8(Chars, _mm_setzero_si128()));
+		}
+	}
+
+	/* Loads 16 characters narrowed to bytes. Characters above 255 become invalid bytes. */
+	template<typename CharType>
+	FORCEINLINE __m128i LoadChars(const CharType* const Source)
+	{
+		if constexpr (sizeof(CharType) == 1)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+		}
+		else
+		{
+			static_assert(sizeof(CharType) == 2, "Unsupported character size.");
+
+			return _mm_packus_epi16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(Source)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + 8)));
+		}
+	}
+
+	/* Encodes 12 bytes per iteration, reading 16. Advances the pointers past what was encoded. */
+	template<typename CharType>
+	void EncodeVector(const uint8*& Source, int64& Size, CharType*& Dest)
+	{
+		const __m128i Shuffle	= _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const __m128i ShiftLut	= _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+												'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+		for (; Size >= 16; Size -= 12, Source += 12, Dest += 16)
+		{
+			// Spreads each group of three bytes over four lanes, then moves each 6 bits in a lane.
+			const __m128i Input = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Source)), Shuffle);
+
+			const __m128i High	  = _mm_mulhi_epu16(_mm_and_si128(Input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+			const __m128i Low	  = _mm_mullo_epi16(_mm_and_si128(Input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+			const __m128i Indices = _mm_or_si128(High, Low);
+
+			// Finds the range of each index to add the offset of its character.
+			__m128i Range = _mm_subs_epu8(Indices, _mm_set1_epi8(51));
+			Range = _mm_or_si128(Range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), Indices), _mm_set1_epi8(13)));
+
+			StoreChars(Dest, _mm_add_epi8(_mm_shuffle_epi8(ShiftLut, Range), Indices));
+		}
+	}
+
+	/* Decodes 16 characters per iteration, up to the first invalid block. Advances the pointers past what was decoded. */
+	template<typename CharType>
+	void DecodeVector(const CharType*& Source, int64& Length, uint8*& Dest)
+	{
+		const __m128i LutLow  = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i LutHigh = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i LutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i Mask2F  = _mm_set1_epi8(0x2F);
+		const __m128i Pack	  = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+		for (; Length >= 16; Length -= 16, Source += 16, Dest += 12)
+		{
+			const __m128i Input = LoadChars(Source);
+
+			// Each nibble selects the ranges it can belong to, a character is valid if both agree on one.
+			const __m128i HighNibbles = _mm_and_si128(_mm_srli_epi32(Input, 4), Mask2F);
+			const __m128i LowNibbles  = _mm_and_si128(Input, Mask2F);
+
+			const __m128i Ranges = _mm_and_si128(_mm_shuffle_epi8(LutLow, LowNibbles), _mm_shuffle_epi8(LutHigh, HighNibbles));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(Ranges, _mm_setzero_si128())) != 0xFFFF)
+			{
+				break;
+			}
+
+			const __m128i Roll	 = _mm_shuffle_epi8(LutRoll, _mm_add_epi8(_mm_cmpeq_epi8(Input, Mask2F), HighNibbles));
+			const __m128i Values = _mm_add_epi8(Input, Roll);
+
+			// Merges the 6-bit values into 24-bit groups then packs them.
+			const __m128i Pairs	 = _mm_maddubs_epi16(Values, _mm_set1_epi32(0x01400140));
+			const __m128i Groups = _mm_shuffle_epi8(_mm_madd_epi16(Pairs, _mm_set1_epi32(0x00011000)), Pack);
+
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(Dest), Groups);
+
+			const int32 Last = _mm_cvtsi128_si32(_mm_srli_si128(Groups, 8));
+			FMemory::Memcpy(Dest + 8, &Last, 4);
+		}
+	}
+
+#elif BLUEPRINTHTTP_NEON
+
+	/* Encodes 48 bytes per iteration. Advances the pointers past what was encoded. */
+	template<typename CharType>
+	void EncodeVector(const uint8*& Source, int64& Size, CharType*& Dest)
+	{
+		const uint8* const Table = reinterpret_cast<const uint8*>(Alphabet);
+		const uint8x16x4_t Lut = { { vld1q_u8(Table), vld1q_u8(Table + 16), vld1q_u8(Table + 32), vld1q_u8(Table + 48) } };
+		const uint8x16_t Mask = vdupq_n_u8(0x3F);
+
+		for (; Size >= 48; Size -= 48, Source += 48, Dest += 64)
+		{
+			const uint8x16x3_t Input = vld3q_u8(Source);
+
+			uint8x16x4_t Chars;
+			Chars.val[0] = vqtbl4q_u8(Lut, vshrq_n_u8(Input.val[0], 2));
+			Chars.val[1] = vqtbl4q_u8(Lut, vandq_u8(vorrq_u8(vshlq_n_u8(Input.val[0], 4), vshrq_n_u8(Input.val[1], 4)), Mask));
+			Chars.val[2] = vqtbl4q_u8(Lut, vandq_u8(vorrq_u8(vshlq_n_u8(Input.val[1], 2), vshrq_n_u8(Input.val[2], 6)), Mask));
+			Chars.val[3] = vqtbl4q_u8(Lut, vandq_u8(Input.val[2], Mask));
+
+			if constexpr (sizeof(CharType) == 1)
+			{
+				vst4q_u8(reinterpret_cast<uint8*>(Dest), Chars);
+			}
+			else
+			{
+				static_assert(sizeof(CharType) == 2, "Unsupported character size.");
+
+				uint8 Interleaved[64];
+				vst4q_u8(Interleaved, Chars);
+
+				for (int32 Offset = 0; Offset < 64; Offset += 16)
+				{
+					const uint8x16_t Block = vld1q_u8(Interleaved + Offset);
+					vst1q_u16(reinterpret_cast<uint16*>(Dest + Offset),		vmovl_u8(vget_low_u8(Block)));
+					vst1q_u16(reinterpret_cast<uint16*>(Dest + Offset + 8), vmovl_u8(vget_high_u8(Block)));
+				}
+			}
+		}
+	}
+
+	/* Decodes 64 characters per iteration, up to the first invalid block. Advances the pointers past what was decoded. */
+	template<typename CharType>
+	void DecodeVector(const CharType*& Source, int64& Length, uint8*& Dest)
+	{
+		const uint8* const Table = DecodeTable.Values;
+		const uint8x16x4_t LutLow  = { { vld1q_u8(Table),	   vld1q_u8(Table + 16), vld1q_u8(Table + 32), vld1q_u8(Table + 48) } };
+		const uint8x16x4_t LutHigh = { { vld1q_u8(Table + 64), vld1q_u8(Table + 80), vld1q_u8(Table + 96), vld1q_u8(Table + 112) } };
+
+		for (; Length >= 64; Length -= 64, Source += 64, Dest += 48)
+		{
+			uint8x16x4_t Input;
+
+			if constexpr (sizeof(CharType) == 1)
+			{
+				Input = vld4q_u8(reinterpret_cast<const uint8*>(Source));
+			}
+			else
+			{
+				static_assert(sizeof(CharType) == 2, "Unsupported character size.");
+
+				// Characters above 255 saturate to an invalid byte.
+				const uint16x8x4_t First  = vld4q_u16(reinterpret_cast<const uint16*>(Source));
+				const uint16x8x4_t Second = vld4q_u16(reinterpret_cast<const uint16*>(Source + 32));
+
+				for (int32 Lane = 0; Lane < 4; ++Lane)
+				{
+					Input.val[Lane] = vcombine_u8(vqmovn_u16(First.val[Lane]), vqmovn_u16(Second.val[Lane]));
+				}
+			}
+
+			// Characters above 127 are out of both tables and flagged separately.
+			uint8x16_t Errors = vdupq_n_u8(0);
+			uint8x16x4_t Values;
+
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				const uint8x16_t Chars = Input.val[Lane];
+
+				Values.val[Lane] = vqtbx4q_u8(vqtbl4q_u8(LutLow, Chars), LutHigh, vsubq_u8(Chars, vdupq_n_u8(64)));
+				Errors = vorrq_u8(Errors, vorrq_u8(Values.val[Lane], vcgeq_u8(Chars, vdupq_n_u8(128))));
+			}
+
+			if (vmaxvq_u8(Errors) >= 64)
+			{
+				break;
+			}
+
+			uint8x16x3_t Output;
+			Output.val[0] = vorrq_u8(vshlq_n_u8(Values.val[0], 2), vshrq_n_u8(Values.val[1], 4));
+			Output.val[1] = vorrq_u8(vshlq_n_u8(Values.val[1], 4), vshrq_n_u8(Values.val[2], 2));
+			Output.val[2] = vorrq_u8(vshlq_n_u8(Values.val[2], 6), Values.val[3]);
+
+			vst3q_u8(Dest, Output);
+		}
+	}
+
+#else
+
+	template<typename CharType>
+	void EncodeVector(const uint8*& Source, int64& Size, CharType*& Dest)
+	{
+	}
+
+	template<typename CharType>
+	void DecodeVector(const CharType*& Source, int64& Length, uint8*& Dest)
+	{
+	}
+
+#endif
+
+	template<typename CharType>
+	int64 EncodeText(const uint8* Source, int64 Size, CharType* Dest)
+	{
+		CharType* const Start = Dest;
+
+		if (IsVectorized())
+		{
+			EncodeVector(Source, Size, Dest);
+		}
+
+		return (Dest - Start) + EncodeScalar(Source, Size, Dest);
+	}
+
+	template<typename CharType>
+	bool DecodeText(const CharType* Source, int64 Length, uint8* Dest, int64& OutSize)
+	{
+		// Padded and unpadded text are handled the same, as FBase64 does.
+		while (Length > 0 && Source[Length - 1] == '=')
+		{
+			--Length;
+		}
+
+		if ((Length & 3) == 1)
+		{
+			return false;
+		}
+
+		uint8* const Start = Dest;
+
+		if (IsVectorized())
+		{
+			DecodeVector(Source, Length, Dest);
+		}
+
+		int64 TailSize = 0;
+		if (!DecodeScalar(Source, Length, Dest, TailSize))
+		{
+			return false;
+		}
+
+		OutSize = (Dest - Start) + TailSize;
+		return true;
+	}
+
+	FORCEINLINE bool IsSkippedChar(const ANSICHAR Char)
+	{
+		return Char == ' ' || Char == '\r' || Char == '\n' || Char == '\t';
+	}
+}
+
+int64 FHttpBase64::GetEncodedLength(const int64 Size)
+{
+	return (Size + 2) / 3 * 4;
+}
+
+int64 FHttpBase64::GetMaxDecodedSize(const int64 Length)
+{
+	return Length / 4 * 3 + (Length % 4) * 3 / 4;
+}
+
+int64 FHttpBase64::Encode(const uint8* const Source, const int64 Size, ANSICHAR* const Dest)
+{
+	return EncodeText(Source, Size, Dest);
+}
+
+int64 FHttpBase64::Encode(const uint8* const Source, const int64 Size, TCHAR* const Dest)
+{
+	return EncodeText(Source, Size, Dest);
+}
+
+bool FHttpBase64::Decode(const ANSICHAR* const Source, const int64 Length, uint8* const Dest, int64& OutSize)
+{
+	return DecodeText(Source, Length, Dest, OutSize);
+}
+
+bool FHttpBase64::Decode(const TCHAR* const Source, const int64 Length, uint8* const Dest, int64& OutSize)
+{
+	return DecodeText(Source, Length, Dest, OutSize);
+}
+
+FString FHttpBase64::Encode(TArrayView<const uint8> Data)
+{
+	FString Text;
+	Encode(Data, Text);
+	return Text;
+}
+
+void FHttpBase64::Encode(TArrayView<const uint8> Data, FString& OutText)
+{
+	const int64 Length = GetEncodedLength(Data.Num());
+
+	TArray<TCHAR>& Chars = OutText.GetCharArray();
+	if (Length == 0)
+	{
+		Chars.Reset();
+		return;
+	}
+
+	Chars.SetNumUninitialized(Length + 1, EAllowShrinking::No);
+	Encode(Data.GetData(), Data.Num(), Chars.GetData());
+	Chars[Length] = TEXT('\0');
+}
+
+bool FHttpBase64::Decode(const FString& Text, TArray<uint8>& OutData)
+{
+	OutData.SetNumUninitialized(GetMaxDecodedSize(Text.Len()), EAllowShrinking::No);
+
+	int64 Size = 0;
+	if (!Decode(*Text, Text.Len(), OutData.GetData(), Size))
+	{
+		OutData.Reset();
+		return false;
+	}
+
+	OutData.SetNum(Size, EAllowShrinking::No);
+	return true;
+}
+
+const TCHAR* FHttpBase64::GetKernelName()
+{
+	if (IsVectorized())
+	{
+		return BLUEPRINTHTTP_SSSE3 ? TEXT("SSSE3") : TEXT("NEON");
+	}
+
+	return TEXT("Scalar");
+}
+
+void FHttpBase64Encoder::Update(const uint8* Data, int64 Size, TArray<ANSICHAR>& Out)
+{
+	// Completes the group left by the last chunk.
+	while (NumPending > 0 && NumPending < 3 && Size > 0)
+	{
+		Pending[NumPending++] = *Data++;
+		--Size;
+	}
+
+	if (NumPending == 3)
+	{
+		FHttpBase64::Encode(Pending, 3, &Out[Out.AddUninitialized(4)]);
+		NumPending = 0;
+	}
+
+	const int64 Whole = Size / 3 * 3;
+	if (Whole > 0)
+	{
+		FHttpBase64::Encode(Data, Whole, &Out[Out.AddUninitialized(FHttpBase64::GetEncodedLength(Whole))]);
+	}
+
+	for (int64 Index = Whole; Index < Size; ++Index)
+	{
+		Pending[NumPending++] = Data[Index];
+	}
+}
+
+void FHttpBase64Encoder::Finalize(TArray<ANSICHAR>& Out)
+{
+	if (NumPending > 0)
+	{
+		FHttpBase64::Encode(Pending, NumPending, &Out[Out.AddUninitialized(4)]);
+		NumPending = 0;
+	}
+}
+
+bool FHttpBase64Decoder::Update(const ANSICHAR* Chunk, int64 Length, TArray<uint8>& Out)
+{
+	if (bError)
+	{
+		return false;
+	}
+
+	// Most chunks are unwrapped and unpadded, they are appended at once.
+	int64 Clean = 0;
+	while (Clean < Length && !IsSkippedChar(Chunk[Clean]) && Chunk[Clean] != '=')
+	{
+		++Clean;
+	}
+
+	if (bPadded && Clean > 0)
+	{
+		bError = true;
+		return false;
+	}
+
+	Text.Append(Chunk, Clean);
+
+	for (int64 Index = Clean; Index < Length; ++Index)
+	{
+		const ANSICHAR Char = Chunk[Index];
+
+		if (IsSkippedChar(Char))
+		{
+			continue;
+		}
+
+		if (Char == '=')
+		{
+			bPadded = true;
+		}
+		else if (bPadded)
+		{
+			bError = true;
+			return false;
+		}
+
+		Text.Add(Char);
+	}
+
+	// The group holding the padding is decoded by Finalize().
+	int32 Usable = Text.Num();
+	if (bPadded)
+	{
+		Text.Find('=', Usable);
+	}
+
+	const int32 Whole = Usable / 4 * 4;
+	if (Whole > 0)
+	{
+		const int32 Offset = Out.AddUninitialized(Whole / 4 * 3);
+
+		int64 Size = 0;
+		if (!FHttpBase64::Decode(Text.GetData(), Whole, Out.GetData() + Offset, Size))
+		{
+			Out.SetNum(Offset, EAllowShrinking::No);
+			bError = true;
+			return false;
+		}
+
+		Text.RemoveAt(0, Whole, EAllowShrinking::No);
+	}
+
+	return true;
+}
+
+bool FHttpBase64Decoder::Finalize(TArray<uint8>& Out)
+{
+	bool bSucceeded = !bError;
+
+	if (bSucceeded && Text.Num() > 0)
+	{
+		const int32 Offset = Out.AddUninitialized(FHttpBase64::GetMaxDecodedSize(Text.Num()));
+
+		int64 Size = 0;
+		bSucceeded = FHttpBase64::Decode(Text.GetData(), Text.Num(), Out.GetData() + Offset, Size);
+
+		Out.SetNum(Offset + (bSucceeded ? Size : 0), EAllowShrinking::No);
+	}
+
+	Text.Reset();
+	bPadded = false;
+	bError	= false;
+
+	return bSucceeded;
+}
+
+FHttpBase64Stream::FHttpBase64Stream(const EMode InMode, const TSharedRef<FArchive, ESPMode::ThreadSafe>& InInner)
+	: Inner(InInner)
+	, BytesWritten(0)
+	, Mode(InMode)
+	, bFinalized(false)
+{
+	SetIsSaving(true);
+}
+
+FHttpBase64Stream::~FHttpBase64Stream()
+{
+	Finalize();
+}
+
+void FHttpBase64Stream::Serialize(void* Data, int64 Length)
+{
+	if (IsError() || bFinalized)
+	{
+		return;
+	}
+
+	if (Mode == EMode::Encode)
+	{
+		Encoder.Update(static_cast<const uint8*>(Data), Length, EncodedChunk);
+	}
+	else if (!Decoder.Update(static_cast<const ANSICHAR*>(Data), Length, DecodedChunk))
+	{
+		SetError();
+		return;
+	}
+
+	Flush();
+}
+
+void FHttpBase64Stream::Flush()
+{
+	if (EncodedChunk.Num() > 0)
+	{
+		Inner->Serialize(EncodedChunk.GetData(), EncodedChunk.Num());
+		BytesWritten += EncodedChunk.Num();
+		EncodedChunk.Reset();
+	}
+
+	if (DecodedChunk.Num() > 0)
+	{
+		Inner->Serialize(DecodedChunk.GetData(), DecodedChunk.Num());
+		BytesWritten += DecodedChunk.Num();
+		DecodedChunk.Reset();
+	}
+}
+
+bool FHttpBase64Stream::Finalize()
+{
+	if (bFinalized)
+	{
+		return !IsError();
+	}
+
+	bFinalized = true;
+
+	if (IsError())
+	{
+		return false;
+	}
+
+	if (Mode == EMode::Encode)
+	{
+		Encoder.Finalize(EncodedChunk);
+	}
+	else if (!Decoder.Finalize(DecodedChunk))
+	{
+		SetError();
+		return false;
+	}
+
+	Flush();
+	return true;
+}
+
+bool FHttpBase64Stream::Close()
+{
+	return Finalize();
+}
@@ -0,0 +1,205 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpBenchmarkUtils.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "Http.h"
+
+namespace
+{
+	/* Returns the memory allocated by the process, -1 if LLM doesn't track it. */
+	int64 GetAllocatedBytes()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::Get().IsEnabled())
+		{
+			return FLowLevelMemTracker::Get().GetTotalTrackedMemory(ELLMTracker::Default);
+		}
+#endif
+		return -1;
+	}
+}
+
+void FHttpBenchmarkSamples::Add(const double Seconds)
+{
+	Samples.Add(Seconds);
+	bSorted = false;
+}
+
+void FHttpBenchmarkSamples::Reset()
+{
+	Samples.Reset();
+	bSorted = false;
+}
+
+double FHttpBenchmarkSamples::GetPercentileMs(const double P)
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.;
+	}
+
+	if (!bSorted)
+	{
+		Samples.Sort();
+		bSorted = true;
+	}
+
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt32(P / 100. * Samples.Num()) - 1, 0, Samples.Num() - 1);
+
+	return Samples[Rank] * 1000.;
+}
+
+double FHttpBenchmarkSamples::GetMeanMs() const
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.;
+	}
+
+	double Sum = 0.;
+	for (const double Sample : Samples)
+	{
+		Sum += Sample;
+	}
+
+	return Sum * 1000. / Samples.Num();
+}
+
+void FHttpBenchmarkSamples::WriteTo(FJsonObject& Object)
+{
+	Object.SetNumberField(TEXT("count"),   Samples.Num());
+	Object.SetNumberField(TEXT("mean_ms"), GetMeanMs());
+	Object.SetNumberField(TEXT("p50_ms"),  GetPercentileMs(50.));
+	Object.SetNumberField(TEXT("p90_ms"),  GetPercentileMs(90.));
+	Object.SetNumberField(TEXT("p99_ms"),  GetPercentileMs(99.));
+	Object.SetNumberField(TEXT("max_ms"),  GetPercentileMs(100.));
+}
+
+FHttpBenchmarkResourceProbe::FHttpBenchmarkResourceProbe()
+	: StartResident(0)
+	, PeakResident(0)
+	, EndResident(0)
+	, StartAllocated(0)
+	, PeakAllocated(0)
+	, EndAllocated(0)
+	, StartObjectCount(0)
+	, PeakObjectCount(0)
+	, GCStartTime(0.)
+	, GCSeconds(0.)
+	, GCCount(0)
+	, bRunning(false)
+	, bTracksAllocations(false)
+{
+	PreGCHandle  = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FHttpBenchmarkResourceProbe::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect()       .AddRaw(this, &FHttpBenchmarkResourceProbe::OnPostGarbageCollect);
+}
+
+FHttpBenchmarkResourceProbe::~FHttpBenchmarkResourceProbe()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect()       .Remove(PostGCHandle);
+}
+
+void FHttpBenchmarkResourceProbe::Begin()
+{
+	StartResident  = PeakResident  = EndResident  = FPlatformMemory::GetStats().UsedPhysical;
+	StartAllocated = PeakAllocated = EndAllocated = GetAllocatedBytes();
+
+	bTracksAllocations = StartAllocated >= 0;
+
+	if (!bTracksAllocations)
+	{
+		UE_LOG(LogHttp, Display, TEXT("Benchmark: Run with -LLM to measure the allocated memory next to the RSS."));
+	}
+	StartObjectCount  = PeakObjectCount  = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+	GCSeconds = 0.;
+	GCCount   = 0;
+	bRunning  = true;
+}
+
+void FHttpBenchmarkResourceProbe::Sample()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	PeakResident = FMath::Max<uint64>(PeakResident, FPlatformMemory::GetStats().UsedPhysical);
+	PeakAllocated = FMath::Max<int64>(PeakAllocated, GetAllocatedBytes());
+	PeakObjectCount  = FMath::Max(PeakObjectCount, GUObjectArray.GetObjectArrayNumMinusAvailable());
+}
+
+void FHttpBenchmarkResourceProbe::End()
+{
+	Sample();
+
+	EndResident  = FPlatformMemory::GetStats().UsedPhysical;
+	EndAllocated = GetAllocatedBytes();
+	bRunning = false;
+}
+
+void FHttpBenchmarkResourceProbe::WriteTo(FJsonObject& Object) const
+{
+	Object.SetNumberField(TEXT("rss_delta_bytes"),           static_cast<double>(static_cast<int64>(EndResident) - static_cast<int64>(StartResident)));
+	Object.SetNumberField(TEXT("rss_peak_growth_bytes"),     static_cast<double>(PeakResident - StartResident));
+
+	if (bTracksAllocations)
+	{
+		Object.SetNumberField(TEXT("allocated_delta_bytes"),       static_cast<double>(EndAllocated  - StartAllocated));
+		Object.SetNumberField(TEXT("allocated_peak_growth_bytes"), static_cast<double>(PeakAllocated - StartAllocated));
+	}
+
+	Object.SetNumberField(TEXT("uobjects_peak_delta"),       PeakObjectCount - StartObjectCount);
+	Object.SetNumberField(TEXT("gc_count"),                  GCCount);
+	Object.SetNumberField(TEXT("gc_ms"),                     GCSeconds * 1000.);
+}
+
+void FHttpBenchmarkResourceProbe::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void FHttpBenchmarkResourceProbe::OnPostGarbageCollect()
+{
+	if (bRunning)
+	{
+		GCSeconds += FPlatformTime::Seconds() - GCStartTime;
+		++GCCount;
+	}
+}
+
+FString BlueprintHttpBenchmark::GetBenchmarkDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("BlueprintHttp"), TEXT("Benchmarks"));
+}
+
+FString BlueprintHttpBenchmark::WriteReport(const TSharedRef<FJsonObject>& Report, const FString& Name, const FString& OutPath)
+{
+	const FString Path = !OutPath.IsEmpty() ? OutPath
+		: FPaths::Combine(GetBenchmarkDir(), FString::Printf(TEXT("%s-%s.json"), *Name, *FDateTime::Now().ToString()));
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+	if (!FJsonSerializer::Serialize(Report, Writer) || !FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Benchmark: Failed to write report to \"%s\"."), *FPaths::ConvertRelativePathToFull(Path));
+		return FString();
+	}
+
+	UE_LOG(LogHttp, Display, TEXT("Benchmark: Report written to \"%s\"."), *FPaths::ConvertRelativePathToFull(Path));
+
+	return Path;
+}
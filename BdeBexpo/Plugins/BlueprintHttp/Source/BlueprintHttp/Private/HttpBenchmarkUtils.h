@@ -0,0 +1,95 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ *  Latency samples of a benchmark scenario.
+ *  Percentiles are computed with the nearest-rank method.
+ **/
+struct FHttpBenchmarkSamples
+{
+public:
+	void Add(const double Seconds);
+	void Reset();
+
+	FORCEINLINE int32 Num() const { return Samples.Num(); }
+
+	/* Returns the P-th percentile (0 - 100) in milliseconds. */
+	double GetPercentileMs(const double P);
+
+	/* Returns the mean in milliseconds. */
+	double GetMeanMs() const;
+
+	/* Writes count, mean, p50, p90, p99 and max into the object. */
+	void WriteTo(FJsonObject& Object);
+
+private:
+	TArray<double> Samples;
+	bool bSorted = false;
+};
+
+/**
+ *  Measures what a scenario costs the process: growth of the resident set (RSS) and of the
+ *  allocated memory, UObjects created and time spent in garbage collection.
+ *  The RSS includes the pages the allocator keeps cached, it isn't the memory allocated.
+ *  The allocated memory is the total tracked by LLM, only reported when running with -LLM.
+ **/
+class FHttpBenchmarkResourceProbe
+{
+public:
+	FHttpBenchmarkResourceProbe();
+	~FHttpBenchmarkResourceProbe();
+
+	void Begin();
+
+	/* Keeps track of the peak, call it once per tick while the scenario runs. */
+	void Sample();
+
+	void End();
+
+	void WriteTo(FJsonObject& Object) const;
+
+private:
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+
+	// Resident set of the process, in bytes.
+	uint64 StartResident;
+	uint64 PeakResident;
+	uint64 EndResident;
+
+	// Memory allocated by the process according to LLM, in bytes.
+	int64 StartAllocated;
+	int64 PeakAllocated;
+	int64 EndAllocated;
+
+	int32 StartObjectCount;
+	int32 PeakObjectCount;
+
+	double GCStartTime;
+	double GCSeconds;
+	int32  GCCount;
+
+	bool bRunning;
+	bool bTracksAllocations;
+};
+
+namespace BlueprintHttpBenchmark
+{
+	/**
+	 * Saves the report as JSON.
+	 * @param OutPath	Where to write the report. Defaults to Saved/BlueprintHttp/Benchmarks/<Name>-<Date>.json.
+	 * @return The path the report was written to or an empty string on failure.
+	 **/
+	FString WriteReport(const TSharedRef<FJsonObject>& Report, const FString& Name, const FString& OutPath);
+
+	/* Returns the directory where benchmarks store their reports and temporary files. */
+	FString GetBenchmarkDir();
+}
@@ -0,0 +1,193 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpCancellation.h"
+#include "HttpRequest.h"
+#include "BlueprintHttpNodes.h"
+#include "Http.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	/* Seconds between two checks of the owners and of the collected requests. */
+	constexpr float OwnerPollInterval = 0.25f;
+}
+
+TArray<FHttpCancellation::FBinding> FHttpCancellation::Bindings;
+FTSTicker::FDelegateHandle			FHttpCancellation::TickerHandle;
+FDelegateHandle						FHttpCancellation::WorldCleanupHandle;
+
+void FHttpCancellation::BindToOwner(UHttpRequest* const Request, UObject* const Owner, UBlueprintAsyncActionBase* const Node)
+{
+	if (!Request || !Owner)
+	{
+		return;
+	}
+
+	FBinding& Binding = Bindings.AddDefaulted_GetRef();
+	Binding.Request = Request;
+	Binding.Node	= Node;
+	Binding.Owner	= Owner;
+
+	StartTicker();
+}
+
+void FHttpCancellation::BindToScope(UHttpRequest* const Request, const FName Scope, UBlueprintAsyncActionBase* const Node)
+{
+	if (!Request || Scope.IsNone())
+	{
+		return;
+	}
+
+	FBinding& Binding = Bindings.AddDefaulted_GetRef();
+	Binding.Request = Request;
+	Binding.Node	= Node;
+	Binding.Scope	= Scope;
+
+	StartTicker();
+}
+
+void FHttpCancellation::StartTicker()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FHttpCancellation::Tick), OwnerPollInterval);
+	}
+}
+
+int32 FHttpCancellation::CancelScope(const FName Scope, const bool bNotifyListeners)
+{
+	return CancelIf([Scope](const FBinding& Binding) { return Binding.Scope == Scope; }, bNotifyListeners);
+}
+
+int32 FHttpCancellation::CancelOwner(const UObject* const Owner, const bool bNotifyListeners)
+{
+	return CancelIf([Owner](const FBinding& Binding) { return Binding.Owner.Get() == Owner; }, bNotifyListeners);
+}
+
+UHttpRequest* FHttpCancellation::GetNodeRequest(const UBlueprintAsyncActionBase* const Node)
+{
+	if (const USendHttpRequestProxyBase* const SendProxy = Cast<USendHttpRequestProxyBase>(Node))
+	{
+		return SendProxy->GetHttpRequest();
+	}
+
+	if (const UHttpDownloadFileProxy* const DownloadProxy = Cast<UHttpDownloadFileProxy>(Node))
+	{
+		return DownloadProxy->GetHttpRequest();
+	}
+
+	if (const UProcessHttpRequestProxy* const ProcessProxy = Cast<UProcessHttpRequestProxy>(Node))
+	{
+		return ProcessProxy->GetHttpRequest();
+	}
+
+	return nullptr;
+}
+
+template<typename PredicateType>
+int32 FHttpCancellation::CancelIf(PredicateType&& Predicate, const bool bNotifyListeners)
+{
+	// Cancelling can bind new requests from the delegates, so matches are taken out first.
+	TArray<FBinding> Matches;
+
+	for (int32 Index = Bindings.Num() - 1; Index >= 0; --Index)
+	{
+		if (Predicate(Bindings[Index]))
+		{
+			Matches.Add(Bindings[Index]);
+			Bindings.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	int32 Cancelled = 0;
+
+	for (const FBinding& Binding : Matches)
+	{
+		Cancelled += Binding.Request.IsValid() && Binding.Request->IsInFlight() ? 1 : 0;
+		Cancel(Binding, bNotifyListeners);
+	}
+
+	return Cancelled;
+}
+
+void FHttpCancellation::Cancel(const FBinding& Binding, const bool bNotifyListeners)
+{
+	if (UHttpRequest* const Request = Binding.Request.Get())
+	{
+		if (!bNotifyListeners)
+		{
+			Request->Abandon();
+		}
+		else if (Request->IsInFlight())
+		{
+			Request->CancelRequest();
+		}
+	}
+
+	// Silenced nodes never complete, they are released here.
+	if (UBlueprintAsyncActionBase* const Node = Binding.Node.Get())
+	{
+		if (!bNotifyListeners)
+		{
+			Node->SetReadyToDestroy();
+		}
+	}
+}
+
+bool FHttpCancellation::Tick(float DeltaTime)
+{
+	CancelIf([](const FBinding& Binding)
+	{
+		return !Binding.Owner.IsExplicitlyNull() && !Binding.Owner.IsValid();
+	}, false);
+
+	// Forgets the requests that were collected.
+	Bindings.RemoveAllSwap([](const FBinding& Binding) { return !Binding.Request.IsValid(); }, EAllowShrinking::No);
+
+	if (Bindings.IsEmpty())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FHttpCancellation::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	CancelIf([World](const FBinding& Binding)
+	{
+		const UObject* const Owner = Binding.Owner.Get();
+		return Owner && (Owner == World || Owner->GetWorld() == World);
+	}, false);
+}
+
+void FHttpCancellation::Startup()
+{
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FHttpCancellation::OnWorldCleanup);
+}
+
+void FHttpCancellation::Shutdown()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	WorldCleanupHandle.Reset();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	Bindings.Empty();
+}
+
+static FAutoConsoleCommand GHttpCancelScopeCommand(
+	TEXT("http.CancelScope"),
+	TEXT("Cancels the BlueprintHttp requests bound to a scope. Args: <Scope> [Notify]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	if (Args.Num() > 0)
+	{
+		const int32 Cancelled = FHttpCancellation::CancelScope(*Args[0], Args.Contains(TEXT("Notify")));
+		UE_LOG(LogHttp, Display, TEXT("Cancellation: Cancelled %d requests of scope \"%s\"."), Cancelled, *Args[0]);
+	}
+})
+);
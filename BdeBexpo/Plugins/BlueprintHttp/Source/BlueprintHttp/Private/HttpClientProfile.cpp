@@ -0,0 +1,203 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpClientProfile.h"
+#include "HttpUrl.h"
+#include "Http.h"
+
+namespace
+{
+	/* A profile with its values ready to be set on requests. */
+	struct FPreparedProfile
+	{
+		FHttpClientProfile Profile;
+
+		// Base URL without its trailing slashes.
+		FString BaseUrl;
+
+		TArray<TPair<FString, FString>> Headers;
+	};
+
+	TMap<FName, TSharedRef<const FPreparedProfile>>& GetProfiles()
+	{
+		static TMap<FName, TSharedRef<const FPreparedProfile>> Profiles;
+		return Profiles;
+	}
+
+	TSharedPtr<const FPreparedProfile> FindProfile(const FName ProfileName)
+	{
+		const TSharedRef<const FPreparedProfile>* const Profile = GetProfiles().Find(ProfileName);
+		return Profile ? TSharedPtr<const FPreparedProfile>(*Profile) : nullptr;
+	}
+
+	bool IsValidHeaderName(const FString& Name)
+	{
+		for (const TCHAR Char : Name)
+		{
+			if (Char <= TEXT(' ') || Char == TEXT(':') || Char >= 0x7F)
+			{
+				return false;
+			}
+		}
+
+		return !Name.IsEmpty();
+	}
+
+	FString BuildProfileUrl(const FPreparedProfile* const Profile, const FString& Path, const TMap<FString, FString>& UrlParameters)
+	{
+		FString Url;
+
+		if (!Profile || Path.Contains(TEXT("://"), ESearchCase::CaseSensitive))
+		{
+			Url = Path;
+		}
+		else
+		{
+			FStringView RelativePath = Path;
+			while (!RelativePath.IsEmpty() && RelativePath[0] == TEXT('/'))
+			{
+				RelativePath.RightChopInline(1);
+			}
+
+			Url.Reserve(Profile->BaseUrl.Len() + RelativePath.Len() + 1);
+			Url += Profile->BaseUrl;
+
+			if (!RelativePath.IsEmpty())
+			{
+				Url += TEXT("/");
+				Url += RelativePath;
+			}
+		}
+
+		if (UrlParameters.Num() == 0)
+		{
+			return Url;
+		}
+
+		FHttpUrlBuilder Builder(Url, UrlParameters.Num() * 32);
+		Builder.AddQueryParameters(UrlParameters);
+
+		return Builder.Build();
+	}
+}
+
+void FHttpClientProfiles::Register(const FName ProfileName, const FHttpClientProfile& Profile)
+{
+	const TSharedRef<FPreparedProfile> Prepared = MakeShared<FPreparedProfile>();
+
+	Prepared->Profile = Profile;
+	Prepared->BaseUrl = Profile.BaseUrl.TrimStartAndEnd();
+
+	while (Prepared->BaseUrl.EndsWith(TEXT("/"), ESearchCase::CaseSensitive))
+	{
+		Prepared->BaseUrl.LeftChopInline(1, EAllowShrinking::No);
+	}
+
+	Prepared->Headers.Reserve(Profile.Headers.Num());
+
+	for (const auto& Header : Profile.Headers)
+	{
+		FString Name  = Header.Key.TrimStartAndEnd();
+		FString Value = Header.Value.TrimStartAndEnd();
+
+		// Would split the header block.
+		if (!IsValidHeaderName(Name) || Value.Contains(TEXT("\r")) || Value.Contains(TEXT("\n")))
+		{
+			UE_LOG(LogHttp, Warning, TEXT("Profiles: Header \"%s\" of profile \"%s\" ignored, it isn't a valid header."), *Header.Key, *ProfileName.ToString());
+			continue;
+		}
+
+		Prepared->Headers.Emplace(MoveTemp(Name), MoveTemp(Value));
+	}
+
+	GetProfiles().Add(ProfileName, Prepared);
+}
+
+bool FHttpClientProfiles::Unregister(const FName ProfileName)
+{
+	return GetProfiles().Remove(ProfileName) > 0;
+}
+
+bool FHttpClientProfiles::Contains(const FName ProfileName)
+{
+	return GetProfiles().Contains(ProfileName);
+}
+
+bool FHttpClientProfiles::Find(const FName ProfileName, FHttpClientProfile& OutProfile)
+{
+	const TSharedPtr<const FPreparedProfile> Profile = FindProfile(ProfileName);
+	if (!Profile)
+	{
+		return false;
+	}
+
+	OutProfile = Profile->Profile;
+	return true;
+}
+
+TArray<FName> FHttpClientProfiles::GetProfileNames()
+{
+	TArray<FName> Names;
+	GetProfiles().GetKeys(Names);
+	return Names;
+}
+
+FString FHttpClientProfiles::ResolveUrl(const FName ProfileName, const FString& Path, const TMap<FString, FString>& UrlParameters)
+{
+	return BuildProfileUrl(FindProfile(ProfileName).Get(), Path, UrlParameters);
+}
+
+TMap<FString, FString> FHttpClientProfiles::GetHeaders(const FName ProfileName)
+{
+	TMap<FString, FString> Headers;
+
+	if (const TSharedPtr<const FPreparedProfile> Profile = FindProfile(ProfileName))
+	{
+		Headers.Reserve(Profile->Headers.Num());
+
+		for (const TPair<FString, FString>& Header : Profile->Headers)
+		{
+			Headers.Add(Header.Key, Header.Value);
+		}
+	}
+
+	return Headers;
+}
+
+bool FHttpClientProfiles::Apply(const FName ProfileName, UHttpRequest* const Request, const FString& Path, const TMap<FString, FString>& UrlParameters)
+{
+	if (!Request)
+	{
+		return false;
+	}
+
+	const TSharedPtr<const FPreparedProfile> Profile = FindProfile(ProfileName);
+
+	Request->SetURL(BuildProfileUrl(Profile.Get(), Path, UrlParameters));
+
+	if (!Profile)
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Profiles: Unknown profile \"%s\", request to \"%s\" sent without it."), *ProfileName.ToString(), *Path);
+		return false;
+	}
+
+	for (const TPair<FString, FString>& Header : Profile->Headers)
+	{
+		Request->SetHeader(Header.Key, Header.Value);
+	}
+
+	Request->SetTimeouts   (Profile->Profile.Timeouts);
+	Request->SetRetryPolicy(Profile->Profile.RetryPolicy);
+	Request->SetPriority   (Profile->Profile.Priority);
+
+	return true;
+}
+
+UHttpRequest* FHttpClientProfiles::CreateRequest(const FName ProfileName, const FString& Path, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb)
+{
+	UHttpRequest* const Request = UHttpRequest::CreateRequest();
+
+	Request->SetVerb(Verb);
+	Apply(ProfileName, Request, Path, UrlParameters);
+
+	return Request;
+}
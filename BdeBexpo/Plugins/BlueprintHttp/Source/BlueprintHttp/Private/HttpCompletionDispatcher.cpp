@@ -0,0 +1,218 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpCompletionDispatcher.h"
+#include "BlueprintHttpStats.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "Containers/Ticker.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/StrongObjectPtr.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Completion Backlog"),				STAT_BlueprintHttp_CompletionBacklog,	 STATGROUP_BlueprintHttp);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Completions Delivered"),			STAT_BlueprintHttp_CompletionsDelivered, STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Completion Time (ms)"),			STAT_BlueprintHttp_CompletionTime,		 STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Oldest Queued Completion (ms)"),	STAT_BlueprintHttp_CompletionWait,		 STATGROUP_BlueprintHttp);
+
+static float GHttpCompletionFrameBudgetMs = 4.f;
+static FAutoConsoleVariableRef CVarHttpCompletionFrameBudget(
+	TEXT("http.Completion.FrameBudgetMs"),
+	GHttpCompletionFrameBudgetMs,
+	TEXT("Time BlueprintHttp request completions can take each frame, in milliseconds. 0 delivers all of them right away."));
+
+namespace
+{
+	struct FPendingCompletion
+	{
+		TStrongObjectPtr<UHttpRequest>	Request;
+		TStrongObjectPtr<UHttpResponse> Response;
+		bool   bConnectedSuccessfully;
+		double QueuedTime;
+	};
+
+	constexpr int32 PriorityCount = 3;
+
+	struct FDispatcherState
+	{
+		/* One FIFO per priority, Interactive last. */
+		TArray<FPendingCompletion> Queues[PriorityCount];
+
+		FTSTicker::FDelegateHandle TickerHandle;
+
+		uint64 Frame		= MAX_uint64;
+		double SpentTime	= 0.;
+		int32  Delivered	= 0;
+
+		int32 GetBacklog() const
+		{
+			return Queues[0].Num() + Queues[1].Num() + Queues[2].Num();
+		}
+	};
+
+	FDispatcherState& GetState()
+	{
+		static FDispatcherState State;
+		return State;
+	}
+
+	/* Starts accounting a new frame if needed. */
+	void UpdateFrame(FDispatcherState& State)
+	{
+		if (State.Frame != GFrameCounter)
+		{
+			State.Frame		= GFrameCounter;
+			State.SpentTime = 0.;
+			State.Delivered = 0;
+		}
+	}
+
+	bool HasBudgetLeft(const FDispatcherState& State)
+	{
+		return GHttpCompletionFrameBudgetMs <= 0.f || State.SpentTime * 1000. < GHttpCompletionFrameBudgetMs;
+	}
+
+	void Deliver(FDispatcherState& State, UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		Request->DeliverCompletion(Response, bConnectedSuccessfully);
+
+		State.SpentTime += FPlatformTime::Seconds() - StartTime;
+		State.Delivered += 1;
+
+		SET_DWORD_STAT(STAT_BlueprintHttp_CompletionsDelivered, State.Delivered);
+		SET_FLOAT_STAT(STAT_BlueprintHttp_CompletionTime, State.SpentTime * 1000.);
+	}
+
+	void UpdateBacklogStats(const FDispatcherState& State)
+	{
+		double OldestQueuedTime = FPlatformTime::Seconds();
+		for (const TArray<FPendingCompletion>& Queue : State.Queues)
+		{
+			if (Queue.Num() > 0)
+			{
+				OldestQueuedTime = FMath::Min(OldestQueuedTime, Queue[0].QueuedTime);
+			}
+		}
+
+		SET_DWORD_STAT(STAT_BlueprintHttp_CompletionBacklog, State.GetBacklog());
+		SET_FLOAT_STAT(STAT_BlueprintHttp_CompletionWait, (FPlatformTime::Seconds() - OldestQueuedTime) * 1000.);
+	}
+
+	/* Delivers queued completions, highest priority first, while bCanDeliver allows it. */
+	template<typename PredicateType>
+	void Drain(FDispatcherState& State, PredicateType&& bCanDeliver)
+	{
+		for (int32 Priority = PriorityCount - 1; Priority >= 0; --Priority)
+		{
+			TArray<FPendingCompletion>& Queue = State.Queues[Priority];
+
+			int32 Count = 0;
+			while (Count < Queue.Num() && bCanDeliver(static_cast<EHttpRequestPriority>(Priority)))
+			{
+				// Moved out as delivering can queue more completions.
+				FPendingCompletion Pending = MoveTemp(Queue[Count++]);
+				Deliver(State, Pending.Request.Get(), Pending.Response.Get(), Pending.bConnectedSuccessfully);
+			}
+
+			Queue.RemoveAt(0, Count, EAllowShrinking::No);
+		}
+
+		UpdateBacklogStats(State);
+	}
+
+	bool Tick(float)
+	{
+		FDispatcherState& State = GetState();
+
+		UpdateFrame(State);
+
+		Drain(State, [&State](const EHttpRequestPriority Priority)
+		{
+			// Something is delivered each frame so the backlog always shrinks.
+			return Priority == EHttpRequestPriority::Interactive || State.Delivered == 0 || HasBudgetLeft(State);
+		});
+
+		if (State.GetBacklog() == 0)
+		{
+			State.TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+}
+
+void FHttpCompletionDispatcher::Dispatch(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	FDispatcherState& State = GetState();
+
+	UpdateFrame(State);
+
+	const EHttpRequestPriority Priority = Request->GetPriority();
+
+	// Queued completions of the same priority are delivered first to keep the order.
+	const bool bCanDeliverNow = State.Queues[static_cast<int32>(Priority)].Num() == 0
+		&& (Priority == EHttpRequestPriority::Interactive || HasBudgetLeft(State));
+
+	if (bCanDeliverNow)
+	{
+		Deliver(State, Request, Response, bConnectedSuccessfully);
+		return;
+	}
+
+	State.Queues[static_cast<int32>(Priority)].Add({ TStrongObjectPtr<UHttpRequest>(Request), TStrongObjectPtr<UHttpResponse>(Response), bConnectedSuccessfully, FPlatformTime::Seconds() });
+
+	UpdateBacklogStats(State);
+
+	if (!State.TickerHandle.IsValid())
+	{
+		State.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+	}
+}
+
+void FHttpCompletionDispatcher::SetFrameBudget(const float Seconds)
+{
+	GHttpCompletionFrameBudgetMs = FMath::Max(Seconds, 0.f) * 1000.f;
+}
+
+float FHttpCompletionDispatcher::GetFrameBudget()
+{
+	return GHttpCompletionFrameBudgetMs / 1000.f;
+}
+
+int32 FHttpCompletionDispatcher::GetBacklog()
+{
+	return GetState().GetBacklog();
+}
+
+void FHttpCompletionDispatcher::Flush()
+{
+	FDispatcherState& State = GetState();
+
+	while (State.GetBacklog() > 0)
+	{
+		Drain(State, [](const EHttpRequestPriority) { return true; });
+	}
+}
+
+void FHttpCompletionDispatcher::Reset()
+{
+	FDispatcherState& State = GetState();
+
+	// Listeners such as the async nodes only release themselves once their completion is delivered.
+	if (UObjectInitialized())
+	{
+		Flush();
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(State.TickerHandle);
+	State.TickerHandle.Reset();
+
+	for (TArray<FPendingCompletion>& Queue : State.Queues)
+	{
+		Queue.Empty();
+	}
+
+	UpdateBacklogStats(State);
+}
@@ -0,0 +1,234 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpConnectionWarmer.h"
+#include "HttpTransport.h"
+#include "BlueprintHttpStats.h"
+#include "HttpModule.h"
+#include "Http.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "PlatformHttp.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Warm Hosts"),				  STAT_BlueprintHttp_WarmHosts,	  STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last Time To First Byte (ms)"), STAT_BlueprintHttp_FirstByte, STATGROUP_BlueprintHttp);
+
+static float GHttpPrewarmKeepAliveInterval = 20.f;
+static FAutoConsoleVariableRef CVarHttpPrewarmKeepAliveInterval(
+	TEXT("http.Prewarm.KeepAliveInterval"),
+	GHttpPrewarmKeepAliveInterval,
+	TEXT("Seconds between two requests keeping a prewarmed BlueprintHttp connection alive."));
+
+namespace
+{
+	/* Seconds between two checks of the warm hosts. */
+	constexpr float WarmerTickInterval = 1.f;
+
+	struct FWarmHost
+	{
+		FString Url;
+		double WarmUntil = 0.;
+		double NextKeepAlive = 0.;
+		bool bConnected = false;
+		TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> PendingRequest;
+	};
+
+	struct FFirstByteSamples
+	{
+		FHttpFirstByteStats Stats;
+		double ColdTotal = 0.;
+		double WarmTotal = 0.;
+	};
+
+	struct FWarmerState
+	{
+		TMap<FString, FWarmHost> Hosts;
+		TMap<FString, FFirstByteSamples> FirstBytes;
+
+		FTSTicker::FDelegateHandle TickerHandle;
+	};
+
+	FWarmerState& GetState()
+	{
+		static FWarmerState State;
+		return State;
+	}
+
+	FString MakeWarmUrl(const FString& HostOrUrl)
+	{
+		return HostOrUrl.Contains(TEXT("://")) ? HostOrUrl : TEXT("https://") + HostOrUrl;
+	}
+
+	void Connect(const FString& Host, FWarmHost& WarmHost)
+	{
+		// Recorded and replayed sessions don't reach the network.
+		if (WarmHost.PendingRequest || FHttpTransports::GetMode() != EHttpTransportMode::Network)
+		{
+			return;
+		}
+
+		const double SentTime = FPlatformTime::Seconds();
+
+		WarmHost.NextKeepAlive = SentTime + GHttpPrewarmKeepAliveInterval;
+
+		WarmHost.PendingRequest = FHttpModule::Get().CreateRequest();
+		WarmHost.PendingRequest->SetVerb(TEXT("HEAD"));
+		WarmHost.PendingRequest->SetURL(WarmHost.Url);
+		WarmHost.PendingRequest->OnProcessRequestComplete().BindLambda([Host, SentTime](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+		{
+			FWarmHost* const WarmHost = GetState().Hosts.Find(Host);
+
+			if (!WarmHost)
+			{
+				return;
+			}
+
+			WarmHost->PendingRequest.Reset();
+			WarmHost->bConnected = bConnectedSuccessfully;
+
+			if (bConnectedSuccessfully)
+			{
+				UE_LOG(LogHttp, Verbose, TEXT("Prewarm: Connected to \"%s\" in %.0fms."), *Host, (FPlatformTime::Seconds() - SentTime) * 1000.);
+			}
+			else
+			{
+				UE_LOG(LogHttp, Warning, TEXT("Prewarm: Failed to connect to \"%s\"."), *Host);
+			}
+		});
+
+		WarmHost.PendingRequest->ProcessRequest();
+	}
+
+	bool Tick(float)
+	{
+		FWarmerState& State = GetState();
+
+		const double Now = FPlatformTime::Seconds();
+
+		for (auto It = State.Hosts.CreateIterator(); It; ++It)
+		{
+			FWarmHost& WarmHost = It.Value();
+
+			if (Now >= WarmHost.WarmUntil)
+			{
+				if (WarmHost.PendingRequest)
+				{
+					WarmHost.PendingRequest->OnProcessRequestComplete().Unbind();
+					WarmHost.PendingRequest->CancelRequest();
+				}
+
+				It.RemoveCurrent();
+				continue;
+			}
+
+			if (Now >= WarmHost.NextKeepAlive)
+			{
+				Connect(It.Key(), WarmHost);
+			}
+		}
+
+		SET_DWORD_STAT(STAT_BlueprintHttp_WarmHosts, State.Hosts.Num());
+
+		if (State.Hosts.Num() == 0)
+		{
+			State.TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+}
+
+void FHttpConnectionWarmer::Prewarm(const TArray<FString>& Hosts, const float KeepWarmDuration)
+{
+	FWarmerState& State = GetState();
+
+	const double Now = FPlatformTime::Seconds();
+
+	for (const FString& HostOrUrl : Hosts)
+	{
+		const FString Url  = MakeWarmUrl(HostOrUrl);
+		const FString Host = FPlatformHttp::GetUrlDomain(Url);
+
+		if (Host.IsEmpty())
+		{
+			UE_LOG(LogHttp, Warning, TEXT("Prewarm: \"%s\" isn't a valid host."), *HostOrUrl);
+			continue;
+		}
+
+		FWarmHost& WarmHost = State.Hosts.FindOrAdd(Host);
+		WarmHost.Url	   = Url;
+		WarmHost.WarmUntil = FMath::Max(WarmHost.WarmUntil, Now + FMath::Max(KeepWarmDuration, 0.f));
+
+		Connect(Host, WarmHost);
+	}
+
+	if (State.Hosts.Num() > 0 && !State.TickerHandle.IsValid())
+	{
+		State.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick), WarmerTickInterval);
+	}
+}
+
+bool FHttpConnectionWarmer::IsWarm(const FString& Host)
+{
+	const FWarmHost* const WarmHost = GetState().Hosts.Find(Host);
+
+	return WarmHost && WarmHost->bConnected && WarmHost->WarmUntil > FPlatformTime::Seconds();
+}
+
+void FHttpConnectionWarmer::ReportFirstByte(const FString& Host, const float Seconds)
+{
+	FFirstByteSamples& Samples = GetState().FirstBytes.FindOrAdd(Host);
+
+	Samples.Stats.Last = Seconds;
+
+	if (IsWarm(Host))
+	{
+		Samples.WarmTotal += Seconds;
+		Samples.Stats.AverageWarm = Samples.WarmTotal / ++Samples.Stats.WarmSamples;
+	}
+	else
+	{
+		Samples.ColdTotal += Seconds;
+		Samples.Stats.AverageCold = Samples.ColdTotal / ++Samples.Stats.ColdSamples;
+	}
+
+	SET_FLOAT_STAT(STAT_BlueprintHttp_FirstByte, Seconds * 1000.f);
+}
+
+FHttpFirstByteStats FHttpConnectionWarmer::GetFirstByteStats(const FString& Host)
+{
+	const FFirstByteSamples* const Samples = GetState().FirstBytes.Find(Host);
+
+	return Samples ? Samples->Stats : FHttpFirstByteStats();
+}
+
+void FHttpConnectionWarmer::Reset()
+{
+	FWarmerState& State = GetState();
+
+	for (TPair<FString, FWarmHost>& WarmHost : State.Hosts)
+	{
+		if (WarmHost.Value.PendingRequest)
+		{
+			WarmHost.Value.PendingRequest->OnProcessRequestComplete().Unbind();
+			WarmHost.Value.PendingRequest->CancelRequest();
+		}
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(State.TickerHandle);
+	State.TickerHandle.Reset();
+
+	State.Hosts		.Empty();
+	State.FirstBytes.Empty();
+}
+
+static FAutoConsoleCommand GHttpPrewarmCommand(
+	TEXT("http.Prewarm"),
+	TEXT("Connects to hosts ahead of BlueprintHttp requests. Args: <Host> [Host...]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	FHttpConnectionWarmer::Prewarm(Args, 60.f);
+})
+);
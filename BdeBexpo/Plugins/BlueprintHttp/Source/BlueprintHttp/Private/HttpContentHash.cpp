@@ -0,0 +1,283 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpContentHash.h"
+#include "Misc/Base64.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+	constexpr uint32 Sha256RoundConstants[64] =
+	{
+		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+	};
+
+	FORCEINLINE uint32 RotateRight(const uint32 Value, const uint32 Bits)
+	{
+		return (Value >> Bits) | (Value << (32 - Bits));
+	}
+
+	/* Writes Value in big-endian order. */
+	void WriteBigEndian(const uint64 Value, const int32 Size, uint8* const Out)
+	{
+		for (int32 Index = 0; Index < Size; ++Index)
+		{
+			Out[Index] = uint8(Value >> (8 * (Size - 1 - Index)));
+		}
+	}
+
+	bool IsHexString(const FString& Value)
+	{
+		for (const TCHAR Char : Value)
+		{
+			if (!FChar::IsHexDigit(Char))
+			{
+				return false;
+			}
+		}
+		return !Value.IsEmpty();
+	}
+
+	/* Names of an algorithm in the Digest headers. */
+	bool IsDigestName(const FString& Name, const EHttpHashAlgorithm Algorithm)
+	{
+		switch (Algorithm)
+		{
+		case EHttpHashAlgorithm::SHA1:		return Name == TEXT("sha") || Name == TEXT("sha1") || Name == TEXT("sha-1");
+		case EHttpHashAlgorithm::SHA256:	return Name == TEXT("sha-256") || Name == TEXT("sha256");
+		case EHttpHashAlgorithm::XxHash64:	return Name == TEXT("xxh64") || Name == TEXT("xxhash64");
+		case EHttpHashAlgorithm::CRC32:		return Name == TEXT("crc32") || Name == TEXT("crc-32");
+		default:							return false;
+		}
+	}
+
+	bool DecodeDigest(FString Value, const int32 DigestSize, TArray<uint8>& OutDigest)
+	{
+		Value.TrimStartAndEndInline();
+		Value.TrimCharInline(TEXT('"'), nullptr);
+		Value.TrimCharInline(TEXT(':'), nullptr);
+
+		if (Value.Len() == DigestSize * 2 && IsHexString(Value))
+		{
+			OutDigest.SetNumUninitialized(DigestSize);
+			HexToBytes(Value, OutDigest.GetData());
+			return true;
+		}
+
+		return FBase64::Decode(Value, OutDigest) && OutDigest.Num() == DigestSize;
+	}
+}
+
+FHttpSha256::FHttpSha256()
+	: State{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 }
+	, TotalLength(0)
+	, BufferLength(0)
+{
+}
+
+void FHttpSha256::Transform(const uint8* const Block)
+{
+	uint32 W[64];
+
+	for (int32 Index = 0; Index < 16; ++Index)
+	{
+		W[Index] = (uint32(Block[Index * 4]) << 24) | (uint32(Block[Index * 4 + 1]) << 16) | (uint32(Block[Index * 4 + 2]) << 8) | uint32(Block[Index * 4 + 3]);
+	}
+
+	for (int32 Index = 16; Index < 64; ++Index)
+	{
+		const uint32 S0 = RotateRight(W[Index - 15], 7) ^ RotateRight(W[Index - 15], 18) ^ (W[Index - 15] >> 3);
+		const uint32 S1 = RotateRight(W[Index - 2], 17) ^ RotateRight(W[Index - 2], 19) ^ (W[Index - 2] >> 10);
+		W[Index] = W[Index - 16] + S0 + W[Index - 7] + S1;
+	}
+
+	uint32 A = State[0], B = State[1], C = State[2], D = State[3];
+	uint32 E = State[4], F = State[5], G = State[6], H = State[7];
+
+	for (int32 Index = 0; Index < 64; ++Index)
+	{
+		const uint32 S1    = RotateRight(E, 6) ^ RotateRight(E, 11) ^ RotateRight(E, 25);
+		const uint32 Ch    = (E & F) ^ (~E & G);
+		const uint32 Temp1 = H + S1 + Ch + Sha256RoundConstants[Index] + W[Index];
+		const uint32 S0    = RotateRight(A, 2) ^ RotateRight(A, 13) ^ RotateRight(A, 22);
+		const uint32 Maj   = (A & B) ^ (A & C) ^ (B & C);
+		const uint32 Temp2 = S0 + Maj;
+
+		H = G;
+		G = F;
+		F = E;
+		E = D + Temp1;
+		D = C;
+		C = B;
+		B = A;
+		A = Temp1 + Temp2;
+	}
+
+	State[0] += A; State[1] += B; State[2] += C; State[3] += D;
+	State[4] += E; State[5] += F; State[6] += G; State[7] += H;
+}
+
+void FHttpSha256::Update(const uint8* Data, int64 Length)
+{
+	TotalLength += Length;
+
+	if (BufferLength > 0)
+	{
+		const int32 Copied = (int32)FMath::Min<int64>(64 - BufferLength, Length);
+		FMemory::Memcpy(Buffer + BufferLength, Data, Copied);
+
+		BufferLength += Copied;
+		Data		 += Copied;
+		Length		 -= Copied;
+
+		if (BufferLength < 64)
+		{
+			return;
+		}
+
+		Transform(Buffer);
+		BufferLength = 0;
+	}
+
+	for (; Length >= 64; Data += 64, Length -= 64)
+	{
+		Transform(Data);
+	}
+
+	if (Length > 0)
+	{
+		FMemory::Memcpy(Buffer, Data, Length);
+		BufferLength = (int32)Length;
+	}
+}
+
+void FHttpSha256::Final(uint8 OutDigest[DigestSize])
+{
+	const uint64 BitLength = TotalLength * 8;
+
+	Buffer[BufferLength++] = 0x80;
+
+	if (BufferLength > 56)
+	{
+		FMemory::Memzero(Buffer + BufferLength, 64 - BufferLength);
+		Transform(Buffer);
+		BufferLength = 0;
+	}
+
+	FMemory::Memzero(Buffer + BufferLength, 56 - BufferLength);
+	WriteBigEndian(BitLength, 8, Buffer + 56);
+	Transform(Buffer);
+
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		WriteBigEndian(State[Index], 4, OutDigest + Index * 4);
+	}
+}
+
+FHttpStreamingHash::FHttpStreamingHash(const EHttpHashAlgorithm InAlgorithm)
+	: Algorithm(InAlgorithm)
+	, Crc32(0)
+{
+}
+
+void FHttpStreamingHash::Update(const uint8* const Data, const int64 Length)
+{
+	switch (Algorithm)
+	{
+	case EHttpHashAlgorithm::SHA1:
+		Sha1.Update(Data, Length);
+		break;
+
+	case EHttpHashAlgorithm::SHA256:
+		Sha256.Update(Data, Length);
+		break;
+
+	case EHttpHashAlgorithm::XxHash64:
+		XxHash64.Update(Data, Length);
+		break;
+
+	case EHttpHashAlgorithm::CRC32:
+		// MemCrc32 takes 32-bit lengths.
+		for (int64 Offset = 0; Offset < Length; Offset += MAX_int32)
+		{
+			Crc32 = FCrc::MemCrc32(Data + Offset, (int32)FMath::Min<int64>(Length - Offset, MAX_int32), Crc32);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+TArray<uint8> FHttpStreamingHash::Finalize()
+{
+	TArray<uint8> Digest;
+	Digest.SetNumZeroed(GetDigestSize(Algorithm));
+
+	switch (Algorithm)
+	{
+	case EHttpHashAlgorithm::SHA1:
+		Sha1.Final();
+		Sha1.GetHash(Digest.GetData());
+		break;
+
+	case EHttpHashAlgorithm::SHA256:
+		Sha256.Final(Digest.GetData());
+		break;
+
+	case EHttpHashAlgorithm::XxHash64:
+		WriteBigEndian(XxHash64.Finalize().Hash, 8, Digest.GetData());
+		break;
+
+	case EHttpHashAlgorithm::CRC32:
+		WriteBigEndian(Crc32, 4, Digest.GetData());
+		break;
+
+	default:
+		break;
+	}
+
+	return Digest;
+}
+
+int32 FHttpStreamingHash::GetDigestSize(const EHttpHashAlgorithm Algorithm)
+{
+	switch (Algorithm)
+	{
+	case EHttpHashAlgorithm::SHA1:		return 20;
+	case EHttpHashAlgorithm::SHA256:	return FHttpSha256::DigestSize;
+	case EHttpHashAlgorithm::XxHash64:	return 8;
+	case EHttpHashAlgorithm::CRC32:		return 4;
+	default:							return 0;
+	}
+}
+
+bool FHttpStreamingHash::ParseDigest(const FString& Value, const EHttpHashAlgorithm Algorithm, TArray<uint8>& OutDigest)
+{
+	const int32 DigestSize = GetDigestSize(Algorithm);
+	if (DigestSize == 0)
+	{
+		return false;
+	}
+
+	// Digest headers: "sha-256=<Base64>, md5=<Base64>" or "sha-256=:<Base64>:".
+	TArray<FString> Entries;
+	Value.ParseIntoArray(Entries, TEXT(","));
+
+	for (const FString& Entry : Entries)
+	{
+		FString Name, Encoded;
+		if (Entry.Split(TEXT("="), &Name, &Encoded) && IsDigestName(Name.TrimStartAndEnd().ToLower(), Algorithm))
+		{
+			return DecodeDigest(Encoded, DigestSize, OutDigest);
+		}
+	}
+
+	return DecodeDigest(Value, DigestSize, OutDigest);
+}
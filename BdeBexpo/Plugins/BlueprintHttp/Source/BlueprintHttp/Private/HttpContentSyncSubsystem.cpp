@@ -0,0 +1,541 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpContentSyncSubsystem.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "HttpUrl.h"
+#include "BlueprintHttpNodes.h"
+#include "Http.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	/* Suffix of the files being downloaded. */
+	const TCHAR* const PartialFileSuffix = TEXT(".part");
+
+	/* Returns the hash of a manifest's "hashAlgorithm" field, or None if it isn't supported. */
+	EHttpHashAlgorithm ParseHashAlgorithm(const FString& Name)
+	{
+		if (Name == TEXT("sha1"))	{ return EHttpHashAlgorithm::SHA1;     }
+		if (Name == TEXT("sha256"))	{ return EHttpHashAlgorithm::SHA256;   }
+		if (Name == TEXT("xxh64"))	{ return EHttpHashAlgorithm::XxHash64; }
+		if (Name == TEXT("crc32"))	{ return EHttpHashAlgorithm::CRC32;    }
+		return EHttpHashAlgorithm::None;
+	}
+
+	/* Manifest paths must stay inside the content directory. */
+	bool IsSafeRelativePath(const FString& Path)
+	{
+		return !Path.IsEmpty() && FPaths::IsRelative(Path) && !Path.Contains(TEXT("..")) && !Path.Contains(TEXT(":"));
+	}
+}
+
+void UHttpContentSyncDownload::OnFileDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	BytesReceived = TotalBytesReceived;
+	Owner->OnDownloadFinished(this, true);
+}
+
+void UHttpContentSyncDownload::OnFileDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	BytesReceived = TotalBytesReceived;
+	Owner->OnDownloadFinished(this, false);
+}
+
+void UHttpContentSyncDownload::OnDownloadProgress(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	BytesReceived = TotalBytesReceived;
+	Owner->OnDownloadProgress(this);
+}
+
+UHttpContentSyncSubsystem::UHttpContentSyncSubsystem()
+	: Super()
+	, ManifestRequest(nullptr)
+	, NextPendingFile(0)
+	, FilesUpdated(0)
+	, BytesToDownload(0)
+	, BytesDownloaded(0)
+	, MaxConcurrentDownloads(4)
+	, bDeleteRemovedFiles(true)
+	, bSyncing(false)
+	, bAnyFailure(false)
+	, HashAlgorithm(EHttpHashAlgorithm::SHA1)
+{
+}
+
+void UHttpContentSyncSubsystem::Deinitialize()
+{
+	CancelSync();
+
+	Super::Deinitialize();
+}
+
+bool UHttpContentSyncSubsystem::StartSync(const FString& InManifestUrl, const FString& ContentDirectory, const int32 InMaxConcurrentDownloads, const bool bInDeleteRemovedFiles)
+{
+	if (bSyncing)
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Content sync: A sync is already running."));
+		return false;
+	}
+
+	bSyncing			   = true;
+	bAnyFailure			   = false;
+	ManifestUrl			   = InManifestUrl;
+	ContentRoot			   = FPaths::ProjectPersistentDownloadDir() / ContentDirectory;
+	MaxConcurrentDownloads = FMath::Max(InMaxConcurrentDownloads, 1);
+	bDeleteRemovedFiles	   = bInDeleteRemovedFiles;
+	FilesUpdated		   = 0;
+	BytesToDownload		   = 0;
+	BytesDownloaded		   = 0;
+	NextPendingFile		   = 0;
+
+	ManifestFiles.Reset();
+	PendingFiles .Reset();
+
+	LoadIndex();
+
+	return RequestManifest();
+}
+
+bool UHttpContentSyncSubsystem::RequestManifest()
+{
+	ManifestRequest = UHttpRequest::CreateRequest();
+	ManifestRequest->SetVerb(EHttpVerb::GET);
+	ManifestRequest->SetURL(ManifestUrl);
+	ManifestRequest->SetPriority(EHttpRequestPriority::Background);
+
+	if (!ManifestETag.IsEmpty())
+	{
+		ManifestRequest->SetHeader(TEXT("If-None-Match"), ManifestETag);
+	}
+
+	ManifestRequest->OnRequestComplete.AddDynamic(this, &UHttpContentSyncSubsystem::OnManifestReceived);
+
+	if (!ManifestRequest->ProcessRequest())
+	{
+		UE_LOG(LogHttp, Error, TEXT("Content sync: Failed to request the manifest \"%s\"."), *ManifestUrl);
+		Finish(false);
+		return false;
+	}
+
+	return true;
+}
+
+void UHttpContentSyncSubsystem::CancelSync()
+{
+	if (!bSyncing)
+	{
+		return;
+	}
+
+	if (ManifestRequest)
+	{
+		ManifestRequest->Abandon();
+		ManifestRequest = nullptr;
+	}
+
+	for (UHttpContentSyncDownload* const Download : ActiveDownloads)
+	{
+		if (UHttpRequest* const Request = Download->Proxy->GetHttpRequest())
+		{
+			Request->Abandon();
+		}
+
+		Download->Proxy->SetReadyToDestroy();
+		IFileManager::Get().Delete(*(GetContentPath(ManifestFiles[Download->FileIndex].Path) + PartialFileSuffix), false, false, true);
+	}
+
+	ActiveDownloads.Reset();
+
+	// The files verified so far are kept, the manifest will be fetched again.
+	ManifestETag.Reset();
+	SaveIndex();
+
+	bSyncing = false;
+}
+
+bool UHttpContentSyncSubsystem::IsSyncing() const
+{
+	return bSyncing;
+}
+
+FString UHttpContentSyncSubsystem::GetContentPath(const FString& RelativePath) const
+{
+	return ContentRoot / RelativePath;
+}
+
+void UHttpContentSyncSubsystem::OnManifestReceived(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	ManifestRequest = nullptr;
+
+	const int32 ResponseCode = Response ? Response->GetResponseCode() : 0;
+
+	if (!bConnectedSuccessfully || (ResponseCode >= 400 || ResponseCode <= 0))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Content sync: Failed to download the manifest \"%s\" (%d)."), *ManifestUrl, ResponseCode);
+		Finish(false);
+		return;
+	}
+
+	if (ResponseCode == 304)
+	{
+		if (ManifestETag.IsEmpty())
+		{
+			UE_LOG(LogHttp, Error, TEXT("Content sync: Unexpected 304 for the manifest \"%s\"."), *ManifestUrl);
+			Finish(false);
+			return;
+		}
+
+		// The manifest didn't change but the files might have, they are checked against the index
+		// and the full manifest is requested again if any is gone.
+		if (!VerifyIndexedFiles())
+		{
+			UE_LOG(LogHttp, Warning, TEXT("Content sync: Local files don't match the index, requesting the full manifest \"%s\"."), *ManifestUrl);
+
+			ManifestETag.Reset();
+			SaveIndex();
+
+			RequestManifest();
+			return;
+		}
+
+		UE_LOG(LogHttp, Log, TEXT("Content sync: \"%s\" is up to date."), *ManifestUrl);
+		Finish(true);
+		return;
+	}
+
+	if (!ParseManifest(Response->GetContentAsString()))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Content sync: The manifest \"%s\" is invalid."), *ManifestUrl);
+		Finish(false);
+		return;
+	}
+
+	ManifestETag = Response->GetHeader(TEXT("ETag"));
+
+	for (int32 FileIndex = 0; FileIndex < ManifestFiles.Num(); ++FileIndex)
+	{
+		const FContentFile& File = ManifestFiles[FileIndex];
+		const FContentFile* const Synced = Index.Find(File.Path);
+
+		// Files are trusted once verified, only their size is checked again.
+		const bool bUpToDate = Synced
+			&& Synced->Hash.Equals(File.Hash, ESearchCase::IgnoreCase)
+			&& IFileManager::Get().FileSize(*GetContentPath(File.Path)) == File.Size;
+
+		if (!bUpToDate)
+		{
+			PendingFiles.Add(FileIndex);
+			BytesToDownload += File.Size;
+		}
+	}
+
+	if (bDeleteRemovedFiles)
+	{
+		TSet<FString> ManifestPaths;
+		for (const FContentFile& File : ManifestFiles)
+		{
+			ManifestPaths.Add(File.Path);
+		}
+
+		for (auto It = Index.CreateIterator(); It; ++It)
+		{
+			if (!ManifestPaths.Contains(It.Key()))
+			{
+				IFileManager::Get().Delete(*GetContentPath(It.Key()), false, false, true);
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	UE_LOG(LogHttp, Log, TEXT("Content sync: %d of %d files to update (%lld bytes)."), PendingFiles.Num(), ManifestFiles.Num(), BytesToDownload);
+
+	if (PendingFiles.Num() == 0)
+	{
+		Finish(true);
+		return;
+	}
+
+	PumpDownloads();
+}
+
+bool UHttpContentSyncSubsystem::ParseManifest(const FString& Json)
+{
+	TSharedPtr<FJsonObject> Manifest;
+
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Manifest) || !Manifest)
+	{
+		return false;
+	}
+
+	const FString AlgorithmName = Manifest->HasField(TEXT("hashAlgorithm")) ? Manifest->GetStringField(TEXT("hashAlgorithm")).ToLower() : TEXT("sha1");
+
+	HashAlgorithm = ParseHashAlgorithm(AlgorithmName);
+
+	if (HashAlgorithm == EHttpHashAlgorithm::None)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Content sync: Unsupported hash algorithm \"%s\"."), *AlgorithmName);
+		return false;
+	}
+
+	FString BaseUrl = Manifest->HasField(TEXT("baseUrl")) ? Manifest->GetStringField(TEXT("baseUrl")) : ManifestUrl.Left(ManifestUrl.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromEnd) + 1);
+
+	if (!BaseUrl.EndsWith(TEXT("/")))
+	{
+		BaseUrl += TEXT("/");
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+
+	if (!Manifest->TryGetArrayField(TEXT("files"), Files))
+	{
+		return false;
+	}
+
+	// Reused for the URL of each file, the paths are encoded segment by segment.
+	FHttpUrlBuilder FileUrl(BaseUrl);
+
+	for (const TSharedPtr<FJsonValue>& Value : *Files)
+	{
+		const TSharedPtr<FJsonObject>* FileObject = nullptr;
+
+		if (!Value->TryGetObject(FileObject))
+		{
+			return false;
+		}
+
+		FContentFile File;
+
+		if (!(*FileObject)->TryGetStringField(TEXT("path"), File.Path)
+			|| !(*FileObject)->TryGetStringField(TEXT("hash"), File.Hash)
+			|| !(*FileObject)->TryGetNumberField(TEXT("size"), File.Size))
+		{
+			return false;
+		}
+
+		if (!IsSafeRelativePath(File.Path))
+		{
+			UE_LOG(LogHttp, Error, TEXT("Content sync: \"%s\" isn't a valid content path."), *File.Path);
+			return false;
+		}
+
+		if (!(*FileObject)->TryGetStringField(TEXT("url"), File.Url))
+		{
+			File.Url = FileUrl.Rewind().AddPath(File.Path).Build();
+		}
+
+		ManifestFiles.Add(MoveTemp(File));
+	}
+
+	return true;
+}
+
+void UHttpContentSyncSubsystem::PumpDownloads()
+{
+	while (ActiveDownloads.Num() < MaxConcurrentDownloads && NextPendingFile < PendingFiles.Num())
+	{
+		const int32 FileIndex = PendingFiles[NextPendingFile++];
+		const FContentFile& File = ManifestFiles[FileIndex];
+
+		FHttpIntegrityCheck IntegrityCheck;
+		IntegrityCheck.Algorithm	  = HashAlgorithm;
+		IntegrityCheck.ExpectedDigest = File.Hash;
+
+		UHttpContentSyncDownload* const Download = NewObject<UHttpContentSyncDownload>(this);
+
+		Download->Owner			= this;
+		Download->FileIndex		= FileIndex;
+		Download->BytesReceived = 0;
+		Download->Proxy			= UHttpDownloadFileProxy::HttpDownloadFile(File.Url, {}, EHttpVerb::GET, EHttpMimeType::bin, FString(), {},
+			GetContentPath(File.Path) + PartialFileSuffix, FHttpRequestTimeouts(), IntegrityCheck, nullptr);
+
+		Download->Proxy->GetHttpRequest()->SetPriority(EHttpRequestPriority::Background);
+
+		Download->Proxy->OnFileDownloaded	.AddDynamic(Download, &UHttpContentSyncDownload::OnFileDownloaded);
+		Download->Proxy->OnFileDownloadError.AddDynamic(Download, &UHttpContentSyncDownload::OnFileDownloadError);
+		Download->Proxy->OnDownloadProgress	.AddDynamic(Download, &UHttpContentSyncDownload::OnDownloadProgress);
+
+		ActiveDownloads.Add(Download);
+
+		Download->Proxy->Activate();
+	}
+
+	if (ActiveDownloads.Num() == 0 && NextPendingFile >= PendingFiles.Num())
+	{
+		Finish(!bAnyFailure);
+	}
+}
+
+void UHttpContentSyncSubsystem::OnDownloadProgress(UHttpContentSyncDownload* const Download)
+{
+	int64 InFlightBytes = 0;
+
+	for (const UHttpContentSyncDownload* const Active : ActiveDownloads)
+	{
+		InFlightBytes += Active->BytesReceived;
+	}
+
+	OnSyncProgress.Broadcast(FilesUpdated, PendingFiles.Num(), BytesDownloaded + InFlightBytes, BytesToDownload);
+}
+
+void UHttpContentSyncSubsystem::OnDownloadFinished(UHttpContentSyncDownload* const Download, const bool bSucceeded)
+{
+	if (ActiveDownloads.Remove(Download) == 0)
+	{
+		return;
+	}
+
+	const int32 FileIndex = Download->FileIndex;
+	const FContentFile& File = ManifestFiles[FileIndex];
+
+	BytesDownloaded += Download->BytesReceived;
+
+	const FString Destination = GetContentPath(File.Path);
+	const FString PartialFile = Destination + PartialFileSuffix;
+
+	// Files that don't match their hash fail their download and are never written.
+	if (!bSucceeded)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Content sync: Failed to download \"%s\"."), *File.Url);
+		IFileManager::Get().Delete(*PartialFile, false, false, true);
+		bAnyFailure = true;
+	}
+	// Replaces the previous version in one move so readers never see a partial file.
+	else if (!IFileManager::Get().Move(*Destination, *PartialFile, true, true))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Content sync: Failed to move \"%s\" in place."), *FPaths::ConvertRelativePathToFull(Destination));
+		IFileManager::Get().Delete(*PartialFile, false, false, true);
+		bAnyFailure = true;
+	}
+	else
+	{
+		Index.Add(File.Path, File);
+
+		++FilesUpdated;
+
+		OnFileUpdated .Broadcast(File.Path);
+		OnSyncProgress.Broadcast(FilesUpdated, PendingFiles.Num(), BytesDownloaded, BytesToDownload);
+	}
+
+	PumpDownloads();
+}
+
+void UHttpContentSyncSubsystem::Finish(const bool bSucceeded)
+{
+	if (!bSyncing)
+	{
+		return;
+	}
+
+	bSyncing = false;
+
+	// A failed sync must fetch the manifest again next time.
+	if (!bSucceeded)
+	{
+		ManifestETag.Reset();
+	}
+
+	SaveIndex();
+
+	UE_LOG(LogHttp, Log, TEXT("Content sync: %s, %d files updated, %lld bytes downloaded."), bSucceeded ? TEXT("Succeeded") : TEXT("Failed"), FilesUpdated, BytesDownloaded);
+
+	OnSyncCompleted.Broadcast(bSucceeded, FilesUpdated, BytesDownloaded);
+}
+
+bool UHttpContentSyncSubsystem::VerifyIndexedFiles()
+{
+	bool bAllPresent = true;
+
+	for (auto It = Index.CreateIterator(); It; ++It)
+	{
+		const int64 Size = IFileManager::Get().FileSize(*GetContentPath(It.Key()));
+
+		if (Size != It.Value().Size)
+		{
+			UE_LOG(LogHttp, Log, TEXT("Content sync: \"%s\" is missing or modified (%lld bytes, expected %lld)."), *It.Key(), Size, It.Value().Size);
+
+			It.RemoveCurrent();
+			bAllPresent = false;
+		}
+	}
+
+	return bAllPresent;
+}
+
+FString UHttpContentSyncSubsystem::GetIndexPath() const
+{
+	return ContentRoot / TEXT("ContentIndex.json");
+}
+
+void UHttpContentSyncSubsystem::LoadIndex()
+{
+	Index.Reset();
+	ManifestETag.Reset();
+
+	FString Json;
+	TSharedPtr<FJsonObject> IndexObject;
+
+	if (!FFileHelper::LoadFileToString(Json, *GetIndexPath()) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), IndexObject) || !IndexObject)
+	{
+		return;
+	}
+
+	IndexObject->TryGetStringField(TEXT("etag"), ManifestETag);
+
+	const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+
+	if (!IndexObject->TryGetArrayField(TEXT("files"), Files))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *Files)
+	{
+		const TSharedPtr<FJsonObject>* FileObject = nullptr;
+
+		FContentFile File;
+
+		if (Value->TryGetObject(FileObject)
+			&& (*FileObject)->TryGetStringField(TEXT("path"), File.Path)
+			&& (*FileObject)->TryGetStringField(TEXT("hash"), File.Hash)
+			&& (*FileObject)->TryGetNumberField(TEXT("size"), File.Size))
+		{
+			Index.Add(File.Path, MoveTemp(File));
+		}
+	}
+}
+
+void UHttpContentSyncSubsystem::SaveIndex() const
+{
+	TArray<TSharedPtr<FJsonValue>> Files;
+
+	for (const TPair<FString, FContentFile>& Entry : Index)
+	{
+		const TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+
+		FileObject->SetStringField(TEXT("path"), Entry.Value.Path);
+		FileObject->SetStringField(TEXT("hash"), Entry.Value.Hash);
+		FileObject->SetNumberField(TEXT("size"), static_cast<double>(Entry.Value.Size));
+
+		Files.Add(MakeShared<FJsonValueObject>(FileObject));
+	}
+
+	const TSharedRef<FJsonObject> IndexObject = MakeShared<FJsonObject>();
+
+	IndexObject->SetStringField(TEXT("etag"), ManifestETag);
+	IndexObject->SetArrayField(TEXT("files"), Files);
+
+	FString Json;
+	FJsonSerializer::Serialize(IndexObject, TJsonWriterFactory<>::Create(&Json));
+
+	if (!FFileHelper::SaveStringToFile(Json, *GetIndexPath()))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Content sync: Failed to save the index \"%s\"."), *FPaths::ConvertRelativePathToFull(GetIndexPath()));
+	}
+}
@@ -0,0 +1,42 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpDeadlineBudget.h"
+
+UHttpDeadlineBudget::UHttpDeadlineBudget()
+	: Super()
+	, Duration(0.f)
+	, Deadline(0.)
+{
+}
+
+UHttpDeadlineBudget* UHttpDeadlineBudget::CreateDeadlineBudget(const float Seconds)
+{
+	UHttpDeadlineBudget* const Budget = NewObject<UHttpDeadlineBudget>();
+
+	Budget->Duration = FMath::Max(Seconds, 0.f);
+
+	return Budget;
+}
+
+float UHttpDeadlineBudget::GetRemainingTime() const
+{
+	if (Deadline == 0.)
+	{
+		return Duration;
+	}
+
+	return FMath::Max(static_cast<float>(Deadline - FPlatformTime::Seconds()), 0.f);
+}
+
+bool UHttpDeadlineBudget::IsExpired() const
+{
+	return Deadline != 0. && FPlatformTime::Seconds() >= Deadline;
+}
+
+void UHttpDeadlineBudget::Start()
+{
+	if (Deadline == 0.)
+	{
+		Deadline = FPlatformTime::Seconds() + Duration;
+	}
+}
@@ -0,0 +1,988 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpDeltaPatch.h"
+#include "HttpRequest.h"
+#include "BlueprintHttpNodes.h"
+#include "Http.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace
+{
+	/* Size of the blocks streamed through the patch. */
+	constexpr int64 PatchChunkSize = 64 * 1024;
+
+	constexpr ANSICHAR PatchMagic[] = "BHTTPDIFF1";
+	constexpr int32 PatchMagicLength = 10;
+
+	/* Suffixes of the files next to the updated file. */
+	const TCHAR* const PatchFileSuffix	 = TEXT(".patch");
+	const TCHAR* const PartialFileSuffix = TEXT(".part");
+
+	/* Reads an offset of the patch, stored as a sign and a magnitude in little-endian order. */
+	int64 ReadOffset(const uint8* const Buffer)
+	{
+		int64 Value = Buffer[7] & 0x7F;
+
+		for (int32 Index = 6; Index >= 0; --Index)
+		{
+			Value = (Value << 8) | Buffer[Index];
+		}
+
+		return (Buffer[7] & 0x80) ? -Value : Value;
+	}
+
+	void WriteOffset(const int64 Value, uint8* const Buffer)
+	{
+		uint64 Magnitude = Value < 0 ? -Value : Value;
+
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Buffer[Index] = static_cast<uint8>(Magnitude & 0xFF);
+			Magnitude >>= 8;
+		}
+
+		if (Value < 0)
+		{
+			Buffer[7] |= 0x80;
+		}
+	}
+
+	/* Sorts the suffixes of Old in I, Larsson and Sadakane's qsufsort as used by bsdiff. V is the rank of each suffix. */
+	class FSuffixSorter
+	{
+	public:
+		FSuffixSorter(const uint8* const Old, const int64 OldSize, TArray64<int64>& InI, TArray64<int64>& InV)
+			: I(InI)
+			, V(InV)
+		{
+			I.SetNumUninitialized(OldSize + 1);
+			V.SetNumUninitialized(OldSize + 1);
+
+			int64 Buckets[256] = {};
+
+			for (int64 Index = 0; Index < OldSize; ++Index)
+			{
+				++Buckets[Old[Index]];
+			}
+			for (int32 Index = 1; Index < 256; ++Index)
+			{
+				Buckets[Index] += Buckets[Index - 1];
+			}
+			for (int32 Index = 255; Index > 0; --Index)
+			{
+				Buckets[Index] = Buckets[Index - 1];
+			}
+			Buckets[0] = 0;
+
+			for (int64 Index = 0; Index < OldSize; ++Index)
+			{
+				I[++Buckets[Old[Index]]] = Index;
+			}
+			I[0] = OldSize;
+
+			for (int64 Index = 0; Index < OldSize; ++Index)
+			{
+				V[Index] = Buckets[Old[Index]];
+			}
+			V[OldSize] = 0;
+
+			for (int32 Index = 1; Index < 256; ++Index)
+			{
+				if (Buckets[Index] == Buckets[Index - 1] + 1)
+				{
+					I[Buckets[Index]] = -1;
+				}
+			}
+			I[0] = -1;
+
+			for (int64 Depth = 1; I[0] != -(OldSize + 1); Depth += Depth)
+			{
+				int64 Length = 0;
+				int64 Index = 0;
+
+				while (Index < OldSize + 1)
+				{
+					if (I[Index] < 0)
+					{
+						Length -= I[Index];
+						Index  -= I[Index];
+					}
+					else
+					{
+						if (Length)
+						{
+							I[Index - Length] = -Length;
+						}
+
+						Length = V[I[Index]] + 1 - Index;
+						Split(Index, Length, Depth);
+						Index += Length;
+						Length = 0;
+					}
+				}
+
+				if (Length)
+				{
+					I[Index - Length] = -Length;
+				}
+			}
+
+			for (int64 Index = 0; Index < OldSize + 1; ++Index)
+			{
+				I[V[Index]] = Index;
+			}
+		}
+
+	private:
+		void Split(const int64 Start, const int64 Length, const int64 Depth)
+		{
+			if (Length < 16)
+			{
+				for (int64 K = Start, J = 0; K < Start + Length; K += J)
+				{
+					J = 1;
+					int64 X = V[I[K] + Depth];
+
+					for (int64 Index = 1; K + Index < Start + Length; ++Index)
+					{
+						if (V[I[K + Index] + Depth] < X)
+						{
+							X = V[I[K + Index] + Depth];
+							J = 0;
+						}
+						if (V[I[K + Index] + Depth] == X)
+						{
+							Swap(I[K + J], I[K + Index]);
+							++J;
+						}
+					}
+
+					for (int64 Index = 0; Index < J; ++Index)
+					{
+						V[I[K + Index]] = K + J - 1;
+					}
+					if (J == 1)
+					{
+						I[K] = -1;
+					}
+				}
+				return;
+			}
+
+			const int64 X = V[I[Start + Length / 2] + Depth];
+
+			int64 Lower = 0;
+			int64 Equal = 0;
+
+			for (int64 Index = Start; Index < Start + Length; ++Index)
+			{
+				Lower += V[I[Index] + Depth] <  X ? 1 : 0;
+				Equal += V[I[Index] + Depth] == X ? 1 : 0;
+			}
+
+			const int64 EqualStart = Start + Lower;
+			const int64 GreaterStart = EqualStart + Equal;
+
+			int64 Index = Start;
+			int64 J = 0;
+			int64 K = 0;
+
+			while (Index < EqualStart)
+			{
+				if (V[I[Index] + Depth] < X)
+				{
+					++Index;
+				}
+				else if (V[I[Index] + Depth] == X)
+				{
+					Swap(I[Index], I[EqualStart + J++]);
+				}
+				else
+				{
+					Swap(I[Index], I[GreaterStart + K++]);
+				}
+			}
+
+			while (EqualStart + J < GreaterStart)
+			{
+				if (V[I[EqualStart + J] + Depth] == X)
+				{
+					++J;
+				}
+				else
+				{
+					Swap(I[EqualStart + J], I[GreaterStart + K++]);
+				}
+			}
+
+			if (EqualStart > Start)
+			{
+				Split(Start, EqualStart - Start, Depth);
+			}
+
+			for (int64 Offset = 0; Offset < GreaterStart - EqualStart; ++Offset)
+			{
+				V[I[EqualStart + Offset]] = GreaterStart - 1;
+			}
+			if (EqualStart == GreaterStart - 1)
+			{
+				I[EqualStart] = -1;
+			}
+
+			if (Start + Length > GreaterStart)
+			{
+				Split(GreaterStart, Start + Length - GreaterStart, Depth);
+			}
+		}
+
+		TArray64<int64>& I;
+		TArray64<int64>& V;
+	};
+
+	int64 MatchLength(const uint8* const Old, const int64 OldSize, const uint8* const New, const int64 NewSize)
+	{
+		int64 Index = 0;
+		while (Index < OldSize && Index < NewSize && Old[Index] == New[Index])
+		{
+			++Index;
+		}
+		return Index;
+	}
+
+	/* Finds the longest match of New in Old with the sorted suffixes. */
+	int64 SearchMatch(const TArray64<int64>& I, const uint8* const Old, const int64 OldSize, const uint8* const New, const int64 NewSize, int64 Start, int64 End, int64& OutPosition)
+	{
+		while (End - Start >= 2)
+		{
+			const int64 Middle = Start + (End - Start) / 2;
+
+			if (FMemory::Memcmp(Old + I[Middle], New, FMath::Min(OldSize - I[Middle], NewSize)) < 0)
+			{
+				Start = Middle;
+			}
+			else
+			{
+				End = Middle;
+			}
+		}
+
+		const int64 StartLength = MatchLength(Old + I[Start], OldSize - I[Start], New, NewSize);
+		const int64 EndLength	= MatchLength(Old + I[End],	  OldSize - I[End],	  New, NewSize);
+
+		OutPosition = StartLength > EndLength ? I[Start] : I[End];
+
+		return FMath::Max(StartLength, EndLength);
+	}
+
+	/* Deflates the blocks of a patch as they are written. */
+	class FPatchBlockWriter
+	{
+	public:
+		explicit FPatchBlockWriter(FArchive& InTarget)
+			: Target(InTarget)
+		{
+			FMemory::Memzero(Stream);
+			Output.SetNumUninitialized(PatchChunkSize);
+
+			bInitialized = deflateInit(&Stream, Z_BEST_COMPRESSION) == Z_OK;
+		}
+
+		~FPatchBlockWriter()
+		{
+			if (bInitialized)
+			{
+				deflateEnd(&Stream);
+			}
+		}
+
+		bool Write(const uint8* Data, int64 Length)
+		{
+			while (bInitialized && Length > 0)
+			{
+				const uInt Consumed = static_cast<uInt>(FMath::Min<int64>(Length, PatchChunkSize));
+
+				Stream.next_in	= const_cast<uint8*>(Data);
+				Stream.avail_in = Consumed;
+
+				if (!Deflate(Z_NO_FLUSH))
+				{
+					return false;
+				}
+
+				Data   += Consumed;
+				Length -= Consumed;
+			}
+
+			return bInitialized;
+		}
+
+		bool Finish()
+		{
+			return bInitialized && Deflate(Z_FINISH) && !Target.IsError();
+		}
+
+	private:
+		bool Deflate(const int32 Flush)
+		{
+			int32 Result;
+
+			do
+			{
+				Stream.next_out	 = Output.GetData();
+				Stream.avail_out = PatchChunkSize;
+
+				Result = deflate(&Stream, Flush);
+
+				if (Result == Z_STREAM_ERROR)
+				{
+					return false;
+				}
+
+				Target.Serialize(Output.GetData(), PatchChunkSize - Stream.avail_out);
+			}
+			while (Stream.avail_out == 0 || (Flush == Z_FINISH && Result != Z_STREAM_END));
+
+			return true;
+		}
+
+		FArchive& Target;
+		z_stream Stream;
+		TArray<uint8> Output;
+		bool bInitialized;
+	};
+
+	/* Inflates the blocks of a patch as they are read. */
+	class FPatchBlockReader
+	{
+	public:
+		explicit FPatchBlockReader(FArchive& InSource)
+			: Source(InSource)
+		{
+			FMemory::Memzero(Stream);
+			Input.SetNumUninitialized(PatchChunkSize);
+
+			// Detects both the zlib and the gzip headers.
+			bInitialized = inflateInit2(&Stream, 15 + 32) == Z_OK;
+		}
+
+		~FPatchBlockReader()
+		{
+			if (bInitialized)
+			{
+				inflateEnd(&Stream);
+			}
+		}
+
+		bool Read(uint8* Out, int64 Length)
+		{
+			while (bInitialized && Length > 0)
+			{
+				if (Stream.avail_in == 0)
+				{
+					const int64 Remaining = FMath::Min(Source.TotalSize() - Source.Tell(), PatchChunkSize);
+
+					if (Remaining <= 0)
+					{
+						return false;
+					}
+
+					Source.Serialize(Input.GetData(), Remaining);
+
+					Stream.next_in	= Input.GetData();
+					Stream.avail_in = static_cast<uInt>(Remaining);
+				}
+
+				const uInt Requested = static_cast<uInt>(FMath::Min<int64>(Length, PatchChunkSize));
+
+				Stream.next_out	 = Out;
+				Stream.avail_out = Requested;
+
+				const int32 Result = inflate(&Stream, Z_NO_FLUSH);
+				const uInt Produced = Requested - Stream.avail_out;
+
+				Out	   += Produced;
+				Length -= Produced;
+
+				if (Result == Z_STREAM_END)
+				{
+					return Length == 0;
+				}
+
+				if (Result != Z_OK && Result != Z_BUF_ERROR)
+				{
+					return false;
+				}
+			}
+
+			return bInitialized && !Source.IsError();
+		}
+
+	private:
+		FArchive& Source;
+		z_stream Stream;
+		TArray<uint8> Input;
+		bool bInitialized;
+	};
+}
+
+bool FHttpDeltaPatch::Apply(const FString& OldFilename, const FString& PatchFilename, const FString& NewFilename, FHttpStreamingHash* const Hash, FString& OutError)
+{
+	TUniquePtr<FArchive> OldReader	(IFileManager::Get().CreateFileReader(*OldFilename));
+	TUniquePtr<FArchive> PatchReader(IFileManager::Get().CreateFileReader(*PatchFilename));
+
+	if (!OldReader || !PatchReader)
+	{
+		OutError = FString::Printf(TEXT("Failed to open \"%s\"."), OldReader ? *PatchFilename : *OldFilename);
+		return false;
+	}
+
+	uint8 Header[PatchMagicLength + 8];
+
+	if (PatchReader->TotalSize() < sizeof(Header))
+	{
+		OutError = TEXT("The patch is truncated.");
+		return false;
+	}
+
+	PatchReader->Serialize(Header, sizeof(Header));
+
+	const int64 NewSize = ReadOffset(Header + PatchMagicLength);
+
+	if (FMemory::Memcmp(Header, PatchMagic, PatchMagicLength) != 0 || NewSize < 0)
+	{
+		OutError = TEXT("The patch isn't a BlueprintHttp delta patch.");
+		return false;
+	}
+
+	TUniquePtr<FArchive> NewWriter(IFileManager::Get().CreateFileWriter(*NewFilename));
+
+	if (!NewWriter)
+	{
+		OutError = FString::Printf(TEXT("Failed to create \"%s\"."), *NewFilename);
+		return false;
+	}
+
+	FPatchBlockReader Blocks(*PatchReader);
+
+	const int64 OldSize = OldReader->TotalSize();
+
+	TArray<uint8> Block;
+	TArray<uint8> OldBlock;
+	Block	.SetNumUninitialized(PatchChunkSize);
+	OldBlock.SetNumUninitialized(PatchChunkSize);
+
+	const auto Write = [&NewWriter, Hash](uint8* const Data, const int64 Length)
+	{
+		NewWriter->Serialize(Data, Length);
+
+		if (Hash)
+		{
+			Hash->Update(Data, Length);
+		}
+	};
+
+	int64 NewPosition = 0;
+	int64 OldPosition = 0;
+
+	while (NewPosition < NewSize)
+	{
+		uint8 Control[24];
+
+		if (!Blocks.Read(Control, sizeof(Control)))
+		{
+			OutError = TEXT("The patch is corrupt.");
+			return false;
+		}
+
+		const int64 DiffLength	= ReadOffset(Control);
+		const int64 ExtraLength = ReadOffset(Control + 8);
+		const int64 OldSeek		= ReadOffset(Control + 16);
+
+		if (DiffLength < 0 || ExtraLength < 0 || DiffLength > NewSize - NewPosition || ExtraLength > NewSize - NewPosition - DiffLength)
+		{
+			OutError = TEXT("The patch is corrupt.");
+			return false;
+		}
+
+		// The diff block is added to the old file, bytes outside of the old file are taken as is.
+		for (int64 Done = 0; Done < DiffLength; )
+		{
+			const int64 Length = FMath::Min(DiffLength - Done, PatchChunkSize);
+
+			if (!Blocks.Read(Block.GetData(), Length))
+			{
+				OutError = TEXT("The patch is corrupt.");
+				return false;
+			}
+
+			const int64 Start	 = OldPosition + Done;
+			const int64 OldBegin = FMath::Clamp<int64>(Start, 0, OldSize);
+			const int64 OldEnd	 = FMath::Clamp<int64>(Start + Length, 0, OldSize);
+
+			if (OldEnd > OldBegin)
+			{
+				if (OldReader->Tell() != OldBegin)
+				{
+					OldReader->Seek(OldBegin);
+				}
+
+				OldReader->Serialize(OldBlock.GetData(), OldEnd - OldBegin);
+
+				uint8* const Target = Block.GetData() + (OldBegin - Start);
+
+				for (int64 Index = 0; Index < OldEnd - OldBegin; ++Index)
+				{
+					Target[Index] += OldBlock[Index];
+				}
+			}
+
+			Write(Block.GetData(), Length);
+
+			Done += Length;
+		}
+
+		for (int64 Done = 0; Done < ExtraLength; )
+		{
+			const int64 Length = FMath::Min(ExtraLength - Done, PatchChunkSize);
+
+			if (!Blocks.Read(Block.GetData(), Length))
+			{
+				OutError = TEXT("The patch is corrupt.");
+				return false;
+			}
+
+			Write(Block.GetData(), Length);
+
+			Done += Length;
+		}
+
+		NewPosition += DiffLength + ExtraLength;
+		OldPosition += DiffLength + OldSeek;
+	}
+
+	if (OldReader->IsError())
+	{
+		OutError = FString::Printf(TEXT("Failed to read \"%s\"."), *OldFilename);
+		return false;
+	}
+
+	if (!NewWriter->Close())
+	{
+		OutError = FString::Printf(TEXT("Failed to write \"%s\"."), *NewFilename);
+		return false;
+	}
+
+	return true;
+}
+
+bool FHttpDeltaPatch::Create(const FString& OldFilename, const FString& NewFilename, const FString& PatchFilename, FString& OutError)
+{
+	TArray64<uint8> OldData;
+	TArray64<uint8> NewData;
+
+	if (!FFileHelper::LoadFileToArray(OldData, *OldFilename))
+	{
+		OutError = FString::Printf(TEXT("Failed to read \"%s\"."), *OldFilename);
+		return false;
+	}
+
+	if (!FFileHelper::LoadFileToArray(NewData, *NewFilename))
+	{
+		OutError = FString::Printf(TEXT("Failed to read \"%s\"."), *NewFilename);
+		return false;
+	}
+
+	TUniquePtr<FArchive> PatchWriter(IFileManager::Get().CreateFileWriter(*PatchFilename));
+
+	if (!PatchWriter)
+	{
+		OutError = FString::Printf(TEXT("Failed to create \"%s\"."), *PatchFilename);
+		return false;
+	}
+
+	const uint8* const Old = OldData.GetData();
+	const uint8* const New = NewData.GetData();
+	const int64 OldSize = OldData.Num();
+	const int64 NewSize = NewData.Num();
+
+	TArray64<int64> I;
+	{
+		TArray64<int64> V;
+		const FSuffixSorter Sorter(Old, OldSize, I, V);
+	}
+
+	uint8 Header[PatchMagicLength + 8];
+	FMemory::Memcpy(Header, PatchMagic, PatchMagicLength);
+	WriteOffset(NewSize, Header + PatchMagicLength);
+	PatchWriter->Serialize(Header, sizeof(Header));
+
+	FPatchBlockWriter Blocks(*PatchWriter);
+
+	TArray64<uint8> Diff;
+
+	bool bSuccess = true;
+
+	// The scan of bsdiff 4.3: a match is extended forward from the last one and backward from the
+	// next one, the bytes between them go to the extra block.
+	int64 Scan = 0;
+	int64 Length = 0;
+	int64 Position = 0;
+	int64 LastScan = 0;
+	int64 LastPosition = 0;
+	int64 LastOffset = 0;
+
+	while (bSuccess && Scan < NewSize)
+	{
+		int64 OldScore = 0;
+		int64 ScoreScan = Scan += Length;
+
+		for (; Scan < NewSize; ++Scan)
+		{
+			Length = SearchMatch(I, Old, OldSize, New + Scan, NewSize - Scan, 0, OldSize, Position);
+
+			for (; ScoreScan < Scan + Length; ++ScoreScan)
+			{
+				if (ScoreScan + LastOffset < OldSize && Old[ScoreScan + LastOffset] == New[ScoreScan])
+				{
+					++OldScore;
+				}
+			}
+
+			if ((Length == OldScore && Length != 0) || Length > OldScore + 8)
+			{
+				break;
+			}
+
+			if (Scan + LastOffset < OldSize && Old[Scan + LastOffset] == New[Scan])
+			{
+				--OldScore;
+			}
+		}
+
+		if (Length == OldScore && Scan != NewSize)
+		{
+			continue;
+		}
+
+		int64 ForwardLength = 0;
+		{
+			int64 Score = 0;
+			int64 BestScore = 0;
+
+			for (int64 Index = 0; LastScan + Index < Scan && LastPosition + Index < OldSize; )
+			{
+				if (Old[LastPosition + Index] == New[LastScan + Index])
+				{
+					++Score;
+				}
+
+				++Index;
+
+				if (Score * 2 - Index > BestScore * 2 - ForwardLength)
+				{
+					BestScore = Score;
+					ForwardLength = Index;
+				}
+			}
+		}
+
+		int64 BackwardLength = 0;
+		if (Scan < NewSize)
+		{
+			int64 Score = 0;
+			int64 BestScore = 0;
+
+			for (int64 Index = 1; Scan >= LastScan + Index && Position >= Index; ++Index)
+			{
+				if (Old[Position - Index] == New[Scan - Index])
+				{
+					++Score;
+				}
+
+				if (Score * 2 - Index > BestScore * 2 - BackwardLength)
+				{
+					BestScore = Score;
+					BackwardLength = Index;
+				}
+			}
+		}
+
+		if (LastScan + ForwardLength > Scan - BackwardLength)
+		{
+			const int64 Overlap = (LastScan + ForwardLength) - (Scan - BackwardLength);
+
+			int64 Score = 0;
+			int64 BestScore = 0;
+			int64 SplitLength = 0;
+
+			for (int64 Index = 0; Index < Overlap; ++Index)
+			{
+				if (New[LastScan + ForwardLength - Overlap + Index] == Old[LastPosition + ForwardLength - Overlap + Index])
+				{
+					++Score;
+				}
+				if (New[Scan - BackwardLength + Index] == Old[Position - BackwardLength + Index])
+				{
+					--Score;
+				}
+
+				if (Score > BestScore)
+				{
+					BestScore = Score;
+					SplitLength = Index + 1;
+				}
+			}
+
+			ForwardLength  += SplitLength - Overlap;
+			BackwardLength -= SplitLength;
+		}
+
+		const int64 ExtraLength = (Scan - BackwardLength) - (LastScan + ForwardLength);
+
+		uint8 Control[24];
+		WriteOffset(ForwardLength, Control);
+		WriteOffset(ExtraLength, Control + 8);
+		WriteOffset((Position - BackwardLength) - (LastPosition + ForwardLength), Control + 16);
+
+		Diff.SetNumUninitialized(ForwardLength, EAllowShrinking::No);
+
+		for (int64 Index = 0; Index < ForwardLength; ++Index)
+		{
+			Diff[Index] = New[LastScan + Index] - Old[LastPosition + Index];
+		}
+
+		bSuccess = Blocks.Write(Control, sizeof(Control))
+			&& Blocks.Write(Diff.GetData(), ForwardLength)
+			&& Blocks.Write(New + LastScan + ForwardLength, ExtraLength);
+
+		LastScan	 = Scan - BackwardLength;
+		LastPosition = Position - BackwardLength;
+		LastOffset	 = Position - Scan;
+	}
+
+	if (!bSuccess || !Blocks.Finish() || !PatchWriter->Close())
+	{
+		OutError = FString::Printf(TEXT("Failed to write \"%s\"."), *PatchFilename);
+		return false;
+	}
+
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand GHttpDeltaPatchCreateCommand(
+	TEXT("http.DeltaPatch.Create"),
+	TEXT("Makes the patch served to HttpUpdateFile from two versions of a file. Args: <OldFile> <NewFile> <PatchFile>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	if (Args.Num() != 3)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Update file: Usage: http.DeltaPatch.Create <OldFile> <NewFile> <PatchFile>"));
+		return;
+	}
+
+	FString Error;
+
+	if (!FHttpDeltaPatch::Create(Args[0], Args[1], Args[2], Error))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Update file: %s"), *Error);
+		return;
+	}
+
+	UE_LOG(LogHttp, Display, TEXT("Update file: Wrote \"%s\" (%lld bytes)."), *Args[2], IFileManager::Get().FileSize(*Args[2]));
+})
+);
+#endif // !UE_BUILD_SHIPPING
+
+UHttpPatchFileProxy* UHttpPatchFileProxy::HttpUpdateFile(const FString& PatchUrl, const FString& FileUrl, const FString& LocalFile, const EHttpHashAlgorithm HashAlgorithm, const FString& ExpectedHash)
+{
+	UHttpPatchFileProxy* const Proxy = NewObject<UHttpPatchFileProxy>();
+
+	Proxy->Download		   = nullptr;
+	Proxy->PatchUrl		   = PatchUrl;
+	Proxy->FileUrl		   = FileUrl;
+	Proxy->LocalFile	   = LocalFile;
+	Proxy->HashAlgorithm   = HashAlgorithm;
+	Proxy->ExpectedHash	   = ExpectedHash;
+	Proxy->BytesDownloaded = 0;
+	Proxy->bPatching	   = false;
+
+	return Proxy;
+}
+
+void UHttpPatchFileProxy::Activate()
+{
+	// A patched file can't be trusted without the hash to check it against.
+	if (!PatchUrl.IsEmpty() && (HashAlgorithm == EHttpHashAlgorithm::None || ExpectedHash.IsEmpty()))
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Update file: No expected hash for \"%s\", downloading the full file instead of patching it."), *FPaths::GetCleanFilename(LocalFile));
+		DownloadFile();
+	}
+	else if (!PatchUrl.IsEmpty() && IFileManager::Get().FileExists(*LocalFile))
+	{
+		DownloadPatch();
+	}
+	else
+	{
+		DownloadFile();
+	}
+}
+
+void UHttpPatchFileProxy::DownloadPatch()
+{
+	bPatching = true;
+
+	Download = UHttpDownloadFileProxy::HttpDownloadFile(PatchUrl, {}, EHttpVerb::GET, EHttpMimeType::bin, FString(), {},
+		LocalFile + PatchFileSuffix, FHttpRequestTimeouts(), FHttpIntegrityCheck(), nullptr);
+
+	Download->OnFileDownloaded	 .AddDynamic(this, &UHttpPatchFileProxy::OnPatchDownloaded);
+	Download->OnFileDownloadError.AddDynamic(this, &UHttpPatchFileProxy::OnPatchDownloadError);
+	Download->OnDownloadProgress .AddDynamic(this, &UHttpPatchFileProxy::OnDownloadProgress);
+
+	Download->Activate();
+}
+
+void UHttpPatchFileProxy::DownloadFile()
+{
+	bPatching = false;
+
+	FHttpIntegrityCheck IntegrityCheck;
+	IntegrityCheck.Algorithm	  = HashAlgorithm;
+	IntegrityCheck.ExpectedDigest = ExpectedHash;
+
+	Download = UHttpDownloadFileProxy::HttpDownloadFile(FileUrl, {}, EHttpVerb::GET, EHttpMimeType::bin, FString(), {},
+		LocalFile + PartialFileSuffix, FHttpRequestTimeouts(), IntegrityCheck, nullptr);
+
+	Download->OnFileDownloaded	 .AddDynamic(this, &UHttpPatchFileProxy::OnFileDownloaded);
+	Download->OnFileDownloadError.AddDynamic(this, &UHttpPatchFileProxy::OnFileDownloadError);
+	Download->OnDownloadProgress .AddDynamic(this, &UHttpPatchFileProxy::OnDownloadProgress);
+
+	Download->Activate();
+}
+
+void UHttpPatchFileProxy::OnDownloadProgress(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	OnProgress.Broadcast(bPatching, BytesDownloaded + TotalBytesReceived);
+}
+
+void UHttpPatchFileProxy::OnPatchDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	BytesDownloaded += TotalBytesReceived;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis = TWeakObjectPtr<UHttpPatchFileProxy>(this), OldFile = LocalFile, Algorithm = HashAlgorithm, Expected = ExpectedHash]()
+	{
+		const FString PatchFile = OldFile + PatchFileSuffix;
+
+		FHttpStreamingHash Hash(Algorithm);
+		FString Error;
+
+		bool bValid = FHttpDeltaPatch::Apply(OldFile, PatchFile, OldFile + PartialFileSuffix, &Hash, Error);
+
+		// Activate() only patches with an expected hash.
+		if (bValid)
+		{
+			TArray<uint8> ExpectedDigest;
+			bValid = FHttpStreamingHash::ParseDigest(Expected, Algorithm, ExpectedDigest) && Hash.Finalize() == ExpectedDigest;
+
+			if (!bValid)
+			{
+				Error = TEXT("The patched file doesn't match the expected hash.");
+			}
+		}
+
+		IFileManager::Get().Delete(*PatchFile, false, false, true);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, bValid, Error = MoveTemp(Error)]()
+		{
+			if (UHttpPatchFileProxy* const This = WeakThis.Get())
+			{
+				This->OnPatchApplied(bValid, Error);
+			}
+		});
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void UHttpPatchFileProxy::OnPatchDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	UE_LOG(LogHttp, Log, TEXT("Update file: No patch for \"%s\", downloading the full file."), *FPaths::GetCleanFilename(LocalFile));
+
+	IFileManager::Get().Delete(*(LocalFile + PatchFileSuffix), false, false, true);
+
+	DownloadFile();
+}
+
+void UHttpPatchFileProxy::OnPatchApplied(const bool bValid, const FString& Error)
+{
+	const FString PartialFile = LocalFile + PartialFileSuffix;
+
+	if (!bValid)
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Update file: Failed to patch \"%s\": %s Downloading the full file."), *FPaths::GetCleanFilename(LocalFile), *Error);
+		IFileManager::Get().Delete(*PartialFile, false, false, true);
+		DownloadFile();
+	}
+	else if (!IFileManager::Get().Move(*LocalFile, *PartialFile, true, true))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Update file: Failed to move \"%s\" in place."), *FPaths::ConvertRelativePathToFull(LocalFile));
+		IFileManager::Get().Delete(*PartialFile, false, false, true);
+		Complete(false);
+	}
+	else
+	{
+		Complete(true);
+	}
+}
+
+void UHttpPatchFileProxy::OnFileDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	BytesDownloaded += TotalBytesReceived;
+
+	const FString PartialFile = LocalFile + PartialFileSuffix;
+
+	if (!IFileManager::Get().Move(*LocalFile, *PartialFile, true, true))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Update file: Failed to move \"%s\" in place."), *FPaths::ConvertRelativePathToFull(LocalFile));
+		IFileManager::Get().Delete(*PartialFile, false, false, true);
+		Complete(false);
+		return;
+	}
+
+	Complete(true);
+}
+
+void UHttpPatchFileProxy::OnFileDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	BytesDownloaded += TotalBytesReceived;
+
+	IFileManager::Get().Delete(*(LocalFile + PartialFileSuffix), false, false, true);
+
+	Complete(false);
+}
+
+void UHttpPatchFileProxy::Complete(const bool bSucceeded)
+{
+	UE_LOG(LogHttp, Log, TEXT("Update file: \"%s\" %s, %lld bytes downloaded."), *FPaths::GetCleanFilename(LocalFile),
+		!bSucceeded ? TEXT("failed") : bPatching ? TEXT("patched") : TEXT("downloaded"), BytesDownloaded);
+
+	if (bSucceeded)
+	{
+		OnUpdated.Broadcast(bPatching, BytesDownloaded);
+	}
+	else
+	{
+		OnFailed.Broadcast(bPatching, BytesDownloaded);
+	}
+
+	Download = nullptr;
+
+	SetReadyToDestroy();
+}
@@ -0,0 +1,501 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpEventSource.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "HttpClientProfile.h"
+#include "Http.h"
+#include "Containers/StringConv.h"
+
+namespace
+{
+	FString Utf8ToString(const uint8* const Data, const int32 Length)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Length);
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	bool IsField(const uint8* const Line, const int32 NameLength, const char* const Name)
+	{
+		return FCStringAnsi::Strlen(Name) == NameLength && FMemory::Memcmp(Line, Name, NameLength) == 0;
+	}
+}
+
+FHttpEventStreamParser::FHttpEventStreamParser(const FString& InLastEventId)
+	: bSkipLineFeed(false)
+	, bStreamStarted(false)
+	, bReceivedData(false)
+	, EventIdBuffer(InLastEventId)
+	, LastEventId(InLastEventId)
+	, RetryMilliseconds(-1)
+{
+	SetIsSaving(true);
+	SetIsPersistent(false);
+}
+
+void FHttpEventStreamParser::Serialize(void* Data, int64 Length)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const uint8*	   Bytes = static_cast<const uint8*>(Data);
+	const uint8* const End	 = Bytes + Length;
+
+	bReceivedData |= Length > 0;
+
+	if (bSkipLineFeed && Bytes < End)
+	{
+		bSkipLineFeed = false;
+
+		if (*Bytes == '\n')
+		{
+			++Bytes;
+		}
+	}
+
+	while (Bytes < End)
+	{
+		const uint8* LineEnd = Bytes;
+		while (LineEnd < End && *LineEnd != '\n' && *LineEnd != '\r')
+		{
+			++LineEnd;
+		}
+
+		if (LineEnd == End)
+		{
+			PartialLine.Append(Bytes, End - Bytes);
+			break;
+		}
+
+		if (PartialLine.Num() > 0)
+		{
+			PartialLine.Append(Bytes, LineEnd - Bytes);
+			ProcessLine(PartialLine.GetData(), PartialLine.Num());
+			PartialLine.Reset();
+		}
+		else
+		{
+			ProcessLine(Bytes, LineEnd - Bytes);
+		}
+
+		// Lines end with CRLF, LF or CR.
+		if (*LineEnd == '\r')
+		{
+			if (LineEnd + 1 == End)
+			{
+				bSkipLineFeed = true;
+			}
+			else if (LineEnd[1] == '\n')
+			{
+				++LineEnd;
+			}
+		}
+
+		Bytes = LineEnd + 1;
+	}
+}
+
+void FHttpEventStreamParser::ProcessLine(const uint8* Line, int32 Length)
+{
+	if (!bStreamStarted)
+	{
+		bStreamStarted = true;
+
+		if (Length >= 3 && Line[0] == 0xEF && Line[1] == 0xBB && Line[2] == 0xBF)
+		{
+			Line   += 3;
+			Length -= 3;
+		}
+	}
+
+	if (Length == 0)
+	{
+		DispatchEvent();
+		return;
+	}
+
+	// Comments, used by servers to keep the connection alive.
+	if (Line[0] == ':')
+	{
+		return;
+	}
+
+	int32 NameLength = 0;
+	while (NameLength < Length && Line[NameLength] != ':')
+	{
+		++NameLength;
+	}
+
+	const uint8* Value		 = Line + FMath::Min(NameLength + 1, Length);
+	int32		 ValueLength = Length - static_cast<int32>(Value - Line);
+
+	if (ValueLength > 0 && *Value == ' ')
+	{
+		++Value;
+		--ValueLength;
+	}
+
+	if (IsField(Line, NameLength, "data"))
+	{
+		EventData += Utf8ToString(Value, ValueLength);
+		EventData += TEXT("\n");
+	}
+	else if (IsField(Line, NameLength, "event"))
+	{
+		EventType = Utf8ToString(Value, ValueLength);
+	}
+	else if (IsField(Line, NameLength, "id"))
+	{
+		if (!MakeArrayView(Value, ValueLength).Contains(0))
+		{
+			EventIdBuffer = Utf8ToString(Value, ValueLength);
+		}
+	}
+	else if (IsField(Line, NameLength, "retry") && ValueLength > 0)
+	{
+		int64 Milliseconds = 0;
+
+		for (int32 Index = 0; Index < ValueLength; ++Index)
+		{
+			if (!FCharAnsi::IsDigit(static_cast<ANSICHAR>(Value[Index])))
+			{
+				return;
+			}
+
+			Milliseconds = FMath::Min<int64>(Milliseconds * 10 + (Value[Index] - '0'), MAX_int32);
+		}
+
+		RetryMilliseconds = Milliseconds;
+	}
+}
+
+void FHttpEventStreamParser::DispatchEvent()
+{
+	LastEventId = EventIdBuffer;
+
+	if (EventData.IsEmpty())
+	{
+		EventType.Reset();
+		return;
+	}
+
+	EventData.LeftChopInline(1, EAllowShrinking::No);
+
+	FHttpServerSentEvent& Event = Events.AddDefaulted_GetRef();
+
+	Event.Type = EventType.IsEmpty() ? FString(TEXT("message")) : MoveTemp(EventType);
+	Event.Data = MoveTemp(EventData);
+	Event.Id   = LastEventId;
+
+	EventType.Reset();
+	EventData.Reset();
+}
+
+TArray<FHttpServerSentEvent> FHttpEventStreamParser::ConsumeEvents()
+{
+	FScopeLock ScopeLock(&Lock);
+	return MoveTemp(Events);
+}
+
+FString FHttpEventStreamParser::GetLastEventId() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return LastEventId;
+}
+
+int64 FHttpEventStreamParser::GetRetryMilliseconds() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return RetryMilliseconds;
+}
+
+bool FHttpEventStreamParser::HasReceivedData() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return bReceivedData;
+}
+
+UHttpEventSource::UHttpEventSource()
+	: Super()
+	, Request(nullptr)
+	, State(EHttpEventSourceState::Closed)
+	, RetryMilliseconds(-1)
+	, ReconnectAttempts(0)
+{
+}
+
+UHttpEventSource* UHttpEventSource::CreateEventSource(const FString& Url, const TMap<FString, FString>& Headers, const FName Profile)
+{
+	UHttpEventSource* const Source = NewObject<UHttpEventSource>();
+
+	Source->Url		= Url;
+	Source->Headers = Headers;
+	Source->Profile = Profile;
+
+	return Source;
+}
+
+bool UHttpEventSource::Connect()
+{
+	Close();
+
+	ReconnectAttempts = 0;
+
+	return StartRequest();
+}
+
+void UHttpEventSource::Close()
+{
+	if (ReconnectHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+		ReconnectHandle.Reset();
+	}
+
+	if (Request)
+	{
+		Request->Abandon();
+		Request->SetResponseStream(nullptr);
+		Request = nullptr;
+	}
+
+	Parser.Reset();
+	State = EHttpEventSourceState::Closed;
+}
+
+EHttpEventSourceState UHttpEventSource::GetState() const
+{
+	return State;
+}
+
+FString UHttpEventSource::GetLastEventId() const
+{
+	return LastEventId;
+}
+
+void UHttpEventSource::SetLastEventId(const FString& EventId)
+{
+	LastEventId = EventId;
+}
+
+UHttpRequest* UHttpEventSource::GetHttpRequest() const
+{
+	return Request;
+}
+
+bool UHttpEventSource::StartRequest()
+{
+	Parser = MakeShared<FHttpEventStreamParser, ESPMode::ThreadSafe>(LastEventId);
+
+	Request = UHttpRequest::CreateRequest();
+	Request->SetVerb(EHttpVerb::GET);
+
+	if (Profile.IsNone())
+	{
+		Request->SetURL(Url);
+	}
+	else
+	{
+		FHttpClientProfiles::Apply(Profile, Request, Url, {});
+	}
+
+	Request->SetHeaders(Headers);
+	Request->SetHeader(TEXT("Accept"),		  TEXT("text/event-stream"));
+	Request->SetHeader(TEXT("Cache-Control"), TEXT("no-cache"));
+
+	if (!LastEventId.IsEmpty())
+	{
+		Request->SetHeader(TEXT("Last-Event-ID"), LastEventId);
+	}
+
+	// The stream has no end, it's only limited by its silence. Reconnections replace the retries.
+	FHttpRequestTimeouts Timeouts = Request->GetTimeouts();
+	Timeouts.TotalTimeout	 = 0.f;
+	Timeouts.ActivityTimeout = InactivityTimeout;
+
+	Request->SetTimeouts(Timeouts);
+	Request->SetRetryPolicy(FHttpRetryPolicy());
+
+	// Events are delivered with the progress.
+	FHttpProgressPolicy ProgressPolicy;
+	ProgressPolicy.Reporting = EHttpProgressReporting::EveryFrame;
+	Request->SetProgressPolicy(ProgressPolicy);
+
+	Request->SetResponseStream(Parser);
+
+	Request->OnRequestHeaderReceived.AddDynamic(this, &UHttpEventSource::OnRequestHeader);
+	Request->OnRequestProgress		.AddDynamic(this, &UHttpEventSource::OnRequestProgress);
+	Request->OnRequestComplete		.AddDynamic(this, &UHttpEventSource::OnRequestCompleted);
+
+	State = EHttpEventSourceState::Connecting;
+
+	if (!Request->ProcessRequest())
+	{
+		UE_LOG(LogHttp, Error, TEXT("SSE: Failed to start the stream \"%s\"."), *Request->GetURL());
+
+		Close();
+		OnError.Broadcast(this, 0, false);
+		return false;
+	}
+
+	return true;
+}
+
+void UHttpEventSource::OnRequestHeader(UHttpRequest* const InRequest, const FString& HeaderName, const FString& HeaderValue)
+{
+	if (InRequest != Request || State != EHttpEventSourceState::Connecting || !HeaderName.Equals(TEXT("Content-Type"), ESearchCase::IgnoreCase))
+	{
+		return;
+	}
+
+	if (!HeaderValue.TrimStart().StartsWith(TEXT("text/event-stream"), ESearchCase::IgnoreCase))
+	{
+		return;
+	}
+
+	State			  = EHttpEventSourceState::Open;
+	ReconnectAttempts = 0;
+
+	OnOpen.Broadcast(this);
+}
+
+void UHttpEventSource::OnRequestProgress(UHttpRequest* const InRequest, const int32 BytesSent, const int32 BytesReceived)
+{
+	if (InRequest == Request)
+	{
+		FlushEvents();
+	}
+}
+
+bool UHttpEventSource::FlushEvents()
+{
+	const TSharedPtr<FHttpEventStreamParser, ESPMode::ThreadSafe> CurrentParser = Parser;
+	if (!CurrentParser)
+	{
+		return false;
+	}
+
+	for (const FHttpServerSentEvent& Event : CurrentParser->ConsumeEvents())
+	{
+		LastEventId = Event.Id;
+
+		OnEvent.Broadcast(this, Event);
+
+		if (Parser != CurrentParser)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UHttpEventSource::OnRequestCompleted(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	if (InRequest != Request)
+	{
+		return;
+	}
+
+	const int32 ResponseCode = Response ? Response->GetResponseCode() : 0;
+
+	// Responses served by a transport don't go through the stream.
+	if (bConnectedSuccessfully && ResponseCode == 200 && !Parser->HasReceivedData())
+	{
+		TArray<uint8> Content;
+		Response->GetContent(Content);
+		Parser->Serialize(Content.GetData(), Content.Num());
+	}
+
+	if (!FlushEvents())
+	{
+		return;
+	}
+
+	// Events without their blank line are never dispatched, the ID is kept.
+	LastEventId = Parser->GetLastEventId();
+
+	if (Parser->GetRetryMilliseconds() >= 0)
+	{
+		RetryMilliseconds = Parser->GetRetryMilliseconds();
+	}
+
+	Request->SetResponseStream(nullptr);
+
+	const bool bWasOpen = State == EHttpEventSourceState::Open;
+
+	bool bReconnect = !bConnectedSuccessfully
+		|| (ResponseCode == 200 && bWasOpen)
+		|| ResponseCode == 408 || ResponseCode == 429 || ResponseCode >= 500;
+
+	if (MaxReconnectAttempts > 0 && ReconnectAttempts >= MaxReconnectAttempts)
+	{
+		bReconnect = false;
+	}
+
+	if (!bReconnect)
+	{
+		UE_CLOG(ResponseCode != 204, LogHttp, Warning, TEXT("SSE: Stream \"%s\" closed (%d)."), *Request->GetURL(), ResponseCode);
+
+		Close();
+		OnError.Broadcast(this, ResponseCode, false);
+		return;
+	}
+
+	ScheduleReconnect(Response);
+	OnError.Broadcast(this, ResponseCode, true);
+}
+
+void UHttpEventSource::ScheduleReconnect(UHttpResponse* const Response)
+{
+	float Delay = RetryMilliseconds >= 0 ? RetryMilliseconds / 1000.f : ReconnectDelay;
+
+	// Failed attempts back off, a stream the server ended is reconnected right after its delay.
+	if (ReconnectAttempts > 0)
+	{
+		Delay *= FMath::Pow(2.f, static_cast<float>(FMath::Min(ReconnectAttempts, 16))) * FMath::FRandRange(0.5f, 1.f);
+	}
+
+	const FString RetryAfter = Response ? Response->GetHeader(TEXT("Retry-After")) : FString();
+	if (!RetryAfter.IsEmpty() && RetryAfter.IsNumeric())
+	{
+		Delay = FMath::Max(Delay, FCString::Atof(*RetryAfter));
+	}
+
+	if (MaxReconnectDelay > 0.f)
+	{
+		Delay = FMath::Min(Delay, MaxReconnectDelay);
+	}
+
+	++ReconnectAttempts;
+
+	UE_LOG(LogHttp, Log, TEXT("SSE: Stream \"%s\" lost, reconnecting in %.2fs (attempt %d)."), *Request->GetURL(), Delay, ReconnectAttempts);
+
+	Request = nullptr;
+	Parser.Reset();
+	State = EHttpEventSourceState::Connecting;
+
+	ReconnectHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+	{
+		ReconnectHandle.Reset();
+		StartRequest();
+		return false;
+	}), Delay);
+}
+
+void UHttpEventSource::BeginDestroy()
+{
+	if (ReconnectHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+		ReconnectHandle.Reset();
+	}
+
+	// Otherwise the connection would stay open.
+	if (Request)
+	{
+		Request->Abandon();
+		Request = nullptr;
+	}
+
+	Super::BeginDestroy();
+}
@@ -0,0 +1,23 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpHeaderUtils.h"
+
+TMap<FString, FString> BlueprintHttp::SplitHeaders(const TArray<FString>& Headers)
+{
+	TMap<FString, FString> OutHeaders;
+
+	FString Key;
+	FString Value;
+
+	const FString Separator = TEXT(": ");
+
+	for (const FString& Header : Headers)
+	{
+		if (Header.Split(Separator, &Key, &Value, ESearchCase::CaseSensitive))
+		{
+			OutHeaders.Emplace(MoveTemp(Key), MoveTemp(Value));
+		}
+	}
+
+	return OutHeaders;
+}
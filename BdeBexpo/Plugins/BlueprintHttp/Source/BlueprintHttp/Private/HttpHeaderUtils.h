@@ -0,0 +1,14 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace BlueprintHttp
+{
+	/**
+	 * Splits raw "Key: Value" header lines, as returned by IHttpBase::GetAllHeaders(),
+	 * into a map. Lines without separator are ignored.
+	 **/
+	TMap<FString, FString> SplitHeaders(const TArray<FString>& Headers);
+}
@@ -0,0 +1,455 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpLoopbackBenchmark.h"
+#include "HttpResponse.h"
+#include "Http.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_BLUEPRINTHTTP_BENCHMARKS
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "HttpPath.h"
+#include "IHttpRouter.h"
+
+/**
+ *  Routes served to the benchmark:
+ *    /bench/small                  A two bytes text body.
+ *    /bench/blob?size=<Bytes>      A binary body of the given size.
+ *    /bench/headers?count=<N>      A small body with N extra headers.
+ **/
+class FHttpLoopbackServer
+{
+public:
+	bool Start(const uint32 Port)
+	{
+		Router = FHttpServerModule::Get().GetHttpRouter(Port, /* bFailOnBindFailure */ true);
+
+		if (!Router)
+		{
+			UE_LOG(LogHttp, Error, TEXT("Benchmark: Failed to bind the loopback server to port %u."), Port);
+			return false;
+		}
+
+		Routes.Add(Router->BindRoute(FHttpPath(TEXT("/bench/small")), EHttpServerRequestVerbs::VERB_GET,
+			FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			OnComplete(FHttpServerResponse::Create(TEXT("ok"), TEXT("text/plain")));
+			return true;
+		})));
+
+		Routes.Add(Router->BindRoute(FHttpPath(TEXT("/bench/blob")), EHttpServerRequestVerbs::VERB_GET,
+			FHttpRequestHandler::CreateRaw(this, &FHttpLoopbackServer::HandleBlob)));
+
+		Routes.Add(Router->BindRoute(FHttpPath(TEXT("/bench/headers")), EHttpServerRequestVerbs::VERB_GET,
+			FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			const FString* const CountParam = Request.QueryParams.Find(TEXT("count"));
+			const int32 Count = CountParam ? FCString::Atoi(**CountParam) : 0;
+
+			TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("ok"), TEXT("text/plain"));
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Response->Headers.Add(FString::Printf(TEXT("X-Bench-Header-%d"), i),
+					{ FString::Printf(TEXT("value-%d-0123456789abcdefghijklmnopqrstuvwxyz"), i) });
+			}
+
+			OnComplete(MoveTemp(Response));
+			return true;
+		})));
+
+		FHttpServerModule::Get().StartAllListeners();
+
+		return true;
+	}
+
+	void Stop()
+	{
+		if (Router)
+		{
+			for (const FHttpRouteHandle& Route : Routes)
+			{
+				Router->UnbindRoute(Route);
+			}
+		}
+
+		Routes.Empty();
+		Router.Reset();
+
+		FHttpServerModule::Get().StopAllListeners();
+	}
+
+private:
+	bool HandleBlob(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		const FString* const SizeParam = Request.QueryParams.Find(TEXT("size"));
+		const int64 Size = SizeParam ? FCString::Atoi64(**SizeParam) : 0;
+
+		// The response owns its body, so filling or copying a payload would be paid on every request.
+		// The content isn't checked: large bodies come zeroed from the OS and aren't touched before being sent.
+		TArray<uint8> Body;
+		Body.SetNumUninitialized(static_cast<int32>(FMath::Clamp<int64>(Size, 0, MAX_int32)));
+
+		OnComplete(FHttpServerResponse::Create(MoveTemp(Body), TEXT("application/octet-stream")));
+		return true;
+	}
+
+	TSharedPtr<IHttpRouter> Router;
+	TArray<FHttpRouteHandle> Routes;
+};
+
+static FAutoConsoleCommand GHttpBenchLoopbackCommand(
+	TEXT("http.Bench.Loopback"),
+	TEXT("Runs the BlueprintHttp end-to-end benchmark against a local HTTP server. ")
+	TEXT("Args: [Port=18089] [Scenarios=SmallRequestStorm,HeaderHeavy,LargeDownload,ConcurrentDownloads] [Scale=1.0] [Out=<Path>] [Quit]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&UHttpLoopbackBenchmark::Run)
+);
+#else
+class FHttpLoopbackServer {};
+#endif // WITH_BLUEPRINTHTTP_BENCHMARKS
+
+void UHttpBenchmarkProbe::OnRequestComplete(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	const bool bSucceeded = bConnectedSuccessfully && Response && Response->GetResponseCode() < 400;
+
+	Owner->OnProbeFinished(this, bSucceeded, Response ? Response->GetContentLength() : 0);
+}
+
+void UHttpBenchmarkProbe::OnProxyResponse(const int32 ResponseCode, const FHeaders& Headers, const FString& ContentType, const FString& Content, const float TimeElapsed, const EBlueprintHttpRequestStatus ConnectionStatus, const int32 BytesSent, const int32 BytesReceived)
+{
+	Owner->OnProbeFinished(this, ResponseCode < 400, BytesReceived);
+}
+
+void UHttpBenchmarkProbe::OnProxyError(const int32 ResponseCode, const FHeaders& Headers, const FString& ContentType, const FString& Content, const float TimeElapsed, const EBlueprintHttpRequestStatus ConnectionStatus, const int32 BytesSent, const int32 BytesReceived)
+{
+	Owner->OnProbeFinished(this, false, BytesReceived);
+}
+
+void UHttpBenchmarkProbe::OnFileDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	Owner->OnProbeFinished(this, true, TotalBytesReceived);
+}
+
+void UHttpBenchmarkProbe::OnFileDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded)
+{
+	Owner->OnProbeFinished(this, false, TotalBytesReceived);
+}
+
+UHttpLoopbackBenchmark::UHttpLoopbackBenchmark()
+	: Super()
+	, ScenarioIndex(INDEX_NONE)
+	, Issued(0)
+	, Completed(0)
+	, Failed(0)
+	, BytesReceived(0)
+	, ScenarioStartTime(0.)
+	, Port(18089)
+	, bQuitWhenDone(false)
+	, bAnyFailure(false)
+{}
+
+void UHttpLoopbackBenchmark::Run(const TArray<FString>& Args)
+{
+	UHttpLoopbackBenchmark* const Benchmark = NewObject<UHttpLoopbackBenchmark>();
+
+	Benchmark->AddToRoot();
+
+	if (!Benchmark->Start(Args))
+	{
+		Benchmark->Finish();
+	}
+}
+
+bool UHttpLoopbackBenchmark::Start(const TArray<FString>& Args)
+{
+#if WITH_BLUEPRINTHTTP_BENCHMARKS
+	float Scale = 1.f;
+	TArray<FString> Wanted;
+
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Port="),  Port);
+		FParse::Value(*Arg, TEXT("Scale="), Scale);
+		FParse::Value(*Arg, TEXT("Out="),   OutPath, /* bShouldStopOnSeparator */ false);
+
+		if (Arg.StartsWith(TEXT("Scenarios=")))
+		{
+			Arg.RightChop(10).ParseIntoArray(Wanted, TEXT(","));
+		}
+
+		bQuitWhenDone |= Arg.Equals(TEXT("Quit"), ESearchCase::IgnoreCase);
+	}
+
+	const auto Scaled = [Scale](const int32 Count) { return FMath::Max(1, FMath::RoundToInt32(Count * Scale)); };
+
+	constexpr int32 LargeDownloadSize = 64 * 1024 * 1024;
+	constexpr int32 ConcurrentSize	  =  2 * 1024 * 1024;
+
+	const TArray<FHttpBenchmarkScenario> AllScenarios =
+	{
+		{ TEXT("Warmup"),				EHttpBenchmarkPath::Request,		TEXT("/bench/small"),											16,					8,	false },
+		{ TEXT("SmallRequestStorm"),	EHttpBenchmarkPath::Request,		TEXT("/bench/small"),											Scaled(1000),		64 },
+		{ TEXT("HeaderHeavy"),			EHttpBenchmarkPath::SendProxy,		TEXT("/bench/headers?count=100"),								Scaled(200),		16 },
+		{ TEXT("LargeDownload"),		EHttpBenchmarkPath::DownloadProxy,	FString::Printf(TEXT("/bench/blob?size=%d"), LargeDownloadSize),	Scaled(4),			1 },
+		{ TEXT("ConcurrentDownloads"),	EHttpBenchmarkPath::DownloadProxy,	FString::Printf(TEXT("/bench/blob?size=%d"), ConcurrentSize),	Scaled(32),			32 },
+	};
+
+	for (const FHttpBenchmarkScenario& Scenario : AllScenarios)
+	{
+		if (!Scenario.bReport || Wanted.Num() == 0 || Wanted.Contains(Scenario.Name))
+		{
+			Scenarios.Add(Scenario);
+		}
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::Combine(BlueprintHttpBenchmark::GetBenchmarkDir(), TEXT("Temp")), true);
+
+	Server = MakeShared<FHttpLoopbackServer>();
+	if (!Server->Start(Port))
+	{
+		bAnyFailure = true;
+		return false;
+	}
+
+	UE_LOG(LogHttp, Display, TEXT("Benchmark: Loopback server listening on port %u, running %d scenarios."), Port, Scenarios.Num());
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UHttpLoopbackBenchmark::Tick));
+
+	StartScenario();
+
+	return true;
+#else
+	UE_LOG(LogHttp, Error, TEXT("Benchmark: Benchmarks are not available in this build configuration."));
+	return false;
+#endif
+}
+
+void UHttpLoopbackBenchmark::Finish()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+#if WITH_BLUEPRINTHTTP_BENCHMARKS
+	if (Server)
+	{
+		Server->Stop();
+		Server.Reset();
+	}
+#endif
+
+	const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+
+	Report->SetStringField(TEXT("suite"),    TEXT("loopback"));
+	Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Report->SetStringField(TEXT("date"),     FDateTime::UtcNow().ToIso8601());
+	Report->SetBoolField  (TEXT("success"),  !bAnyFailure);
+	Report->SetArrayField (TEXT("scenarios"), Results);
+
+	BlueprintHttpBenchmark::WriteReport(Report, TEXT("Loopback"), OutPath);
+
+	RemoveFromRoot();
+
+	if (bQuitWhenDone)
+	{
+		if (bAnyFailure)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+		else
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+}
+
+bool UHttpLoopbackBenchmark::Tick(float DeltaTime)
+{
+	if (!Scenarios.IsValidIndex(ScenarioIndex))
+	{
+		return false;
+	}
+
+	ResourceProbe.Sample();
+
+	const FHttpBenchmarkScenario& Scenario = Scenarios[ScenarioIndex];
+
+	while (Issued < Scenario.RequestCount && ActiveProbes.Num() < Scenario.Concurrency)
+	{
+		IssueRequest();
+	}
+
+	if (Completed + Failed >= Scenario.RequestCount)
+	{
+		FinishScenario();
+
+		if (++ScenarioIndex < Scenarios.Num())
+		{
+			StartScenario();
+		}
+		else
+		{
+			// Finish() removes this ticker, returning false here would remove it twice.
+			Finish();
+		}
+	}
+
+	return true;
+}
+
+void UHttpLoopbackBenchmark::StartScenario()
+{
+	if (ScenarioIndex == INDEX_NONE)
+	{
+		ScenarioIndex = 0;
+	}
+
+	Issued        = 0;
+	Completed     = 0;
+	Failed        = 0;
+	BytesReceived = 0;
+
+	Latencies.Reset();
+
+	// Start from a clean heap so the previous scenario's garbage isn't billed to this one.
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	ResourceProbe.Begin();
+
+	ScenarioStartTime = FPlatformTime::Seconds();
+}
+
+void UHttpLoopbackBenchmark::IssueRequest()
+{
+	const FHttpBenchmarkScenario& Scenario = Scenarios[ScenarioIndex];
+
+	const FString Url = FString::Printf(TEXT("http://127.0.0.1:%u%s"), Port, *Scenario.Route);
+
+	UHttpBenchmarkProbe* const Probe = NewObject<UHttpBenchmarkProbe>(this);
+
+	Probe->Owner     = this;
+	Probe->StartTime = FPlatformTime::Seconds();
+
+	ActiveProbes.Add(Probe);
+	++Issued;
+
+	switch (Scenario.Path)
+	{
+	case EHttpBenchmarkPath::Request:
+	{
+		UHttpRequest* const Request = UHttpRequest::CreateRequest();
+		Probe->Target = Request;
+
+		Request->SetURL(Url);
+		Request->SetVerb(EHttpVerb::GET);
+		Request->OnRequestComplete.AddDynamic(Probe, &UHttpBenchmarkProbe::OnRequestComplete);
+
+		if (!Request->ProcessRequest())
+		{
+			OnProbeFinished(Probe, false, 0);
+		}
+		break;
+	}
+	case EHttpBenchmarkPath::SendProxy:
+	{
+		USendHttpRequestProxy* const Proxy = USendHttpRequestProxy::SendHttpRequest(Url, {}, EHttpVerb::GET, EHttpMimeType::txt, FString(), {}, FHttpRequestTimeouts());
+		Probe->Target = Proxy;
+
+		Proxy->OnResponse.AddDynamic(Probe, &UHttpBenchmarkProbe::OnProxyResponse);
+		Proxy->OnError   .AddDynamic(Probe, &UHttpBenchmarkProbe::OnProxyError);
+		break;
+	}
+	case EHttpBenchmarkPath::DownloadProxy:
+	{
+		Probe->TempFile = FPaths::Combine(BlueprintHttpBenchmark::GetBenchmarkDir(), TEXT("Temp"), FString::Printf(TEXT("Download-%d.bin"), Issued));
+
+		UHttpDownloadFileProxy* const Proxy = UHttpDownloadFileProxy::HttpDownloadFile(Url, {}, EHttpVerb::GET, EHttpMimeType::bin, FString(), {}, Probe->TempFile,
+			FHttpRequestTimeouts(), FHttpIntegrityCheck());
+		Probe->Target = Proxy;
+
+		Proxy->OnFileDownloaded   .AddDynamic(Probe, &UHttpBenchmarkProbe::OnFileDownloaded);
+		Proxy->OnFileDownloadError.AddDynamic(Probe, &UHttpBenchmarkProbe::OnFileDownloadError);
+		Proxy->Activate();
+		break;
+	}
+	}
+}
+
+void UHttpLoopbackBenchmark::OnProbeFinished(UHttpBenchmarkProbe* const Probe, const bool bSucceeded, const int64 Bytes)
+{
+	if (ActiveProbes.Remove(Probe) == 0)
+	{
+		return;
+	}
+
+	if (bSucceeded)
+	{
+		++Completed;
+		BytesReceived += Bytes;
+		Latencies.Add(FPlatformTime::Seconds() - Probe->StartTime);
+	}
+	else
+	{
+		++Failed;
+	}
+
+	if (!Probe->TempFile.IsEmpty())
+	{
+		IFileManager::Get().Delete(*Probe->TempFile, false, false, true);
+	}
+
+	Probe->Target = nullptr;
+}
+
+void UHttpLoopbackBenchmark::FinishScenario()
+{
+	const double Duration = FMath::Max(FPlatformTime::Seconds() - ScenarioStartTime, UE_DOUBLE_SMALL_NUMBER);
+
+	// Collect inside the measurement so the UObjects this scenario created are billed to it.
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	ResourceProbe.End();
+
+	const FHttpBenchmarkScenario& Scenario = Scenarios[ScenarioIndex];
+
+	if (Failed > 0)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Benchmark: %s had %d failed requests."), *Scenario.Name, Failed);
+		bAnyFailure = true;
+	}
+
+	if (!Scenario.bReport)
+	{
+		return;
+	}
+
+	const TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+
+	Result->SetStringField(TEXT("name"),                Scenario.Name);
+	Result->SetNumberField(TEXT("requests"),            Scenario.RequestCount);
+	Result->SetNumberField(TEXT("concurrency"),         Scenario.Concurrency);
+	Result->SetNumberField(TEXT("failed"),              Failed);
+	Result->SetNumberField(TEXT("duration_s"),          Duration);
+	Result->SetNumberField(TEXT("requests_per_s"),      Completed / Duration);
+	Result->SetNumberField(TEXT("bytes_received"),      static_cast<double>(BytesReceived));
+	Result->SetNumberField(TEXT("megabytes_per_s"),     BytesReceived / Duration / (1024. * 1024.));
+
+	const TSharedRef<FJsonObject> Latency = MakeShared<FJsonObject>();
+	Latencies.WriteTo(*Latency);
+	Result->SetObjectField(TEXT("latency"), Latency);
+
+	const TSharedRef<FJsonObject> Resources = MakeShared<FJsonObject>();
+	ResourceProbe.WriteTo(*Resources);
+	Result->SetObjectField(TEXT("resources"), Resources);
+
+	UE_LOG(LogHttp, Display, TEXT("Benchmark: %-20s %8.1f req/s  p50 %7.2f ms  p99 %7.2f ms  %8.2f MB/s"),
+		*Scenario.Name, Completed / Duration, Latencies.GetPercentileMs(50.), Latencies.GetPercentileMs(99.), BytesReceived / Duration / (1024. * 1024.));
+
+	Results.Add(MakeShared<FJsonValueObject>(Result));
+}
@@ -0,0 +1,136 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpRequest.h"
+#include "BlueprintHttpNodes.h"
+#include "HttpBenchmarkUtils.h"
+#include "HttpLoopbackBenchmark.generated.h"
+
+class UHttpLoopbackBenchmark;
+class FHttpLoopbackServer;
+
+/**
+ *  The plugin path a benchmark scenario drives.
+ **/
+enum class EHttpBenchmarkPath : uint8
+{
+	Request,
+	SendProxy,
+	DownloadProxy
+};
+
+struct FHttpBenchmarkScenario
+{
+	FString Name;
+	EHttpBenchmarkPath Path = EHttpBenchmarkPath::Request;
+
+	/* Route and query on the loopback server. */
+	FString Route;
+
+	int32 RequestCount = 0;
+	int32 Concurrency  = 1;
+
+	/* Warm-up scenarios are run but not reported. */
+	bool bReport = true;
+};
+
+/**
+ *  Listens to a single benchmarked request, whichever path it goes through,
+ *  and keeps the request or proxy alive until it finishes.
+ **/
+UCLASS(Transient)
+class UHttpBenchmarkProbe final : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION()
+	void OnRequestComplete(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	UFUNCTION()
+	void OnProxyResponse(const int32 ResponseCode, const FHeaders& Headers, const FString& ContentType, const FString& Content, const float TimeElapsed, const EBlueprintHttpRequestStatus ConnectionStatus, const int32 BytesSent, const int32 BytesReceived);
+
+	UFUNCTION()
+	void OnProxyError(const int32 ResponseCode, const FHeaders& Headers, const FString& ContentType, const FString& Content, const float TimeElapsed, const EBlueprintHttpRequestStatus ConnectionStatus, const int32 BytesSent, const int32 BytesReceived);
+
+	UFUNCTION()
+	void OnFileDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UFUNCTION()
+	void OnFileDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UPROPERTY()
+	UObject* Target;
+
+	UPROPERTY()
+	UHttpLoopbackBenchmark* Owner;
+
+	FString TempFile;
+	double  StartTime;
+};
+
+/**
+ *  End-to-end benchmark of the plugin against a local HTTP server.
+ *  Drives the real UHttpRequest, USendHttpRequestProxy and UHttpDownloadFileProxy
+ *  paths and writes requests/sec, latency percentiles, RSS growth and GC cost as JSON.
+ *
+ *  Run it headless with:
+ *  UnrealEditor-Cmd BdeBexpo.uproject -game -nullrhi -unattended -ExecCmds="http.Bench.Loopback Quit"
+ **/
+UCLASS(Transient)
+class UHttpLoopbackBenchmark final : public UObject
+{
+	GENERATED_BODY()
+public:
+	UHttpLoopbackBenchmark();
+
+	/**
+	 * Starts the benchmark. Arguments:
+	 *   Port=<N>          Port of the loopback server (default 18089).
+	 *   Scenarios=<A,B>   Only run the listed scenarios.
+	 *   Scale=<F>         Multiplies the request counts.
+	 *   Out=<Path>        Where to write the JSON report.
+	 *   Quit              Exits the process once done, with a non-zero code on failures.
+	 **/
+	static void Run(const TArray<FString>& Args);
+
+	void OnProbeFinished(UHttpBenchmarkProbe* const Probe, const bool bSucceeded, const int64 Bytes);
+
+private:
+	bool Start(const TArray<FString>& Args);
+	void Finish();
+
+	bool Tick(float DeltaTime);
+
+	void StartScenario();
+	void IssueRequest();
+	void FinishScenario();
+
+	UPROPERTY()
+	TArray<UHttpBenchmarkProbe*> ActiveProbes;
+
+	TArray<FHttpBenchmarkScenario> Scenarios;
+	int32 ScenarioIndex;
+
+	int32 Issued;
+	int32 Completed;
+	int32 Failed;
+	int64 BytesReceived;
+	double ScenarioStartTime;
+
+	FHttpBenchmarkSamples        Latencies;
+	FHttpBenchmarkResourceProbe  ResourceProbe;
+
+	TArray<TSharedPtr<class FJsonValue>> Results;
+
+	uint32  Port;
+	FString OutPath;
+	bool    bQuitWhenDone;
+	bool    bAnyFailure;
+
+	TSharedPtr<FHttpLoopbackServer> Server;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
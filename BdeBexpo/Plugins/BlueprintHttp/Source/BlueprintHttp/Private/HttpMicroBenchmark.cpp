@@ -0,0 +1,495 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "CoreMinimal.h"
+
+#if WITH_BLUEPRINTHTTP_BENCHMARKS
+
+#include "BlueprintHttpLibrary.h"
+#include "HttpBenchmarkUtils.h"
+#include "HttpHeaderUtils.h"
+#include "HttpBase64.h"
+#include "Http.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+/**
+ *  Microbenchmarks of the UBlueprintHttpLibrary helpers that end up in Blueprint loops.
+ *
+ *  Each case is run across several input sizes. Its output is first checked against
+ *  a reference implementation, then timed, and the time per call is compared to the
+ *  baseline stored in the plugin's Resources/Benchmarks folder for the current platform.
+ *  With Quit, the run gates a build: mismatches, regressions and cases without a baseline fail it.
+ *  No baseline ships with the plugin, it's made with UpdateBaseline on the machine that runs the gate.
+ *
+ *  Usage: http.Bench.Helpers [Filter=<Substring>] [Tolerance=0.25] [UpdateBaseline] [Out=<Path>] [Quit]
+ **/
+namespace BlueprintHttpMicroBenchmark
+{
+	/* Keeps the optimizer from discarding the results of the benchmarked calls. */
+	static volatile int64 GSink = 0;
+
+	struct FCase
+	{
+		FString Name;
+		int32   Size;
+
+		/* Performs one call of the benchmarked helper. */
+		TFunction<void()> Run;
+
+		/* Returns an empty string when the helper's output matches the reference. */
+		TFunction<FString()> Validate;
+	};
+
+	static FString MakeText(const int32 Length)
+	{
+		// Mix of characters that are kept as-is and characters that must be escaped.
+		static const TCHAR Alphabet[] = TEXT("abcdefghijklmnopqrstuvwxyz0123456789-_.~ &=?/+%\u00e9\u00e8");
+
+		FString Text;
+		Text.Reserve(Length);
+		for (int32 i = 0; i < Length; ++i)
+		{
+			Text.AppendChar(Alphabet[(i * 7) % (UE_ARRAY_COUNT(Alphabet) - 1)]);
+		}
+
+		return Text;
+	}
+
+	static TArray<uint8> MakeBytes(const int32 Length)
+	{
+		TArray<uint8> Bytes;
+		Bytes.SetNumUninitialized(Length);
+		for (int32 i = 0; i < Length; ++i)
+		{
+			Bytes[i] = static_cast<uint8>(i * 131 + 7);
+		}
+
+		return Bytes;
+	}
+
+	static TMap<FString, FString> MakeParameters(const int32 Count)
+	{
+		TMap<FString, FString> Parameters;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Parameters.Add(FString::Printf(TEXT("param_%d"), i), MakeText(16));
+		}
+
+		return Parameters;
+	}
+
+	static TArray<FString> MakeRawHeaders(const int32 Count)
+	{
+		TArray<FString> Headers;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Headers.Add(FString::Printf(TEXT("X-Header-%d: value-%d; charset=utf-8"), i, i));
+		}
+
+		return Headers;
+	}
+
+	/* The implementation AddParametersToUrl had when the harness was written. */
+	static FString ReferenceAddParametersToUrl(FString InUrl, const TMap<FString, FString>& Parameters)
+	{
+		if (Parameters.Num() < 1)
+		{
+			return InUrl;
+		}
+
+		InUrl += TEXT("?");
+
+		int32 i = 0;
+		for (const auto& Pair : Parameters)
+		{
+			InUrl += FPlatformHttp::UrlEncode(Pair.Key) + TEXT("=") + FPlatformHttp::UrlEncode(Pair.Value);
+			if (++i != Parameters.Num())
+			{
+				InUrl += TEXT("&");
+			}
+		}
+
+		return InUrl;
+	}
+
+	static FString Mismatch(const TCHAR* const What)
+	{
+		return FString::Printf(TEXT("Output differs from the reference: %s."), What);
+	}
+
+	static TArray<FCase> MakeCases()
+	{
+		TArray<FCase> Cases;
+
+		for (const int32 Size : { 16, 256, 4096, 65536 })
+		{
+			const FString Text = MakeText(Size);
+			const FString Encoded = FPlatformHttp::UrlEncode(Text);
+
+			Cases.Add({ TEXT("UrlEncodeString"), Size,
+				[Text]() { GSink += UBlueprintHttpLibrary::UrlEncodeString(Text).Len(); },
+				[Text, Encoded]() { return UBlueprintHttpLibrary::UrlEncodeString(Text) == Encoded ? FString() : Mismatch(TEXT("UrlEncode")); } });
+
+			Cases.Add({ TEXT("UrlDecodeString"), Size,
+				[Encoded]() { GSink += UBlueprintHttpLibrary::UrlDecodeString(Encoded).Len(); },
+				[Encoded]() { return UBlueprintHttpLibrary::UrlDecodeString(Encoded) == FPlatformHttp::UrlDecode(Encoded) ? FString() : Mismatch(TEXT("UrlDecode")); } });
+
+			const TArray<uint8> Bytes = MakeBytes(Size);
+
+			Cases.Add({ TEXT("EncodeToBase64Binary"), Size,
+				[Bytes]() { FString Out; UBlueprintHttpLibrary::EncodeToBase64Binary(Bytes, Out); GSink += Out.Len(); },
+				[Bytes]() { FString Out; UBlueprintHttpLibrary::EncodeToBase64Binary(Bytes, Out); return Out == FBase64::Encode(Bytes) ? FString() : Mismatch(TEXT("Base64 encode")); } });
+
+			const FString Base64 = FBase64::Encode(Bytes);
+
+			Cases.Add({ TEXT("DecodeToBase64Binary"), Size,
+				[Base64]() { TArray<uint8> Out; UBlueprintHttpLibrary::DecodeToBase64Binary(Base64, Out); GSink += Out.Num(); },
+				[Base64, Bytes]() { TArray<uint8> Out; return UBlueprintHttpLibrary::DecodeToBase64Binary(Base64, Out) && Out == Bytes ? FString() : Mismatch(TEXT("Base64 decode")); } });
+
+			TArray<uint8> UrlPayload;
+			UrlPayload.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8(*Encoded)), Encoded.Len());
+
+			Cases.Add({ TEXT("IsUrlEncoded"), Size,
+				[UrlPayload]() { GSink += UBlueprintHttpLibrary::IsUrlEncoded(UrlPayload); },
+				[UrlPayload]() { return UBlueprintHttpLibrary::IsUrlEncoded(UrlPayload) == FPlatformHttp::IsURLEncoded(UrlPayload) ? FString() : Mismatch(TEXT("IsUrlEncoded")); } });
+		}
+
+		// Camera captures and embedded images, compared with the scalar FBase64 to show the speedup of the platform's kernel.
+		for (const int32 Size : { 4096, 65536, 1 << 20, 8 << 20 })
+		{
+			const TArray<uint8> Bytes = MakeBytes(Size);
+			const FString Base64 = FBase64::Encode(Bytes);
+
+			if (Size > 65536)
+			{
+				Cases.Add({ TEXT("EncodeToBase64Binary"), Size,
+					[Bytes]() { FString Out; UBlueprintHttpLibrary::EncodeToBase64Binary(Bytes, Out); GSink += Out.Len(); },
+					[Bytes, Base64]() { FString Out; UBlueprintHttpLibrary::EncodeToBase64Binary(Bytes, Out); return Out == Base64 ? FString() : Mismatch(TEXT("Base64 encode")); } });
+
+				Cases.Add({ TEXT("DecodeToBase64Binary"), Size,
+					[Base64]() { TArray<uint8> Out; UBlueprintHttpLibrary::DecodeToBase64Binary(Base64, Out); GSink += Out.Num(); },
+					[Base64, Bytes]() { TArray<uint8> Out; return UBlueprintHttpLibrary::DecodeToBase64Binary(Base64, Out) && Out == Bytes ? FString() : Mismatch(TEXT("Base64 decode")); } });
+			}
+
+			Cases.Add({ TEXT("FBase64::Encode"), Size,
+				[Bytes]() { GSink += FBase64::Encode(Bytes).Len(); },
+				[]() { return FString(); } });
+
+			Cases.Add({ TEXT("FBase64::Decode"), Size,
+				[Base64]() { TArray<uint8> Out; FBase64::Decode(Base64, Out); GSink += Out.Num(); },
+				[]() { return FString(); } });
+
+			// Preallocated output, as done when the buffer is reused between captures.
+			TSharedRef<TArray<ANSICHAR>> Text = MakeShared<TArray<ANSICHAR>>();
+			Text->SetNumUninitialized(FHttpBase64::GetEncodedLength(Size));
+
+			Cases.Add({ TEXT("FHttpBase64::Encode (Preallocated)"), Size,
+				[Bytes, Text]() { GSink += FHttpBase64::Encode(Bytes.GetData(), Bytes.Num(), Text->GetData()); },
+				[Bytes, Text, Base64]()
+				{
+					FHttpBase64::Encode(Bytes.GetData(), Bytes.Num(), Text->GetData());
+					return FString(Text->Num(), Text->GetData()) == Base64 ? FString() : Mismatch(TEXT("Base64 encode into preallocated text"));
+				} });
+
+			TSharedRef<TArray<uint8>> Decoded = MakeShared<TArray<uint8>>();
+			Decoded->SetNumUninitialized(FHttpBase64::GetMaxDecodedSize(Base64.Len()));
+
+			Cases.Add({ TEXT("FHttpBase64::Decode (Preallocated)"), Size,
+				[Text, Decoded]() { int64 Written = 0; FHttpBase64::Decode(Text->GetData(), Text->Num(), Decoded->GetData(), Written); GSink += Written; },
+				[Text, Decoded, Bytes]()
+				{
+					int64 Written = 0;
+					return FHttpBase64::Decode(Text->GetData(), Text->Num(), Decoded->GetData(), Written) && Written == Bytes.Num()
+						&& FMemory::Memcmp(Decoded->GetData(), Bytes.GetData(), Written) == 0 ? FString() : Mismatch(TEXT("Base64 decode into preallocated buffer"));
+				} });
+		}
+
+		for (const int32 Count : { 1, 8, 64, 512 })
+		{
+			const FString Url = TEXT("https://api.example.com/v1/projects");
+			const TMap<FString, FString> Parameters = MakeParameters(Count);
+
+			Cases.Add({ TEXT("AddParametersToUrl"), Count,
+				[Url, Parameters]() { GSink += UBlueprintHttpLibrary::AddParametersToUrl(Url, Parameters).Len(); },
+				[Url, Parameters]() { return UBlueprintHttpLibrary::AddParametersToUrl(Url, Parameters) == ReferenceAddParametersToUrl(Url, Parameters) ? FString() : Mismatch(TEXT("AddParametersToUrl")); } });
+		}
+
+		for (const int32 Count : { 4, 32, 256 })
+		{
+			const TArray<FString> RawHeaders = MakeRawHeaders(Count);
+
+			Cases.Add({ TEXT("GetAllHeaders"), Count,
+				[RawHeaders]() { GSink += BlueprintHttp::SplitHeaders(RawHeaders).Num(); },
+				[RawHeaders, Count]()
+				{
+					const TMap<FString, FString> Headers = BlueprintHttp::SplitHeaders(RawHeaders);
+					const FString* const Last = Headers.Find(FString::Printf(TEXT("X-Header-%d"), Count - 1));
+					return Headers.Num() == Count && Last && *Last == FString::Printf(TEXT("value-%d; charset=utf-8"), Count - 1) ? FString() : Mismatch(TEXT("GetAllHeaders"));
+				} });
+		}
+
+		{
+			static const int32 Codes[] = { 200, 204, 304, 404, 418, 503, 799 };
+
+			Cases.Add({ TEXT("HttpResponseCodeToString"), UE_ARRAY_COUNT(Codes),
+				[]() { for (const int32 Code : Codes) { GSink += UBlueprintHttpLibrary::HttpResponseCodeToString(Code).Len(); } },
+				[]()
+				{
+					// Display names only hold the official text when editor metadata is available.
+					const UEnum* const CodeEnum = StaticEnum<EHttpResponseCode>();
+					for (const int32 Code : Codes)
+					{
+						const EHttpResponseCode AsEnum = UBlueprintHttpLibrary::HttpResponseCodeToEnum(Code);
+						const FString Expected = AsEnum == EHttpResponseCode::CUknown
+							? FString::Printf(TEXT("%d Unofficial Response Code"), Code)
+							: CodeEnum->GetDisplayNameTextByValue(static_cast<int64>(AsEnum)).ToString();
+
+						if (UBlueprintHttpLibrary::HttpResponseCodeToString(Code) != Expected)
+						{
+							return Mismatch(TEXT("HttpResponseCodeToString"));
+						}
+					}
+					return FString();
+				} });
+		}
+
+		{
+			constexpr int32 MimeCount = static_cast<int32>(EHttpMimeType::_7z) + 1;
+
+			Cases.Add({ TEXT("CreateMimeType"), MimeCount,
+				[]() { for (int32 i = 0; i < MimeCount; ++i) { GSink += UBlueprintHttpLibrary::CreateMimeType(static_cast<EHttpMimeType>(i)).Len(); } },
+				[]()
+				{
+					return UBlueprintHttpLibrary::CreateMimeType(EHttpMimeType::url)  == TEXT("application/x-www-form-urlencoded")
+						&& UBlueprintHttpLibrary::CreateMimeType(EHttpMimeType::json) == TEXT("application/json")
+						&& UBlueprintHttpLibrary::CreateMimeType(EHttpMimeType::_7z)  == TEXT("application/x-7z-compressed")
+						&& UBlueprintHttpLibrary::CreateMimeType(static_cast<EHttpMimeType>(MimeCount)) == TEXT("INVALID_MIME_TYPE") ? FString() : Mismatch(TEXT("CreateMimeType"));
+				} });
+		}
+
+		return Cases;
+	}
+
+	/* Returns the median time of one call in nanoseconds. */
+	static double Measure(const FCase& Case)
+	{
+		constexpr double TargetBatchSeconds = 0.02;
+		constexpr int32  Batches = 7;
+
+		// Find how many calls fill a batch.
+		int64 Iterations = 1;
+		for (;;)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int64 i = 0; i < Iterations; ++i)
+			{
+				Case.Run();
+			}
+			if (FPlatformTime::Seconds() - Start >= TargetBatchSeconds || Iterations >= (int64(1) << 30))
+			{
+				break;
+			}
+			Iterations *= 2;
+		}
+
+		TArray<double> Timings;
+		for (int32 Batch = 0; Batch < Batches; ++Batch)
+		{
+			const uint64 Start = FPlatformTime::Cycles64();
+			for (int64 i = 0; i < Iterations; ++i)
+			{
+				Case.Run();
+			}
+			Timings.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e9 / Iterations);
+		}
+
+		Timings.Sort();
+		return Timings[Batches / 2];
+	}
+
+	static FString GetBaselinePath()
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("BlueprintHttp"));
+		const FString BaseDir = Plugin ? Plugin->GetBaseDir() : FPaths::Combine(FPaths::ProjectPluginsDir(), TEXT("BlueprintHttp"));
+
+		return FPaths::Combine(BaseDir, TEXT("Resources"), TEXT("Benchmarks"), FString::Printf(TEXT("HelperBaselines-%s.json"), FPlatformProperties::IniPlatformName()));
+	}
+
+	static TSharedPtr<FJsonObject> LoadBaselines()
+	{
+		FString Json;
+		TSharedPtr<FJsonObject> Baselines;
+
+		if (FFileHelper::LoadFileToString(Json, *GetBaselinePath()))
+		{
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Baselines);
+		}
+
+		return Baselines;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		FString Filter;
+		FString OutPath;
+		float   Tolerance		= 0.25f;
+		bool	bUpdateBaseline = false;
+		bool	bQuit			= false;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Filter="),    Filter);
+			FParse::Value(*Arg, TEXT("Tolerance="), Tolerance);
+			FParse::Value(*Arg, TEXT("Out="),       OutPath, /* bShouldStopOnSeparator */ false);
+
+			bUpdateBaseline |= Arg.Equals(TEXT("UpdateBaseline"), ESearchCase::IgnoreCase);
+			bQuit           |= Arg.Equals(TEXT("Quit"),           ESearchCase::IgnoreCase);
+		}
+
+		const TSharedPtr<FJsonObject> Baselines = LoadBaselines();
+		const TSharedPtr<FJsonObject>* BaselineCases = nullptr;
+		if (Baselines)
+		{
+			Baselines->TryGetObjectField(TEXT("cases"), BaselineCases);
+		}
+
+		if (!BaselineCases && !bUpdateBaseline)
+		{
+			UE_LOG(LogHttp, Error, TEXT("Benchmark: No baseline at \"%s\", regressions can't be detected. Run with UpdateBaseline on the reference machine to create it."),
+				*FPaths::ConvertRelativePathToFull(GetBaselinePath()));
+		}
+
+		const TSharedRef<FJsonObject> Report		= MakeShared<FJsonObject>();
+		const TSharedRef<FJsonObject> ReportCases	= MakeShared<FJsonObject>();
+
+		int32 Mismatches		= 0;
+		int32 Regressions		= 0;
+		int32 MissingBaselines	= 0;
+
+		for (const FCase& Case : MakeCases())
+		{
+			const FString Key = FString::Printf(TEXT("%s/%d"), *Case.Name, Case.Size);
+
+			if (!Filter.IsEmpty() && !Key.Contains(Filter))
+			{
+				continue;
+			}
+
+			const TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+
+			const FString Error = Case.Validate();
+			if (!Error.IsEmpty())
+			{
+				UE_LOG(LogHttp, Error, TEXT("Benchmark: %s: %s"), *Key, *Error);
+				Result->SetStringField(TEXT("error"), Error);
+				ReportCases->SetObjectField(Key, Result);
+				++Mismatches;
+				continue;
+			}
+
+			const double Nanoseconds = Measure(Case);
+			Result->SetNumberField(TEXT("ns_per_call"), Nanoseconds);
+
+			double Baseline = 0.;
+			if (BaselineCases && (*BaselineCases)->TryGetNumberField(Key, Baseline) && Baseline > 0.)
+			{
+				const double Ratio = Nanoseconds / Baseline;
+				const bool bRegressed = Ratio > 1. + Tolerance;
+
+				Result->SetNumberField(TEXT("baseline_ns_per_call"), Baseline);
+				Result->SetNumberField(TEXT("ratio"),                Ratio);
+				Result->SetBoolField  (TEXT("regressed"),            bRegressed);
+
+				Regressions += bRegressed ? 1 : 0;
+
+				UE_LOG(LogHttp, Display, TEXT("Benchmark: %-32s %12.1f ns  (baseline %12.1f ns, x%.2f)%s"),
+					*Key, Nanoseconds, Baseline, Ratio, bRegressed ? TEXT("  REGRESSION") : TEXT(""));
+			}
+			else
+			{
+				++MissingBaselines;
+
+				UE_LOG(LogHttp, Display, TEXT("Benchmark: %-32s %12.1f ns  (no baseline)"), *Key, Nanoseconds);
+			}
+
+			ReportCases->SetObjectField(Key, Result);
+		}
+
+		Report->SetStringField(TEXT("suite"),       TEXT("helpers"));
+		Report->SetStringField(TEXT("platform"),    FPlatformProperties::IniPlatformName());
+		Report->SetStringField(TEXT("base64"),      FHttpBase64::GetKernelName());
+		Report->SetStringField(TEXT("date"),        FDateTime::UtcNow().ToIso8601());
+		Report->SetNumberField(TEXT("tolerance"),   Tolerance);
+		Report->SetNumberField(TEXT("mismatches"),  Mismatches);
+		Report->SetNumberField(TEXT("regressions"), Regressions);
+		Report->SetNumberField(TEXT("missing_baselines"), MissingBaselines);
+		Report->SetObjectField(TEXT("cases"),       ReportCases);
+
+		BlueprintHttpBenchmark::WriteReport(Report, TEXT("Helpers"), OutPath);
+
+		if (bUpdateBaseline && Mismatches == 0)
+		{
+			// Merge so a filtered run only updates its own cases.
+			const TSharedRef<FJsonObject> NewBaselines  = MakeShared<FJsonObject>();
+			const TSharedRef<FJsonObject> NewCases      = MakeShared<FJsonObject>();
+
+			if (BaselineCases)
+			{
+				NewCases->Values = (*BaselineCases)->Values;
+			}
+
+			for (const auto& Pair : ReportCases->Values)
+			{
+				NewCases->SetNumberField(Pair.Key, Pair.Value->AsObject()->GetNumberField(TEXT("ns_per_call")));
+			}
+
+			NewBaselines->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+			NewBaselines->SetStringField(TEXT("date"),     FDateTime::UtcNow().ToIso8601());
+			NewBaselines->SetObjectField(TEXT("cases"),    NewCases);
+
+			BlueprintHttpBenchmark::WriteReport(NewBaselines, FString(), GetBaselinePath());
+		}
+
+		UE_LOG(LogHttp, Display, TEXT("Benchmark: Helpers done, %d mismatches, %d regressions."), Mismatches, Regressions);
+
+		// A case without a baseline can't regress, so the gate would pass without measuring anything.
+		const int32 Ungated = bUpdateBaseline ? 0 : MissingBaselines;
+
+		if (Ungated > 0)
+		{
+			UE_LOG(LogHttp, Error, TEXT("Benchmark: %d cases have no baseline for %s and weren't gated."), Ungated, FPlatformProperties::IniPlatformName());
+		}
+
+		if (bQuit)
+		{
+			if (Mismatches > 0 || Regressions > 0 || Ungated > 0)
+			{
+				FPlatformMisc::RequestExitWithStatus(false, 1);
+			}
+			else
+			{
+				FPlatformMisc::RequestExit(false);
+			}
+		}
+	}
+}
+
+static FAutoConsoleCommand GHttpBenchHelpersCommand(
+	TEXT("http.Bench.Helpers"),
+	TEXT("Microbenchmarks the UBlueprintHttpLibrary helpers and compares them to the stored baselines. ")
+	TEXT("Args: [Filter=<Substring>] [Tolerance=0.25] [UpdateBaseline] [Out=<Path>] [Quit]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BlueprintHttpMicroBenchmark::Run)
+);
+
+#endif // WITH_BLUEPRINTHTTP_BENCHMARKS
@@ -0,0 +1,405 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpNetworkSimulator.h"
+#include "HttpTransport.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "Http.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+	const FName CustomProfileName = TEXT("Custom");
+
+	struct FSimulatorState
+	{
+		FName ActiveProfile;
+		FHttpNetworkConditions Conditions;
+		TMap<FName, FHttpNetworkConditions> Profiles;
+		FRandomStream Random;
+
+		FSimulatorState()
+		{
+			Random.GenerateNewSeed();
+
+			auto AddProfile = [this](const TCHAR* const Name, const float Latency, const float Jitter, const float Download, const float Upload, const float FailureRate, const float StallRate, const float StallDuration)
+			{
+				FHttpNetworkConditions& Profile = Profiles.Add(Name);
+				Profile.LatencyMs				= Latency;
+				Profile.JitterMs				= Jitter;
+				Profile.DownloadDelayKBps		= Download;
+				Profile.UploadDelayKBps			= Upload;
+				Profile.FailureRate				= FailureRate;
+				Profile.CompletionStallRate		= StallRate;
+				Profile.CompletionStallDuration = StallDuration;
+			};
+
+			//		   Name				Latency	Jitter	Down	Up		Fail	Stall	StallTime
+			// Down and Up only delay the start and completion of the requests.
+			AddProfile(TEXT("ExpoWifi"),	150.f,	250.f,	200.f,	50.f,	0.03f,	0.05f,	3.f);
+			AddProfile(TEXT("3G"),			300.f,	100.f,	96.f,	32.f,	0.01f,	0.02f,	2.f);
+			AddProfile(TEXT("Edge"),		650.f,	200.f,	30.f,	12.f,	0.02f,	0.05f,	4.f);
+			AddProfile(TEXT("Lossy"),		50.f,	20.f,	0.f,	0.f,	0.2f,	0.1f,	5.f);
+			AddProfile(TEXT("HighLatency"),	800.f,	0.f,	0.f,	0.f,	0.f,	0.f,	0.f);
+		}
+	};
+
+	FSimulatorState& GetState()
+	{
+		static FSimulatorState State;
+		return State;
+	}
+
+	/* Seconds it would take to move Bytes at KBps, or zero when unlimited. */
+	float GetTransferTime(const int64 Bytes, const float KBps)
+	{
+		return KBps > 0.f ? static_cast<float>(Bytes) / (KBps * 1024.f) : 0.f;
+	}
+}
+
+/**
+ *  Applies the conditions captured when the request started on top of another transport.
+ *  One instance is created per request.
+ **/
+class FHttpSimulatedTransport final : public IHttpTransport, public TSharedFromThis<FHttpSimulatedTransport>
+{
+public:
+	FHttpSimulatedTransport(const TSharedRef<IHttpTransport>& InInner, const FHttpNetworkConditions& InConditions)
+		: Inner(InInner)
+		, Conditions(InConditions)
+		, Phase(EPhase::Idle)
+		, StartTime(0.)
+		, Status(EBlueprintHttpRequestStatus::Failed)
+		, bConnectedSuccessfully(false)
+	{}
+
+	virtual ~FHttpSimulatedTransport()
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(Ticker);
+	}
+
+	//~ Begin IHttpTransport Interface
+	virtual bool ProcessRequest(UHttpRequest* const Request) override
+	{
+		if (Phase != EPhase::Idle)
+		{
+			return false;
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		Phase	  = EPhase::Connecting;
+
+		const bool  bFails = GetState().Random.FRand() < Conditions.FailureRate;
+		const float Delay  = GetHalfLatency() + GetTransferTime(Request->GetNativeRequest()->GetContentLength(), Conditions.UploadDelayKBps);
+
+		Schedule(Request, Delay, [this, bFails](UHttpRequest* const Request)
+		{
+			if (bFails)
+			{
+				UE_LOG(LogHttp, Verbose, TEXT("NetSim: Dropping request to \"%s\"."), *Request->GetURL());
+				Fail(Request, EBlueprintHttpRequestStatus::Failed_ConnectionError);
+				return;
+			}
+
+			Phase = EPhase::InFlight;
+
+			if (!Inner->ProcessRequest(Request))
+			{
+				Fail(Request, EBlueprintHttpRequestStatus::Failed);
+			}
+		});
+
+		return true;
+	}
+
+	virtual void CancelRequest(UHttpRequest* const Request) override
+	{
+		if (Phase == EPhase::InFlight)
+		{
+			Inner->CancelRequest(Request);
+		}
+		else if (Phase == EPhase::Connecting)
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(Ticker);
+			Ticker.Reset();
+
+			Fail(Request, EBlueprintHttpRequestStatus::Failed);
+		}
+		else if (Phase == EPhase::Holding)
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(Ticker);
+			Ticker.Reset();
+
+			// The inner transport finished the exchange, only its delivery was held. It must still see it complete.
+			Inner->OnRequestCompleted(Request, Response.Get(), bConnectedSuccessfully);
+			Response.Reset();
+
+			Fail(Request, EBlueprintHttpRequestStatus::Failed);
+		}
+	}
+
+	virtual bool DeferCompletion(UHttpRequest* const Request, UHttpResponse* const InResponse, const bool bInConnectedSuccessfully) override
+	{
+		if (Phase != EPhase::InFlight)
+		{
+			return false;
+		}
+
+		const bool bStalls = GetState().Random.FRand() < Conditions.CompletionStallRate;
+
+		const float Delay = GetHalfLatency()
+			+ GetTransferTime(GetReceivedBytes(InResponse), Conditions.DownloadDelayKBps)
+			+ (bStalls ? Conditions.CompletionStallDuration : 0.f);
+
+		if (Delay <= 0.f)
+		{
+			Phase = EPhase::Delivering;
+			return false;
+		}
+
+		if (bStalls)
+		{
+			UE_LOG(LogHttp, Verbose, TEXT("NetSim: Stalling request to \"%s\" for %.2fs."), *Request->GetURL(), Conditions.CompletionStallDuration);
+		}
+
+		Phase				   = EPhase::Holding;
+		Response			   = TStrongObjectPtr<UHttpResponse>(InResponse);
+		Status				   = Request->GetStatus();
+		bConnectedSuccessfully = bInConnectedSuccessfully;
+
+		Schedule(Request, Delay, [this](UHttpRequest* const Request)
+		{
+			Phase = EPhase::Delivering;
+
+			UHttpResponse* const HeldResponse = Response.Get();
+			Response.Reset();
+
+			Request->CompleteFromTransport(HeldResponse, bConnectedSuccessfully, Status, GetElapsedTime());
+		});
+
+		return true;
+	}
+
+	virtual void OnRequestCompleted(UHttpRequest* const Request, UHttpResponse* const InResponse, const bool bInConnectedSuccessfully) override
+	{
+		// Requests dropped by the simulator never reached the inner transport.
+		if (Phase == EPhase::Delivering)
+		{
+			Inner->OnRequestCompleted(Request, InResponse, bInConnectedSuccessfully);
+		}
+
+		Phase = EPhase::Done;
+	}
+
+	virtual EHttpTransportMode GetMode() const override
+	{
+		return Inner->GetMode();
+	}
+	//~ End IHttpTransport Interface
+
+private:
+	enum class EPhase : uint8
+	{
+		Idle,
+		Connecting,
+		InFlight,
+		Holding,
+		Delivering,
+		Done
+	};
+
+	float GetHalfLatency() const
+	{
+		return (Conditions.LatencyMs * 0.5f + GetState().Random.FRandRange(0.f, Conditions.JitterMs)) / 1000.f;
+	}
+
+	float GetElapsedTime() const
+	{
+		return static_cast<float>(FPlatformTime::Seconds() - StartTime);
+	}
+
+	static int64 GetReceivedBytes(const UHttpResponse* const InResponse)
+	{
+		if (!InResponse)
+		{
+			return 0;
+		}
+
+		return InResponse->GetNativeResponse() && !InResponse->GetBody() ? InResponse->GetNativeResponse()->GetContent().Num() : InResponse->GetContentLength();
+	}
+
+	void Fail(UHttpRequest* const Request, const EBlueprintHttpRequestStatus FailStatus)
+	{
+		Phase = EPhase::Done;
+
+		Request->CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, FailStatus, GetElapsedTime());
+	}
+
+	/* Calls Callback after Delay seconds, keeping this transport alive until then. */
+	void Schedule(UHttpRequest* const Request, const float Delay, TFunction<void(UHttpRequest* const)> Callback)
+	{
+		const TWeakObjectPtr<UHttpRequest> WeakRequest = Request;
+
+		Ticker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Self = AsShared(), WeakRequest, Callback = MoveTemp(Callback)](float)
+		{
+			Self->Ticker.Reset();
+
+			if (UHttpRequest* const Request = WeakRequest.Get())
+			{
+				Callback(Request);
+			}
+
+			return false;
+		}), FMath::Max(Delay, 0.f));
+	}
+
+	const TSharedRef<IHttpTransport> Inner;
+	const FHttpNetworkConditions Conditions;
+
+	EPhase Phase;
+	double StartTime;
+
+	FTSTicker::FDelegateHandle Ticker;
+
+	// The held response and how it completed.
+	TStrongObjectPtr<UHttpResponse> Response;
+	EBlueprintHttpRequestStatus Status;
+	bool bConnectedSuccessfully;
+};
+
+bool FHttpNetworkSimulator::SetProfile(const FName ProfileName)
+{
+	if (ProfileName.IsNone())
+	{
+		Disable();
+		return true;
+	}
+
+	FSimulatorState& State = GetState();
+
+	const FHttpNetworkConditions* const Profile = State.Profiles.Find(ProfileName);
+	if (!Profile)
+	{
+		UE_LOG(LogHttp, Warning, TEXT("NetSim: Unknown profile \"%s\"."), *ProfileName.ToString());
+		return false;
+	}
+
+	State.ActiveProfile = ProfileName;
+	State.Conditions	= *Profile;
+
+	UE_LOG(LogHttp, Log, TEXT("NetSim: Simulating \"%s\"."), *ProfileName.ToString());
+
+	return true;
+}
+
+void FHttpNetworkSimulator::SetConditions(const FHttpNetworkConditions& Conditions)
+{
+	FSimulatorState& State = GetState();
+
+	State.ActiveProfile = CustomProfileName;
+	State.Conditions	= Conditions;
+}
+
+void FHttpNetworkSimulator::Disable()
+{
+	FSimulatorState& State = GetState();
+
+	if (!State.ActiveProfile.IsNone())
+	{
+		UE_LOG(LogHttp, Log, TEXT("NetSim: Disabled."));
+	}
+
+	State.ActiveProfile = NAME_None;
+	State.Conditions	= FHttpNetworkConditions();
+}
+
+bool FHttpNetworkSimulator::IsEnabled()
+{
+	return !GetState().ActiveProfile.IsNone();
+}
+
+FName FHttpNetworkSimulator::GetProfileName()
+{
+	return GetState().ActiveProfile;
+}
+
+FHttpNetworkConditions FHttpNetworkSimulator::GetConditions()
+{
+	return GetState().Conditions;
+}
+
+void FHttpNetworkSimulator::RegisterProfile(const FName ProfileName, const FHttpNetworkConditions& Conditions)
+{
+	FSimulatorState& State = GetState();
+
+	State.Profiles.Add(ProfileName, Conditions);
+
+	if (State.ActiveProfile == ProfileName)
+	{
+		State.Conditions = Conditions;
+	}
+}
+
+TArray<FName> FHttpNetworkSimulator::GetProfileNames()
+{
+	TArray<FName> Names;
+	GetState().Profiles.GetKeys(Names);
+	return Names;
+}
+
+void FHttpNetworkSimulator::SetSeed(const int32 Seed)
+{
+	GetState().Random.Initialize(Seed);
+}
+
+TSharedRef<IHttpTransport> FHttpNetworkSimulator::Wrap(const TSharedRef<IHttpTransport>& Inner)
+{
+	return MakeShared<FHttpSimulatedTransport>(Inner, GetState().Conditions);
+}
+
+static FAutoConsoleCommand GHttpNetSimProfileCommand(
+	TEXT("http.NetSim.Profile"),
+	TEXT("Simulates network conditions for BlueprintHttp requests. Args: <ProfileName|Off>. Without argument, lists the profiles."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	if (Args.Num() == 0)
+	{
+		const FHttpNetworkConditions Current = FHttpNetworkSimulator::GetConditions();
+
+		UE_LOG(LogHttp, Display, TEXT("NetSim: Active profile: %s (latency %.0fms, jitter %.0fms, download delay at %.0fKB/s, upload delay at %.0fKB/s, failures %.0f%%, completion stalls %.0f%% for %.1fs)."),
+			*FHttpNetworkSimulator::GetProfileName().ToString(), Current.LatencyMs, Current.JitterMs, Current.DownloadDelayKBps, Current.UploadDelayKBps,
+			Current.FailureRate * 100.f, Current.CompletionStallRate * 100.f, Current.CompletionStallDuration);
+
+		for (const FName& Name : FHttpNetworkSimulator::GetProfileNames())
+		{
+			UE_LOG(LogHttp, Display, TEXT("NetSim:   %s"), *Name.ToString());
+		}
+		return;
+	}
+
+	if (Args[0] == TEXT("Off"))
+	{
+		FHttpNetworkSimulator::Disable();
+		return;
+	}
+
+	FHttpNetworkSimulator::SetProfile(*Args[0]);
+})
+);
+
+static FAutoConsoleCommand GHttpNetSimSeedCommand(
+	TEXT("http.NetSim.Seed"),
+	TEXT("Seeds the network simulator so that failures, stalls and jitter can be reproduced. Args: <Seed>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	if (Args.Num() > 0)
+	{
+		FHttpNetworkSimulator::SetSeed(FCString::Atoi(*Args[0]));
+	}
+})
+);
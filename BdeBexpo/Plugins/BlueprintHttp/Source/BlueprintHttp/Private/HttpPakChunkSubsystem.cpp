@@ -0,0 +1,682 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpPakChunkSubsystem.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "Http.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "IPlatformFilePak.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	/* Suffix of the files being downloaded. */
+	const TCHAR* const PartialFileSuffix = TEXT(".part");
+
+	FPakPlatformFile* GetPakPlatformFile()
+	{
+		return static_cast<FPakPlatformFile*>(FPlatformFileManager::Get().FindPlatformFile(FPakPlatformFile::GetTypeName()));
+	}
+
+	FString GetChunksDirectory()
+	{
+		return FPaths::ProjectPersistentDownloadDir() / TEXT("PakChunks");
+	}
+
+	/* Returns the path of the file relative to the chunks directory, which keys the index. */
+	FString GetRelativePath(const FName ChunkName, const FHttpPakChunkFile& File)
+	{
+		FString Path;
+		File.Url.Split(TEXT("?"), &Path, nullptr);
+
+		return ChunkName.ToString() / FPaths::GetCleanFilename(Path.IsEmpty() ? File.Url : Path);
+	}
+}
+
+void UHttpPakChunkDownload::OnRequestCompleted(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	const bool bValidResponse = bConnectedSuccessfully && Response && Response->GetResponseCode() < 400;
+
+	// Responses served by a transport don't go through the stream.
+	if (bValidResponse && FileWriter->Tell() == 0)
+	{
+		TArray<uint8> Content;
+		Response->GetContent(Content);
+		FileWriter->Serialize(Content.GetData(), Content.Num());
+	}
+
+	BytesReceived = FileWriter->Tell();
+
+	const bool bWritten = FileWriter->Close();
+
+	if (bValidResponse && !bWritten)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Failed to write \"%s\"."), *FileWriter->GetArchiveName());
+	}
+	else if (bConnectedSuccessfully && !bValidResponse)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Server responded with an invalid code: \"%d\"."), Response ? Response->GetResponseCode() : -1);
+	}
+
+	Request->SetResponseStream(nullptr);
+	FileWriter.Reset();
+
+	Owner->OnDownloadFinished(this, bValidResponse && bWritten);
+}
+
+void UHttpPakChunkDownload::OnRequestProgress(UHttpRequest* const InRequest, const int32 BytesSent, const int32 InBytesReceived)
+{
+	BytesReceived = InBytesReceived;
+	Owner->OnDownloadProgress(this);
+}
+
+void UHttpPakChunkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LoadIndex();
+}
+
+void UHttpPakChunkSubsystem::Deinitialize()
+{
+	for (UHttpPakChunkDownload* const Download : ActiveDownloads)
+	{
+		// The HTTP thread may still hold the file: a partial file left behind is replaced by the next download.
+		Download->Request->Abandon();
+		Download->FileWriter.Reset();
+
+		if (const FChunkState* const State = Chunks.Find(Download->ChunkName))
+		{
+			IFileManager::Get().Delete(*(GetFilePath(Download->ChunkName, State->Chunk.Files[Download->FileIndex]) + PartialFileSuffix), false, false, true);
+		}
+	}
+
+	ActiveDownloads.Reset();
+
+	// Mounted chunks stay mounted, their content may still be in use.
+	Chunks.Reset();
+
+	Super::Deinitialize();
+}
+
+void UHttpPakChunkSubsystem::RegisterChunk(const FHttpPakChunk& Chunk)
+{
+	FChunkState& State = Chunks.FindOrAdd(Chunk.Name);
+
+	if (State.bDownloading || !State.MountedPak.IsEmpty())
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Pak chunks: \"%s\" is in use and can't be registered again."), *Chunk.Name.ToString());
+		return;
+	}
+
+	State.Chunk = Chunk;
+}
+
+bool UHttpPakChunkSubsystem::RequestChunk(const FName ChunkName)
+{
+	FChunkState* const State = Chunks.Find(ChunkName);
+
+	if (!State)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: \"%s\" isn't registered."), *ChunkName.ToString());
+		return false;
+	}
+
+	if (!State->MountedPak.IsEmpty())
+	{
+		OnChunkMounted.Broadcast(ChunkName, true);
+		return true;
+	}
+
+	if (State->bDownloading)
+	{
+		return true;
+	}
+
+	State->bDownloading	   = true;
+	State->bAnyFailure	   = false;
+	State->BytesToDownload = 0;
+	State->BytesDownloaded = 0;
+	State->PendingFiles	   = 0;
+
+	TArray<int32> MissingFiles;
+
+	for (int32 FileIndex = 0; FileIndex < State->Chunk.Files.Num(); ++FileIndex)
+	{
+		const FHttpPakChunkFile& File = State->Chunk.Files[FileIndex];
+
+		// Files are only moved in place once verified, the index tells against which hash.
+		if (!IsFileVerified(State->Chunk, File))
+		{
+			MissingFiles.Add(FileIndex);
+			State->BytesToDownload += File.Size;
+		}
+	}
+
+	State->PendingFiles = MissingFiles.Num();
+
+	if (MissingFiles.IsEmpty())
+	{
+		Mount(*State);
+		return true;
+	}
+
+	UE_LOG(LogHttp, Log, TEXT("Pak chunks: Downloading %d files of \"%s\"."), MissingFiles.Num(), *ChunkName.ToString());
+
+	for (const int32 FileIndex : MissingFiles)
+	{
+		DownloadFile(*State, FileIndex);
+	}
+
+	return true;
+}
+
+void UHttpPakChunkSubsystem::DownloadFile(FChunkState& State, const int32 FileIndex)
+{
+	const FHttpPakChunkFile& File = State.Chunk.Files[FileIndex];
+
+	FHttpIntegrityCheck IntegrityCheck;
+
+	if (!File.Hash.IsEmpty())
+	{
+		IntegrityCheck.Algorithm	  = State.Chunk.HashAlgorithm;
+		IntegrityCheck.ExpectedDigest = File.Hash;
+	}
+	else
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Pak chunks: \"%s\" has no hash, it's mounted without being verified."), *File.Url);
+	}
+
+	const FString PartialFile = GetFilePath(State.Chunk.Name, File) + PartialFileSuffix;
+
+	UHttpPakChunkDownload* const Download = NewObject<UHttpPakChunkDownload>(this);
+
+	Download->Owner			= this;
+	Download->ChunkName		= State.Chunk.Name;
+	Download->FileIndex		= FileIndex;
+	Download->BytesReceived = 0;
+	Download->FileWriter	= TSharedPtr<FArchive, ESPMode::ThreadSafe>(IFileManager::Get().CreateFileWriter(*PartialFile));
+
+	// Paks are streamed to the disk instead of being held in memory until they are complete.
+	Download->Request = UHttpRequest::CreateRequest();
+	Download->Request->SetVerb			 (EHttpVerb::GET);
+	Download->Request->SetMimeType		 (EHttpMimeType::bin);
+	Download->Request->SetURL			 (File.Url);
+	Download->Request->SetIntegrityCheck (IntegrityCheck);
+	Download->Request->SetResponseStream (Download->FileWriter);
+
+	// The chunk progress comes from the requests, it's kept when the default policy is Off.
+	if (Download->Request->GetProgressPolicy().Reporting == EHttpProgressReporting::Off)
+	{
+		Download->Request->SetProgressPolicy(FHttpProgressPolicy());
+	}
+
+	Download->Request->OnRequestComplete.AddDynamic(Download, &UHttpPakChunkDownload::OnRequestCompleted);
+	Download->Request->OnRequestProgress.AddDynamic(Download, &UHttpPakChunkDownload::OnRequestProgress);
+
+	ActiveDownloads.Add(Download);
+
+	if (!Download->FileWriter)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Failed to create \"%s\"."), *FPaths::ConvertRelativePathToFull(PartialFile));
+		OnDownloadFinished(Download, false);
+	}
+	else if (!Download->Request->ProcessRequest())
+	{
+		Download->FileWriter.Reset();
+		OnDownloadFinished(Download, false);
+	}
+}
+
+void UHttpPakChunkSubsystem::OnDownloadProgress(UHttpPakChunkDownload* const Download)
+{
+	const FChunkState* const State = Chunks.Find(Download->ChunkName);
+
+	if (!State)
+	{
+		return;
+	}
+
+	int64 InFlightBytes = 0;
+
+	for (const UHttpPakChunkDownload* const Active : ActiveDownloads)
+	{
+		InFlightBytes += Active->ChunkName == Download->ChunkName ? Active->BytesReceived : 0;
+	}
+
+	OnChunkProgress.Broadcast(Download->ChunkName, State->BytesDownloaded + InFlightBytes, State->BytesToDownload);
+}
+
+void UHttpPakChunkSubsystem::OnDownloadFinished(UHttpPakChunkDownload* const Download, const bool bSucceeded)
+{
+	FChunkState* const State = Chunks.Find(Download->ChunkName);
+
+	if (ActiveDownloads.Remove(Download) == 0 || !State)
+	{
+		return;
+	}
+
+	const FHttpPakChunkFile& File = State->Chunk.Files[Download->FileIndex];
+
+	const FString RelativePath = GetRelativePath(Download->ChunkName, File);
+	const FString Destination  = GetFilePath(Download->ChunkName, File);
+	const FString PartialFile  = Destination + PartialFileSuffix;
+
+	State->BytesDownloaded += Download->BytesReceived;
+	--State->PendingFiles;
+
+	// Files that don't match their hash fail their download and are never written.
+	if (!bSucceeded)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Failed to download \"%s\"."), *File.Url);
+		IFileManager::Get().Delete(*PartialFile, false, false, true);
+		State->bAnyFailure = true;
+	}
+	else if (!IFileManager::Get().Move(*Destination, *PartialFile, true, true))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Failed to move \"%s\" in place."), *FPaths::ConvertRelativePathToFull(Destination));
+		IFileManager::Get().Delete(*PartialFile, false, false, true);
+		VerifiedFiles.Remove(RelativePath);
+		State->bAnyFailure = true;
+	}
+	// Files without a hash weren't verified and are never reused.
+	else if (File.Hash.IsEmpty())
+	{
+		VerifiedFiles.Remove(RelativePath);
+	}
+	else
+	{
+		VerifiedFiles.Add(RelativePath, { File.Hash, State->Chunk.HashAlgorithm });
+	}
+
+	if (State->PendingFiles > 0)
+	{
+		OnChunkProgress.Broadcast(Download->ChunkName, State->BytesDownloaded, State->BytesToDownload);
+	}
+	else
+	{
+		SaveIndex();
+
+		if (State->bAnyFailure)
+		{
+			Finish(*State, false);
+		}
+		else
+		{
+			Mount(*State);
+		}
+	}
+}
+
+void UHttpPakChunkSubsystem::Mount(FChunkState& State)
+{
+	const FHttpPakChunkFile* const PakFile = State.Chunk.Files.FindByPredicate([&State](const FHttpPakChunkFile& File)
+	{
+		return GetRelativePath(State.Chunk.Name, File).EndsWith(TEXT(".pak"));
+	});
+
+	FPakPlatformFile* const PakPlatformFile = GetPakPlatformFile();
+
+	if (!PakFile)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: \"%s\" has no .pak file."), *State.Chunk.Name.ToString());
+		Finish(State, false);
+	}
+	else if (!PakPlatformFile)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: \"%s\" can't be mounted without the pak platform file."), *State.Chunk.Name.ToString());
+		Finish(State, false);
+	}
+	// The .utoc and .ucas next to the .pak are mounted with it.
+	else if (!PakPlatformFile->Mount(*GetFilePath(State.Chunk.Name, *PakFile), State.Chunk.MountOrder))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Failed to mount \"%s\"."), *FPaths::ConvertRelativePathToFull(GetFilePath(State.Chunk.Name, *PakFile)));
+		Finish(State, false);
+	}
+	else
+	{
+		State.MountedPak = GetFilePath(State.Chunk.Name, *PakFile);
+		Finish(State, true);
+	}
+}
+
+void UHttpPakChunkSubsystem::Finish(FChunkState& State, const bool bSucceeded)
+{
+	State.bDownloading = false;
+
+	// The state can move if the listeners register chunks.
+	const FName ChunkName = State.Chunk.Name;
+
+	UE_LOG(LogHttp, Log, TEXT("Pak chunks: \"%s\" %s, %lld bytes downloaded."), *ChunkName.ToString(), bSucceeded ? TEXT("mounted") : TEXT("failed"), State.BytesDownloaded);
+
+	OnChunkMounted.Broadcast(ChunkName, bSucceeded);
+}
+
+bool UHttpPakChunkSubsystem::IsChunkMounted(const FName ChunkName) const
+{
+	const FChunkState* const State = Chunks.Find(ChunkName);
+
+	return State && !State->MountedPak.IsEmpty();
+}
+
+bool UHttpPakChunkSubsystem::IsChunkDownloaded(const FName ChunkName) const
+{
+	const FChunkState* const State = Chunks.Find(ChunkName);
+
+	if (!State || State->bDownloading)
+	{
+		return false;
+	}
+
+	for (const FHttpPakChunkFile& File : State->Chunk.Files)
+	{
+		if (!IsFileVerified(State->Chunk, File))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+float UHttpPakChunkSubsystem::GetChunkProgress(const FName ChunkName) const
+{
+	const FChunkState* const State = Chunks.Find(ChunkName);
+
+	if (!State)
+	{
+		return 0.f;
+	}
+
+	if (!State->bDownloading)
+	{
+		return IsChunkDownloaded(ChunkName) ? 1.f : 0.f;
+	}
+
+	int64 InFlightBytes = 0;
+
+	for (const UHttpPakChunkDownload* const Active : ActiveDownloads)
+	{
+		InFlightBytes += Active->ChunkName == ChunkName ? Active->BytesReceived : 0;
+	}
+
+	return State->BytesToDownload > 0 ? FMath::Clamp(float(State->BytesDownloaded + InFlightBytes) / State->BytesToDownload, 0.f, 1.f) : 0.f;
+}
+
+bool UHttpPakChunkSubsystem::UnmountChunk(const FName ChunkName)
+{
+	FChunkState* const State = Chunks.Find(ChunkName);
+	FPakPlatformFile* const PakPlatformFile = GetPakPlatformFile();
+
+	if (!State || State->MountedPak.IsEmpty() || !PakPlatformFile)
+	{
+		return false;
+	}
+
+	if (!PakPlatformFile->Unmount(*State->MountedPak))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Failed to unmount \"%s\"."), *ChunkName.ToString());
+		return false;
+	}
+
+	State->MountedPak.Reset();
+
+	return true;
+}
+
+void UHttpPakChunkSubsystem::DeleteChunk(const FName ChunkName)
+{
+	FChunkState* const State = Chunks.Find(ChunkName);
+
+	if (!State)
+	{
+		return;
+	}
+
+	if (!State->MountedPak.IsEmpty() && !UnmountChunk(ChunkName))
+	{
+		return;
+	}
+
+	for (int32 Index = ActiveDownloads.Num() - 1; Index >= 0; --Index)
+	{
+		UHttpPakChunkDownload* const Download = ActiveDownloads[Index];
+
+		if (Download->ChunkName == ChunkName)
+		{
+			Download->Request->Abandon();
+			Download->FileWriter.Reset();
+			ActiveDownloads.RemoveAt(Index);
+		}
+	}
+
+	for (const FHttpPakChunkFile& File : State->Chunk.Files)
+	{
+		IFileManager::Get().Delete(*GetFilePath(ChunkName, File), false, false, true);
+		IFileManager::Get().Delete(*(GetFilePath(ChunkName, File) + PartialFileSuffix), false, false, true);
+
+		VerifiedFiles.Remove(GetRelativePath(ChunkName, File));
+	}
+
+	SaveIndex();
+
+	if (State->bDownloading)
+	{
+		Finish(*State, false);
+	}
+}
+
+bool UHttpPakChunkSubsystem::IsFileVerified(const FHttpPakChunk& Chunk, const FHttpPakChunkFile& File) const
+{
+	const FVerifiedFile* const Verified = VerifiedFiles.Find(GetRelativePath(Chunk.Name, File));
+
+	return Verified
+		&& !File.Hash.IsEmpty()
+		&& Verified->Hash	   == File.Hash
+		&& Verified->Algorithm == Chunk.HashAlgorithm
+		&& IFileManager::Get().FileExists(*GetFilePath(Chunk.Name, File));
+}
+
+FString UHttpPakChunkSubsystem::GetFilePath(const FName ChunkName, const FHttpPakChunkFile& File) const
+{
+	return GetChunksDirectory() / GetRelativePath(ChunkName, File);
+}
+
+FString UHttpPakChunkSubsystem::GetIndexPath() const
+{
+	return GetChunksDirectory() / TEXT("PakChunkIndex.json");
+}
+
+void UHttpPakChunkSubsystem::LoadIndex()
+{
+	VerifiedFiles.Reset();
+
+	FString Json;
+	TSharedPtr<FJsonObject> IndexObject;
+
+	if (!FFileHelper::LoadFileToString(Json, *GetIndexPath()) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), IndexObject) || !IndexObject)
+	{
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+
+	if (!IndexObject->TryGetArrayField(TEXT("files"), Files))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *Files)
+	{
+		const TSharedPtr<FJsonObject>* FileObject = nullptr;
+
+		FString Path;
+		FVerifiedFile File;
+		int32 Algorithm;
+
+		if (Value->TryGetObject(FileObject)
+			&& (*FileObject)->TryGetStringField(TEXT("path"), Path)
+			&& (*FileObject)->TryGetStringField(TEXT("hash"), File.Hash)
+			&& (*FileObject)->TryGetNumberField(TEXT("algorithm"), Algorithm))
+		{
+			File.Algorithm = static_cast<EHttpHashAlgorithm>(Algorithm);
+			VerifiedFiles.Add(Path, MoveTemp(File));
+		}
+	}
+}
+
+void UHttpPakChunkSubsystem::SaveIndex() const
+{
+	TArray<TSharedPtr<FJsonValue>> Files;
+
+	for (const TPair<FString, FVerifiedFile>& Entry : VerifiedFiles)
+	{
+		const TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+
+		FileObject->SetStringField(TEXT("path"), Entry.Key);
+		FileObject->SetStringField(TEXT("hash"), Entry.Value.Hash);
+		FileObject->SetNumberField(TEXT("algorithm"), static_cast<int32>(Entry.Value.Algorithm));
+
+		Files.Add(MakeShared<FJsonValueObject>(FileObject));
+	}
+
+	const TSharedRef<FJsonObject> IndexObject = MakeShared<FJsonObject>();
+
+	IndexObject->SetArrayField(TEXT("files"), Files);
+
+	FString Json;
+	FJsonSerializer::Serialize(IndexObject, TJsonWriterFactory<>::Create(&Json));
+
+	if (!FFileHelper::SaveStringToFile(Json, *GetIndexPath()))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Pak chunks: Failed to save the index \"%s\"."), *FPaths::ConvertRelativePathToFull(GetIndexPath()));
+	}
+}
+
+UEnsureHttpPakChunkProxy* UEnsureHttpPakChunkProxy::EnsurePakChunkAvailable(UObject* WorldContextObject, const FName ChunkName, const TArray<TSoftObjectPtr<UObject>>& PreloadAssets)
+{
+	UEnsureHttpPakChunkProxy* const Proxy = NewObject<UEnsureHttpPakChunkProxy>();
+
+	const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	const UGameInstance* const GameInstance = World ? World->GetGameInstance() : nullptr;
+
+	Proxy->Subsystem	 = GameInstance ? GameInstance->GetSubsystem<UHttpPakChunkSubsystem>() : nullptr;
+	Proxy->ChunkName	 = ChunkName;
+	Proxy->PreloadAssets = PreloadAssets;
+
+	Proxy->RegisterWithGameInstance(WorldContextObject);
+
+	return Proxy;
+}
+
+void UEnsureHttpPakChunkProxy::Activate()
+{
+	if (!Subsystem)
+	{
+		Complete(false);
+		return;
+	}
+
+	if (Subsystem->IsChunkMounted(ChunkName))
+	{
+		Preload();
+		return;
+	}
+
+	Subsystem->OnChunkProgress.AddDynamic(this, &UEnsureHttpPakChunkProxy::OnChunkProgress);
+	Subsystem->OnChunkMounted .AddDynamic(this, &UEnsureHttpPakChunkProxy::OnChunkMounted);
+
+	if (!Subsystem->RequestChunk(ChunkName))
+	{
+		Complete(false);
+	}
+}
+
+void UEnsureHttpPakChunkProxy::OnChunkProgress(const FName InChunkName, const int64 BytesDownloaded, const int64 BytesToDownload)
+{
+	if (InChunkName == ChunkName)
+	{
+		OnProgress.Broadcast(ChunkName, Subsystem->GetChunkProgress(ChunkName));
+	}
+}
+
+void UEnsureHttpPakChunkProxy::OnChunkMounted(const FName InChunkName, const bool bSucceeded)
+{
+	if (InChunkName != ChunkName)
+	{
+		return;
+	}
+
+	Subsystem->OnChunkProgress.RemoveAll(this);
+	Subsystem->OnChunkMounted .RemoveAll(this);
+
+	if (bSucceeded)
+	{
+		Preload();
+	}
+	else
+	{
+		Complete(false);
+	}
+}
+
+void UEnsureHttpPakChunkProxy::Preload()
+{
+	TArray<FSoftObjectPath> Paths;
+
+	for (const TSoftObjectPtr<UObject>& Asset : PreloadAssets)
+	{
+		if (!Asset.IsNull())
+		{
+			Paths.Add(Asset.ToSoftObjectPath());
+		}
+	}
+
+	if (Paths.IsEmpty())
+	{
+		Complete(true);
+		return;
+	}
+
+	PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, FStreamableDelegate::CreateWeakLambda(this, [this]()
+	{
+		Complete(true);
+	}));
+
+	if (!PreloadHandle)
+	{
+		Complete(false);
+	}
+}
+
+void UEnsureHttpPakChunkProxy::Complete(const bool bSucceeded)
+{
+	if (Subsystem)
+	{
+		Subsystem->OnChunkProgress.RemoveAll(this);
+		Subsystem->OnChunkMounted .RemoveAll(this);
+	}
+
+	if (bSucceeded)
+	{
+		OnAvailable.Broadcast(ChunkName, 1.f);
+	}
+	else
+	{
+		OnFailed.Broadcast(ChunkName, Subsystem ? Subsystem->GetChunkProgress(ChunkName) : 0.f);
+	}
+
+	PreloadHandle.Reset();
+
+	SetReadyToDestroy();
+}
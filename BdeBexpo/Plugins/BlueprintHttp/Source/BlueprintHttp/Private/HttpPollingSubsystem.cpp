@@ -0,0 +1,404 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpPollingSubsystem.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "HttpClientProfile.h"
+#include "Http.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Framework/Application/SlateApplication.h"
+
+namespace
+{
+	/* Shortest interval accepted from subscribers. */
+	constexpr float MinimumPollInterval = 0.1f;
+
+	FString ResolveEndpointUrl(const FString& Url, const FName Profile)
+	{
+		return Profile.IsNone() ? Url : FHttpClientProfiles::ResolveUrl(Profile, Url, {});
+	}
+
+	FString MakeEndpointKey(const FString& ResolvedUrl, const FName Profile)
+	{
+		return Profile.IsNone() ? ResolvedUrl : Profile.ToString() + TEXT("|") + ResolvedUrl;
+	}
+}
+
+void UHttpPolledEndpoint::OnResponse(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	if (InRequest == Request)
+	{
+		Owner->OnEndpointResponse(this, Response, bConnectedSuccessfully);
+	}
+}
+
+UHttpPollingSubsystem::UHttpPollingSubsystem()
+	: Super()
+	, NextHandle(1)
+	, bForeground(true)
+{
+}
+
+void UHttpPollingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UHttpPollingSubsystem::Tick), 0.1f);
+
+	// Mobile platforms report going to the background, desktop ones losing the focus.
+	EnterBackgroundHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddWeakLambda(this, [this]()
+	{
+		SetForeground(false);
+	});
+
+	EnterForegroundHandle = FCoreDelegates::ApplicationHasEnteredForegroundDelegate.AddWeakLambda(this, [this]()
+	{
+		SetForeground(true);
+	});
+
+	if (FSlateApplication::IsInitialized())
+	{
+		ActivationHandle = FSlateApplication::Get().OnApplicationActivationStateChanged().AddWeakLambda(this, [this](const bool bIsActive)
+		{
+			SetForeground(bIsActive);
+		});
+	}
+}
+
+void UHttpPollingSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+
+	FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(EnterBackgroundHandle);
+	FCoreDelegates::ApplicationHasEnteredForegroundDelegate.Remove(EnterForegroundHandle);
+
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnApplicationActivationStateChanged().Remove(ActivationHandle);
+	}
+
+	for (const TPair<FString, UHttpPolledEndpoint*>& Endpoint : Endpoints)
+	{
+		if (Endpoint.Value->Request)
+		{
+			Endpoint.Value->Request->Abandon();
+			Endpoint.Value->Request = nullptr;
+		}
+	}
+
+	Endpoints.Empty();
+
+	Super::Deinitialize();
+}
+
+int32 UHttpPollingSubsystem::Subscribe(const FString& Url, const FOnHttpPollUpdated& OnUpdated, const float MinInterval, const float MaxInterval, const FName Profile)
+{
+	if (!OnUpdated.IsBound())
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Polling: Subscription to \"%s\" ignored, its event isn't bound."), *Url);
+		return 0;
+	}
+
+	const FString ResolvedUrl = ResolveEndpointUrl(Url, Profile);
+	const FString Key		  = MakeEndpointKey(ResolvedUrl, Profile);
+
+	UHttpPolledEndpoint* Endpoint = Endpoints.FindRef(Key);
+
+	const bool bNewEndpoint = Endpoint == nullptr;
+	if (bNewEndpoint)
+	{
+		Endpoint = NewObject<UHttpPolledEndpoint>(this);
+
+		Endpoint->Owner	  = this;
+		Endpoint->Key	  = Key;
+		Endpoint->Url	  = ResolvedUrl;
+		Endpoint->Profile = Profile;
+
+		Endpoints.Add(Key, Endpoint);
+	}
+
+	UHttpPolledEndpoint::FSubscriber& Subscriber = Endpoint->Subscribers.AddDefaulted_GetRef();
+
+	Subscriber.Handle	   = NextHandle++;
+	Subscriber.OnUpdated   = OnUpdated;
+	Subscriber.MinInterval = FMath::Max(MinInterval, MinimumPollInterval);
+	Subscriber.MaxInterval = FMath::Max(MaxInterval, Subscriber.MinInterval);
+
+	const int32 Handle = Subscriber.Handle;
+
+	UpdateIntervalBounds(Endpoint);
+
+	if (bNewEndpoint)
+	{
+		Endpoint->Interval = Endpoint->MinInterval;
+		Poll(Endpoint);
+		return Handle;
+	}
+
+	// A subscriber may want fresher data than the current schedule gives.
+	if (!Endpoint->Request)
+	{
+		SchedulePoll(Endpoint);
+	}
+
+	if (Endpoint->LatestResponse)
+	{
+		OnUpdated.ExecuteIfBound(Endpoint->Url, Endpoint->LatestResponse);
+	}
+
+	return Handle;
+}
+
+void UHttpPollingSubsystem::Unsubscribe(const int32 Handle)
+{
+	UHttpPolledEndpoint* Subscribed = nullptr;
+
+	for (const TPair<FString, UHttpPolledEndpoint*>& Pair : Endpoints)
+	{
+		if (Pair.Value->Subscribers.RemoveAll([Handle](const UHttpPolledEndpoint::FSubscriber& Subscriber) { return Subscriber.Handle == Handle; }) > 0)
+		{
+			Subscribed = Pair.Value;
+			break;
+		}
+	}
+
+	// Removing the endpoint while iterating would invalidate the map.
+	if (Subscribed)
+	{
+		PruneSubscribers(Subscribed);
+	}
+}
+
+void UHttpPollingSubsystem::UnsubscribeAll(const UObject* const Subscriber)
+{
+	if (!Subscriber)
+	{
+		return;
+	}
+
+	TArray<UHttpPolledEndpoint*> EndpointList;
+	Endpoints.GenerateValueArray(EndpointList);
+
+	for (UHttpPolledEndpoint* const Endpoint : EndpointList)
+	{
+		Endpoint->Subscribers.RemoveAll([Subscriber](const UHttpPolledEndpoint::FSubscriber& Entry) { return Entry.OnUpdated.IsBoundToObject(Subscriber); });
+
+		PruneSubscribers(Endpoint);
+	}
+}
+
+void UHttpPollingSubsystem::PollNow(const FString& Url, const FName Profile)
+{
+	UHttpPolledEndpoint* const Endpoint = FindEndpoint(Url, Profile);
+
+	if (Endpoint && !Endpoint->Request)
+	{
+		Poll(Endpoint);
+	}
+}
+
+UHttpResponse* UHttpPollingSubsystem::GetLatestResponse(const FString& Url, const FName Profile) const
+{
+	const UHttpPolledEndpoint* const Endpoint = FindEndpoint(Url, Profile);
+	return Endpoint ? Endpoint->LatestResponse : nullptr;
+}
+
+bool UHttpPollingSubsystem::IsInForeground() const
+{
+	return bForeground;
+}
+
+UHttpPolledEndpoint* UHttpPollingSubsystem::FindEndpoint(const FString& Url, const FName Profile) const
+{
+	return Endpoints.FindRef(MakeEndpointKey(ResolveEndpointUrl(Url, Profile), Profile));
+}
+
+bool UHttpPollingSubsystem::Tick(float DeltaTime)
+{
+	if (!bForeground && BackgroundIntervalScale <= 0.f)
+	{
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<UHttpPolledEndpoint*> EndpointList;
+	Endpoints.GenerateValueArray(EndpointList);
+
+	for (UHttpPolledEndpoint* const Endpoint : EndpointList)
+	{
+		if (!Endpoint->Request && Now >= Endpoint->NextPollTime && PruneSubscribers(Endpoint))
+		{
+			Poll(Endpoint);
+		}
+	}
+
+	return true;
+}
+
+void UHttpPollingSubsystem::Poll(UHttpPolledEndpoint* const Endpoint)
+{
+	UHttpRequest* Request;
+
+	if (Endpoint->Profile.IsNone())
+	{
+		Request = UHttpRequest::CreateRequest();
+		Request->SetVerb(EHttpVerb::GET);
+		Request->SetURL(Endpoint->Url);
+	}
+	else
+	{
+		// The URL is already resolved, the profile only adds its settings.
+		Request = FHttpClientProfiles::CreateRequest(Endpoint->Profile, Endpoint->Url, {}, EHttpVerb::GET);
+	}
+
+	if (!Endpoint->ETag.IsEmpty())
+	{
+		Request->SetHeader(TEXT("If-None-Match"), Endpoint->ETag);
+	}
+	else if (!Endpoint->LastModified.IsEmpty())
+	{
+		Request->SetHeader(TEXT("If-Modified-Since"), Endpoint->LastModified);
+	}
+
+	Request->OnRequestComplete.AddDynamic(Endpoint, &UHttpPolledEndpoint::OnResponse);
+
+	Endpoint->Request = Request;
+
+	if (!Request->ProcessRequest())
+	{
+		UE_LOG(LogHttp, Error, TEXT("Polling: Failed to request \"%s\"."), *Endpoint->Url);
+		OnEndpointResponse(Endpoint, nullptr, false);
+	}
+}
+
+void UHttpPollingSubsystem::OnEndpointResponse(UHttpPolledEndpoint* const Endpoint, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	Endpoint->Request	   = nullptr;
+	Endpoint->LastPollTime = FPlatformTime::Seconds();
+
+	const int32 ResponseCode = Response ? Response->GetResponseCode() : 0;
+
+	if (!bConnectedSuccessfully || ResponseCode < 200 || (ResponseCode >= 300 && ResponseCode != 304))
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Polling: Failed to poll \"%s\" (%d)."), *Endpoint->Url, ResponseCode);
+
+		Endpoint->Interval = FMath::Min(Endpoint->Interval * 2.f, Endpoint->MaxInterval);
+		SchedulePoll(Endpoint);
+		return;
+	}
+
+	bool bChanged = false;
+
+	if (ResponseCode != 304)
+	{
+		TArray<uint8> Content;
+		Response->GetContent(Content);
+
+		// Servers without validators send the same content again.
+		const uint64 ContentHash = CityHash64(reinterpret_cast<const char*>(Content.GetData()), Content.Num());
+
+		bChanged = ContentHash != Endpoint->ContentHash || Content.Num() != Endpoint->ContentLength;
+
+		Endpoint->ContentHash	= ContentHash;
+		Endpoint->ContentLength = Content.Num();
+		Endpoint->ETag			= Response->GetHeader(TEXT("ETag"));
+		Endpoint->LastModified	= Response->GetHeader(TEXT("Last-Modified"));
+	}
+
+	if (!bChanged)
+	{
+		Endpoint->Interval = FMath::Min(Endpoint->Interval * 1.25f, Endpoint->MaxInterval);
+		SchedulePoll(Endpoint);
+		return;
+	}
+
+	Endpoint->LatestResponse = Response;
+	Endpoint->Interval		 = FMath::Max(Endpoint->Interval * 0.5f, Endpoint->MinInterval);
+
+	SchedulePoll(Endpoint);
+
+	// Subscribers may unsubscribe or subscribe while notified.
+	const TArray<UHttpPolledEndpoint::FSubscriber> Subscribers = Endpoint->Subscribers;
+
+	for (const UHttpPolledEndpoint::FSubscriber& Subscriber : Subscribers)
+	{
+		Subscriber.OnUpdated.ExecuteIfBound(Endpoint->Url, Response);
+	}
+}
+
+bool UHttpPollingSubsystem::PruneSubscribers(UHttpPolledEndpoint* const Endpoint)
+{
+	Endpoint->Subscribers.RemoveAll([](const UHttpPolledEndpoint::FSubscriber& Subscriber) { return !Subscriber.OnUpdated.IsBound(); });
+
+	if (Endpoint->Subscribers.Num() == 0)
+	{
+		RemoveEndpoint(Endpoint);
+		return false;
+	}
+
+	UpdateIntervalBounds(Endpoint);
+	return true;
+}
+
+void UHttpPollingSubsystem::RemoveEndpoint(UHttpPolledEndpoint* const Endpoint)
+{
+	if (Endpoint->Request)
+	{
+		Endpoint->Request->Abandon();
+		Endpoint->Request = nullptr;
+	}
+
+	Endpoints.Remove(Endpoint->Key);
+}
+
+void UHttpPollingSubsystem::UpdateIntervalBounds(UHttpPolledEndpoint* const Endpoint) const
+{
+	float MinInterval = TNumericLimits<float>::Max();
+	float MaxInterval = TNumericLimits<float>::Max();
+
+	for (const UHttpPolledEndpoint::FSubscriber& Subscriber : Endpoint->Subscribers)
+	{
+		MinInterval = FMath::Min(MinInterval, Subscriber.MinInterval);
+		MaxInterval = FMath::Min(MaxInterval, Subscriber.MaxInterval);
+	}
+
+	Endpoint->MinInterval = MinInterval;
+	Endpoint->MaxInterval = FMath::Max(MaxInterval, MinInterval);
+	Endpoint->Interval	  = FMath::Clamp(Endpoint->Interval, Endpoint->MinInterval, Endpoint->MaxInterval);
+}
+
+void UHttpPollingSubsystem::SchedulePoll(UHttpPolledEndpoint* const Endpoint) const
+{
+	float Delay = Endpoint->Interval * FMath::FRandRange(0.9f, 1.1f);
+
+	if (!bForeground)
+	{
+		Delay *= BackgroundIntervalScale;
+	}
+
+	Endpoint->NextPollTime = Endpoint->LastPollTime + Delay;
+}
+
+void UHttpPollingSubsystem::SetForeground(const bool bInForeground)
+{
+	if (bForeground == bInForeground)
+	{
+		return;
+	}
+
+	bForeground = bInForeground;
+
+	UE_LOG(LogHttp, Log, TEXT("Polling: Application %s, %d endpoints rescheduled."), bForeground ? TEXT("in the foreground") : TEXT("in the background"), Endpoints.Num());
+
+	for (const TPair<FString, UHttpPolledEndpoint*>& Endpoint : Endpoints)
+	{
+		if (!Endpoint.Value->Request)
+		{
+			SchedulePoll(Endpoint.Value);
+		}
+	}
+}
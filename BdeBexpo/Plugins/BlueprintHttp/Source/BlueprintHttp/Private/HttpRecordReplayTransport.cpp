@@ -0,0 +1,289 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpRecordReplayTransport.h"
+#include "HttpRequest.h"
+#include "Http.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/* 'BHRR' */
+	constexpr uint32 ArchiveMagic	= 0x52524842;
+	constexpr int32  ArchiveVersion = 1;
+}
+
+FString FHttpRecordedExchange::GetKey() const
+{
+	return MakeKey(Verb, URL, RequestBodyHash);
+}
+
+FString FHttpRecordedExchange::MakeKey(const FString& Verb, const FString& URL, const uint32 RequestBodyHash)
+{
+	return FString::Printf(TEXT("%s %s #%08x"), *Verb, *URL, RequestBodyHash);
+}
+
+FArchive& operator<<(FArchive& Ar, FHttpRecordedExchange& Exchange)
+{
+	Ar << Exchange.Verb;
+	Ar << Exchange.URL;
+	Ar << Exchange.RequestBodyHash;
+	Ar << Exchange.bConnectedSuccessfully;
+	Ar << Exchange.ElapsedTime;
+	Ar << *Exchange.Response;
+
+	return Ar;
+}
+
+FHttpRecordReplayTransport::FHttpRecordReplayTransport(const EHttpTransportMode InMode, const FString& InArchivePath, const bool bInReplayOriginalTiming)
+	: Mode(InMode)
+	, ArchivePath(InArchivePath)
+	, bReplayOriginalTiming(bInReplayOriginalTiming)
+	, RecordedCount(0)
+	, bDirty(false)
+{}
+
+FHttpRecordReplayTransport::~FHttpRecordReplayTransport()
+{
+	for (const auto& Pending : PendingReplays)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(Pending.Value.Ticker);
+	}
+
+	if (bDirty)
+	{
+		Save();
+	}
+}
+
+bool FHttpRecordReplayTransport::Initialize()
+{
+	if (Mode != EHttpTransportMode::Replay)
+	{
+		UE_LOG(LogHttp, Log, TEXT("Transport: Recording requests to \"%s\"."), *FPaths::ConvertRelativePathToFull(ArchivePath));
+		return true;
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *ArchivePath))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Transport: Failed to read the replay archive \"%s\"."), *FPaths::ConvertRelativePathToFull(ArchivePath));
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+
+	uint32 Magic   = 0;
+	int32  Version = 0;
+	int32  Count   = 0;
+
+	Reader << Magic << Version;
+
+	if (Magic != ArchiveMagic || Version > ArchiveVersion)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Transport: \"%s\" is not a replay archive or was made by a newer version."), *ArchivePath);
+		return false;
+	}
+
+	Reader << Count;
+
+	for (int32 i = 0; i < Count && !Reader.IsError(); ++i)
+	{
+		const TSharedRef<FHttpRecordedExchange> Exchange = MakeShared<FHttpRecordedExchange>();
+		Reader << *Exchange;
+
+		Exchanges.FindOrAdd(Exchange->GetKey()).Add(Exchange);
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogHttp, Error, TEXT("Transport: The replay archive \"%s\" is corrupted."), *ArchivePath);
+		return false;
+	}
+
+	UE_LOG(LogHttp, Log, TEXT("Transport: Replaying %d exchanges from \"%s\"."), Count, *FPaths::ConvertRelativePathToFull(ArchivePath));
+
+	return true;
+}
+
+bool FHttpRecordReplayTransport::Save()
+{
+	if (Mode != EHttpTransportMode::Record)
+	{
+		return false;
+	}
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	uint32 Magic   = ArchiveMagic;
+	int32  Version = ArchiveVersion;
+	int32  Count   = RecordedCount;
+
+	Writer << Magic << Version << Count;
+
+	for (const auto& Pair : Exchanges)
+	{
+		for (const TSharedPtr<const FHttpRecordedExchange>& Exchange : Pair.Value)
+		{
+			Writer << const_cast<FHttpRecordedExchange&>(*Exchange);
+		}
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Data, *ArchivePath))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Transport: Failed to save the recording to \"%s\"."), *FPaths::ConvertRelativePathToFull(ArchivePath));
+		return false;
+	}
+
+	bDirty = false;
+
+	UE_LOG(LogHttp, Log, TEXT("Transport: Saved %d exchanges to \"%s\"."), Count, *FPaths::ConvertRelativePathToFull(ArchivePath));
+
+	return true;
+}
+
+uint32 FHttpRecordReplayTransport::HashRequestBody(const UHttpRequest* const Request)
+{
+	const TArray<uint8>& Content = Request->GetNativeRequest()->GetContent();
+
+	return FCrc::MemCrc32(Content.GetData(), Content.Num());
+}
+
+bool FHttpRecordReplayTransport::ProcessRequest(UHttpRequest* const Request)
+{
+	if (Mode == EHttpTransportMode::Replay)
+	{
+		return ReplayRequest(Request);
+	}
+
+	RecordingBodyHashes.Add(Request, HashRequestBody(Request));
+
+	return Request->GetNativeRequest()->ProcessRequest();
+}
+
+void FHttpRecordReplayTransport::CancelRequest(UHttpRequest* const Request)
+{
+	if (Mode != EHttpTransportMode::Replay)
+	{
+		RecordingBodyHashes.Remove(Request);
+		Request->GetNativeRequest()->CancelRequest();
+		return;
+	}
+
+	FPendingReplay Pending;
+	if (PendingReplays.RemoveAndCopyValue(Request, Pending))
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(Pending.Ticker);
+
+		// Like native requests, cancelled requests still complete.
+		Request->CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, EBlueprintHttpRequestStatus::Failed, 0.f);
+	}
+}
+
+void FHttpRecordReplayTransport::OnRequestCompleted(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	uint32 BodyHash = 0;
+	if (Mode != EHttpTransportMode::Record || !RecordingBodyHashes.RemoveAndCopyValue(Request, BodyHash))
+	{
+		return;
+	}
+
+	const TSharedRef<FHttpRecordedExchange> Exchange = MakeShared<FHttpRecordedExchange>();
+
+	Exchange->Verb					 = Request->GetVerb();
+	Exchange->URL					 = Request->GetURL();
+	Exchange->RequestBodyHash		 = BodyHash;
+	Exchange->bConnectedSuccessfully = bConnectedSuccessfully;
+	Exchange->ElapsedTime			 = Response ? Response->GetElapsedTime() : Request->GetElapsedTime();
+
+	if (Response && Response->GetNativeResponse())
+	{
+		const TSharedRef<FHttpResponseSnapshot, ESPMode::ThreadSafe> Snapshot = FHttpResponseSnapshot::Capture(*Response->GetNativeResponse());
+
+		// The native content is empty when the body was received by FHttpResponseBody.
+		if (Response->GetBody())
+		{
+			Response->GetContent(Snapshot->Content);
+		}
+
+		Exchange->Response = Snapshot;
+	}
+
+	Exchanges.FindOrAdd(Exchange->GetKey()).Add(Exchange);
+
+	++RecordedCount;
+	bDirty = true;
+}
+
+bool FHttpRecordReplayTransport::ReplayRequest(UHttpRequest* const Request)
+{
+	if (PendingReplays.Contains(Request))
+	{
+		return false;
+	}
+
+	const FString Key = FHttpRecordedExchange::MakeKey(Request->GetVerb(), Request->GetURL(), HashRequestBody(Request));
+
+	TSharedPtr<const FHttpRecordedExchange> Exchange;
+
+	if (const TArray<TSharedPtr<const FHttpRecordedExchange>>* const Recorded = Exchanges.Find(Key))
+	{
+		int32& Cursor = ReplayCursors.FindOrAdd(Key);
+		Exchange = (*Recorded)[FMath::Min(Cursor, Recorded->Num() - 1)];
+		++Cursor;
+	}
+	else
+	{
+		UE_LOG(LogHttp, Warning, TEXT("Transport: No recorded exchange for \"%s\"."), *Key);
+	}
+
+	const float Delay = bReplayOriginalTiming && Exchange ? Exchange->ElapsedTime : 0.f;
+
+	const TWeakObjectPtr<UHttpRequest> WeakRequest = Request;
+
+	FPendingReplay& Pending = PendingReplays.Add(Request);
+	Pending.Exchange = Exchange;
+	Pending.Ticker	 = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, WeakRequest](float)
+	{
+		FPendingReplay Finished;
+		if (PendingReplays.RemoveAndCopyValue(WeakRequest, Finished) && WeakRequest.IsValid())
+		{
+			FinishReplay(WeakRequest.Get(), Finished.Exchange);
+		}
+		return false;
+	}), Delay);
+
+	return true;
+}
+
+void FHttpRecordReplayTransport::FinishReplay(UHttpRequest* const Request, const TSharedPtr<const FHttpRecordedExchange>& Exchange)
+{
+	if (!Exchange)
+	{
+		Request->CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, EBlueprintHttpRequestStatus::Failed_ConnectionError, 0.f);
+		return;
+	}
+
+	const FHttpResponseSnapshot& Snapshot = *Exchange->Response;
+
+	FString HeaderName;
+	FString HeaderValue;
+	for (const FString& Header : Snapshot.Headers)
+	{
+		if (Header.Split(TEXT(": "), &HeaderName, &HeaderValue))
+		{
+			Request->ReportHeaderFromTransport(HeaderName, HeaderValue);
+		}
+	}
+
+	Request->ReportProgressFromTransport(Request->GetNativeRequest()->GetContent().Num(), Snapshot.Content.Num());
+
+	const EBlueprintHttpRequestStatus Status = Exchange->bConnectedSuccessfully ? EBlueprintHttpRequestStatus::Succeeded : EBlueprintHttpRequestStatus::Failed_ConnectionError;
+
+	Request->CompleteFromTransport(UHttpResponse::CreateFromSnapshot(Exchange->Response, Exchange->ElapsedTime), Exchange->bConnectedSuccessfully, Status, Exchange->ElapsedTime);
+}
@@ -0,0 +1,91 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpTransport.h"
+#include "HttpResponse.h"
+
+/**
+ *  One recorded request/response pair.
+ **/
+struct FHttpRecordedExchange
+{
+	FString Verb;
+	FString URL;
+
+	/* CRC of the request body, requests with different bodies are different exchanges. */
+	uint32 RequestBodyHash = 0;
+
+	bool bConnectedSuccessfully = false;
+
+	/* Time it took for the request to complete, in seconds. */
+	float ElapsedTime = 0.f;
+
+	TSharedRef<FHttpResponseSnapshot, ESPMode::ThreadSafe> Response = MakeShared<FHttpResponseSnapshot, ESPMode::ThreadSafe>();
+
+	/* Key under which the exchange is looked up when replaying. */
+	FString GetKey() const;
+
+	static FString MakeKey(const FString& Verb, const FString& URL, const uint32 RequestBodyHash);
+
+	friend FArchive& operator<<(FArchive& Ar, FHttpRecordedExchange& Exchange);
+};
+
+/**
+ *  Transport recording exchanges to an archive, or serving requests from one.
+ *
+ *  When replaying, exchanges recorded several times for the same request are served
+ *  in recording order, the last one being repeated once all of them were served.
+ *  Requests without recording fail with a connection error.
+ **/
+class FHttpRecordReplayTransport final : public IHttpTransport
+{
+public:
+	FHttpRecordReplayTransport(const EHttpTransportMode InMode, const FString& InArchivePath, const bool bInReplayOriginalTiming);
+	virtual ~FHttpRecordReplayTransport();
+
+	/* Loads the archive when replaying. Returns false if it can't be read. */
+	bool Initialize();
+
+	/* Writes the recorded exchanges to the archive. */
+	bool Save();
+
+	//~ Begin IHttpTransport Interface
+	virtual bool ProcessRequest(UHttpRequest* const Request) override;
+	virtual void CancelRequest (UHttpRequest* const Request) override;
+	virtual void OnRequestCompleted(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully) override;
+	virtual EHttpTransportMode GetMode() const override { return Mode; }
+	//~ End IHttpTransport Interface
+
+private:
+	struct FPendingReplay
+	{
+		FTSTicker::FDelegateHandle Ticker;
+		TSharedPtr<const FHttpRecordedExchange> Exchange;
+	};
+
+	bool ReplayRequest(UHttpRequest* const Request);
+	void FinishReplay (UHttpRequest* const Request, const TSharedPtr<const FHttpRecordedExchange>& Exchange);
+
+	static uint32 HashRequestBody(const UHttpRequest* const Request);
+
+	const EHttpTransportMode Mode;
+	const FString ArchivePath;
+	const bool bReplayOriginalTiming;
+
+	/* Exchanges by key, in recording order. */
+	TMap<FString, TArray<TSharedPtr<const FHttpRecordedExchange>>> Exchanges;
+
+	/* Next exchange to serve per key when replaying. */
+	TMap<FString, int32> ReplayCursors;
+
+	TMap<TWeakObjectPtr<UHttpRequest>, FPendingReplay> PendingReplays;
+
+	/* Request fingerprint taken when the request starts, as its body can change afterwards. */
+	TMap<TWeakObjectPtr<UHttpRequest>, uint32> RecordingBodyHashes;
+
+	int32 RecordedCount;
+	bool  bDirty;
+};
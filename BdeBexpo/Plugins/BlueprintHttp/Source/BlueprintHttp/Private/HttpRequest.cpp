@@ -6,10 +6,69 @@
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "HttpResponse.h"
+#include "HttpHeaderUtils.h"
+#include "HttpTransport.h"
+#include "HttpThreadTuner.h"
+#include "HttpCompletionDispatcher.h"
+#include "HttpRequestScheduler.h"
+#include "HttpWorkerCompletion.h"
+#include "HttpDeadlineBudget.h"
+#include "HttpRequestWatchdog.h"
+#include "HttpConnectionWarmer.h"
+#include "HttpResponseBody.h"
+#include "PlatformHttp.h"
+#include "Tasks/Task.h"
 #include "Http.h"
+#include "CoreGlobals.h"
+
+namespace
+{
+	/* Time without progress after which a throttled request broadcasts the progress it held back. */
+	constexpr float MinProgressStallInterval = 0.5f;
+}
+
+float FHttpRetryPolicy::GetBackoffDelay(const int32 Attempt) const
+{
+	float Delay = InitialDelay * FMath::Pow(FMath::Max(BackoffMultiplier, 1.f), static_cast<float>(FMath::Clamp(Attempt, 0, 16)));
+
+	if (bJitter)
+	{
+		Delay *= FMath::FRandRange(0.5f, 1.f);
+	}
+
+	return MaxDelay > 0.f ? FMath::Min(Delay, MaxDelay) : Delay;
+}
+
+FHttpProgressPolicy UHttpRequest::DefaultProgressPolicy;
 
 UHttpRequest::UHttpRequest()
 	: Super()
+	, bInFlight(false)
+	, LastBytesReceived(0)
+	, Priority(EHttpRequestPriority::Normal)
+	, ProgressPolicy(DefaultProgressPolicy)
+	, PendingBytesSent(0)
+	, PendingBytesReceived(0)
+	, bProgressPending(false)
+	, LastProgressEventTime(0.)
+	, LastProgressFrame(MAX_uint64)
+	, LastProgressTime(0.)
+	, LastBroadcastBytes(0)
+	, LastBroadcastBytesReceived(0)
+	, ExpectedContentLength(0)
+	, TransportElapsedTime(0.f)
+	, DeadlineBudget(nullptr)
+	, StartTime(0.)
+	, DispatchTime(0.)
+	, LastActivityTime(0.)
+	, bDispatched(false)
+	, bHadActivity(false)
+	, bTimedOut(false)
+	, LastActivityBytes(0)
+	, TimeToFirstByte(0.f)
+	, bIntegrityFailed(false)
+	, RetryCount(0)
+	, bCancelled(false)
 {
 	Request = FHttpModule::Get().CreateRequest();
 
@@ -30,6 +89,7 @@ UHttpResponse* UHttpRequest::CreateResponse(TSharedPtr<IHttpRequest, ESPMode::Th
 	UHttpResponse* const WrappedResponse = NewObject<UHttpResponse>();
 
 	WrappedResponse->InitInternal(RawResponse, RawRequest->GetElapsedTime());
+	WrappedResponse->Body = ResponseBody;
 
 	return WrappedResponse;
 }
@@ -92,6 +152,7 @@ void UHttpRequest::AppendToHeader(const FString& Key, const FString& Value)
 void UHttpRequest::SetURL(const FString& Url)
 {
 	Request->SetURL(Url);
+	ParsedUrl.Reset();
 }
 
 void UHttpRequest::SetMimeType(const EHttpMimeType MimeType)
@@ -121,24 +182,7 @@ void UHttpRequest::SetContentAsStreamedFile(const FString& FileName, bool& bFile
 
 TMap<FString, FString> UHttpRequest::GetAllHeaders() const
 {
-	TArray<FString> Headers = Request->GetAllHeaders();
-
-	TMap<FString, FString> OutHeaders;
-	
-	FString* Key	= nullptr;
-	FString* Value	= nullptr;
-
-	const FString Separator = TEXT(": ");
-
-	for (FString & Header : Headers)
-	{
-		if (Header.Split(Separator, Key, Value, ESearchCase::CaseSensitive))
-		{
-			OutHeaders.Emplace(*Key, *Value);
-		}
-	}
-
-	return OutHeaders;
+	return BlueprintHttp::SplitHeaders(Request->GetAllHeaders());
 }
 
 void UHttpRequest::GetContent(TArray<uint8>& OutContent) const
@@ -165,7 +209,7 @@ FString UHttpRequest::GetContentType() const
 
 float UHttpRequest::GetElapsedTime() const
 {
-	return Request->GetElapsedTime();
+	return TransportStatus.IsSet() ? TransportElapsedTime : Request->GetElapsedTime();
 }
 
 FString UHttpRequest::GetHeader(const FString& Key) const
@@ -175,6 +219,27 @@ FString UHttpRequest::GetHeader(const FString& Key) const
 
 EBlueprintHttpRequestStatus UHttpRequest::GetStatus() const
 {
+	if (bTimedOut)
+	{
+		return EBlueprintHttpRequestStatus::Failed_Timeout;
+	}
+
+	if (bIntegrityFailed)
+	{
+		return EBlueprintHttpRequestStatus::Failed_IntegrityCheck;
+	}
+
+	if (TransportStatus.IsSet())
+	{
+		return TransportStatus.GetValue();
+	}
+
+	// Native requests report failures to connect as Failed with a failure reason since 5.4.
+	if (Request->GetStatus() == EHttpRequestStatus::Failed && Request->GetFailureReason() == EHttpFailureReason::ConnectionError)
+	{
+		return EBlueprintHttpRequestStatus::Failed_ConnectionError;
+	}
+
 	return static_cast<EBlueprintHttpRequestStatus>(Request->GetStatus());
 }
 
@@ -185,7 +250,29 @@ FString UHttpRequest::GetURL() const
 
 FString UHttpRequest::GetURLParameter(const FString& ParameterName) const
 {
-	return Request->GetURLParameter(ParameterName);
+	const FHttpUrl& Url = GetCachedUrl();
+	if (!Url.IsValid())
+	{
+		return Request->GetURLParameter(ParameterName);
+	}
+
+	const FString* const Value = Url.FindQueryParameter(ParameterName);
+	return Value ? *Value : FString();
+}
+
+FHttpUrl UHttpRequest::GetParsedURL() const
+{
+	return GetCachedUrl();
+}
+
+const FHttpUrl& UHttpRequest::GetCachedUrl() const
+{
+	if (!ParsedUrl.IsSet())
+	{
+		FHttpUrl::Parse(Request->GetURL(), ParsedUrl.Emplace());
+	}
+
+	return ParsedUrl.GetValue();
 }
 
 FString UHttpRequest::GetVerb() const
@@ -194,35 +281,727 @@ FString UHttpRequest::GetVerb() const
 }
 
 bool UHttpRequest::ProcessRequest()
+{
+	if (RetryHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RetryHandle);
+		RetryHandle.Reset();
+	}
+
+	RetryCount = 0;
+
+	return StartAttempt();
+}
+
+bool UHttpRequest::StartAttempt()
 {
 	if (Request->GetContentType() == TEXT(""))
 	{
 		SetMimeType(EHttpMimeType::txt);
 	}
 
-	return Request->ProcessRequest();
+	TransportStatus.Reset();
+	TransportElapsedTime = 0.f;
+
+	LastBytesReceived		   = 0;
+	bProgressPending		   = false;
+	LastProgressFrame		   = MAX_uint64;
+	LastProgressTime		   = 0.;
+	LastBroadcastBytes		   = 0;
+	LastBroadcastBytesReceived = 0;
+	ExpectedContentLength	   = 0;
+
+	StartTime		  = FPlatformTime::Seconds();
+	bDispatched		  = false;
+	bHadActivity	  = false;
+	bTimedOut		  = false;
+	LastActivityBytes = 0;
+	TimeToFirstByte	  = 0.f;
+	bIntegrityFailed  = false;
+	bCancelled		  = false;
+
+	// A native request keeps its stream, so requests that had one always get a new one.
+	if (FHttpResponseMemory::IsEnabled() || IntegrityCheck.IsEnabled() || ResponseStream || ResponseBody)
+	{
+		ResponseBody = MakeShared<FHttpResponseBody, ESPMode::ThreadSafe>(FHttpResponseMemory::GetSpillThreshold());
+		ResponseBody->SetForwardStream(ResponseStream);
+		Request->SetResponseBodyReceiveStream(ResponseBody.ToSharedRef());
+
+		if (IntegrityCheck.IsEnabled())
+		{
+			ResponseBody->SetHashAlgorithm(IntegrityCheck.Algorithm);
+		}
+	}
+
+	if (DeadlineBudget)
+	{
+		DeadlineBudget->Start();
+	}
+
+	// Fails on the next watchdog tick, after the caller bound its delegates.
+	if (DeadlineBudget && DeadlineBudget->IsExpired())
+	{
+		Transport.Reset();
+	}
+	else
+	{
+		Transport = FHttpTransports::Get();
+
+		// Requests waiting for bandwidth are started by the scheduler.
+		const bool bAdmitted = FHttpRequestScheduler::Admit(this);
+
+		if (bAdmitted && !Transport->ProcessRequest(this))
+		{
+			FHttpRequestScheduler::NotifyFinished(this);
+			Transport.Reset();
+			return false;
+		}
+
+		if (bAdmitted)
+		{
+			MarkDispatched();
+		}
+	}
+
+	if (!bInFlight)
+	{
+		bInFlight = true;
+		FHttpThreadTuner::NotifyRequestStarted();
+	}
+
+	if (Timeouts.HasAny() || DeadlineBudget)
+	{
+		FHttpRequestWatchdog::Watch(this);
+	}
+
+	return true;
+}
+
+void UHttpRequest::StartOnTransport()
+{
+	if (!Transport)
+	{
+		Transport = FHttpTransports::Get();
+	}
+
+	if (!Transport->ProcessRequest(this))
+	{
+		CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, EBlueprintHttpRequestStatus::Failed, 0.f);
+		return;
+	}
+
+	MarkDispatched();
+}
+
+void UHttpRequest::ReserveResponseMemory(const int64 Bytes)
+{
+	if (ResponseBody)
+	{
+		ResponseBody->Reserve(Bytes);
+	}
+}
+
+void UHttpRequest::MarkDispatched()
+{
+	bDispatched		 = true;
+	DispatchTime	 = FPlatformTime::Seconds();
+	LastActivityTime = DispatchTime;
+}
+
+double UHttpRequest::GetDeadline() const
+{
+	double Deadline = Timeouts.TotalTimeout > 0.f ? StartTime + Timeouts.TotalTimeout : 0.;
+
+	if (DeadlineBudget && DeadlineBudget->GetDeadline() != 0.)
+	{
+		Deadline = Deadline != 0. ? FMath::Min(Deadline, DeadlineBudget->GetDeadline()) : DeadlineBudget->GetDeadline();
+	}
+
+	return Deadline;
+}
+
+bool UHttpRequest::CheckTimeouts(const double Now)
+{
+	if (!bInFlight || bTimedOut)
+	{
+		return false;
+	}
+
+	const double Deadline = GetDeadline();
+
+	if (Deadline != 0. && Now >= Deadline)
+	{
+		TimeOut(DeadlineBudget && DeadlineBudget->IsExpired() ? TEXT("deadline budget") : TEXT("total timeout"));
+		return false;
+	}
+
+	// Queued requests only count against the total deadline.
+	if (!bDispatched)
+	{
+		return true;
+	}
+
+	if (!bHadActivity && Timeouts.ConnectionTimeout > 0.f && Now - DispatchTime >= Timeouts.ConnectionTimeout)
+	{
+		TimeOut(TEXT("connection timeout"));
+		return false;
+	}
+
+	if (bHadActivity && Timeouts.ActivityTimeout > 0.f && Now - LastActivityTime >= Timeouts.ActivityTimeout)
+	{
+		TimeOut(TEXT("activity timeout"));
+		return false;
+	}
+
+	return true;
+}
+
+void UHttpRequest::TimeOut(const TCHAR* const Reason)
+{
+	UE_LOG(LogHttp, Warning, TEXT("Request to \"%s\" cancelled: %s expired after %.2fs."), *GetURL(), Reason, FPlatformTime::Seconds() - StartTime);
+
+	bTimedOut = true;
+
+	if (Transport)
+	{
+		CancelRequest();
+	}
+	else
+	{
+		// Never sent, the budget had already expired.
+		CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, EBlueprintHttpRequestStatus::Failed_Timeout, 0.f);
+	}
 }
 
 void UHttpRequest::CancelRequest()
 {
-	Request->CancelRequest();
+	bCancelled = true;
+
+	if (RetryHandle.IsValid())
+	{
+		// Waiting for the next attempt, nothing to cancel on the transport.
+		FTSTicker::GetCoreTicker().RemoveTicker(RetryHandle);
+		RetryHandle.Reset();
+
+		CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, EBlueprintHttpRequestStatus::Failed, 0.f);
+	}
+	else if (FHttpRequestScheduler::Dequeue(this))
+	{
+		// Never reached the transport.
+		CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, EBlueprintHttpRequestStatus::Failed, 0.f);
+	}
+	else if (Transport)
+	{
+		Transport->CancelRequest(this);
+	}
+	else
+	{
+		Request->CancelRequest();
+	}
+}
+
+void UHttpRequest::Abandon()
+{
+	OnRequestComplete		.Clear();
+	OnRequestProgress		.Clear();
+	OnRequestHeaderReceived	.Clear();
+	OnRequestWillRetry		.Clear();
+	RequestCompleteOnWorker	.Unbind();
+
+	if (IsInFlight())
+	{
+		CancelRequest();
+	}
+}
+
+void UHttpRequest::CompleteFromTransport(UHttpResponse* const Response, const bool bConnectedSuccessfully, const EBlueprintHttpRequestStatus Status, const float ElapsedTime)
+{
+	TransportStatus		 = Status;
+	TransportElapsedTime = ElapsedTime;
+
+	CompleteRequest(Response, bConnectedSuccessfully);
+}
+
+void UHttpRequest::ReportProgressFromTransport(const int32 BytesSent, const int32 BytesReceived)
+{
+	ReportProgress(BytesSent, BytesReceived);
+}
+
+void UHttpRequest::ReportHeaderFromTransport(const FString& HeaderName, const FString& HeaderValue)
+{
+	ReportHeader(HeaderName, HeaderValue);
+}
+
+void UHttpRequest::SetProgressPolicy(const FHttpProgressPolicy& Policy)
+{
+	ProgressPolicy = Policy;
+}
+
+FHttpProgressPolicy UHttpRequest::GetProgressPolicy() const
+{
+	return ProgressPolicy;
+}
+
+void UHttpRequest::SetPriority(const EHttpRequestPriority InPriority)
+{
+	Priority = InPriority;
+}
+
+EHttpRequestPriority UHttpRequest::GetPriority() const
+{
+	return Priority;
+}
+
+void UHttpRequest::SetTimeouts(const FHttpRequestTimeouts& InTimeouts)
+{
+	Timeouts = InTimeouts;
+}
+
+FHttpRequestTimeouts UHttpRequest::GetTimeouts() const
+{
+	return Timeouts;
+}
+
+void UHttpRequest::SetRetryPolicy(const FHttpRetryPolicy& InRetryPolicy)
+{
+	RetryPolicy = InRetryPolicy;
+}
+
+FHttpRetryPolicy UHttpRequest::GetRetryPolicy() const
+{
+	return RetryPolicy;
+}
+
+int32 UHttpRequest::GetRetryCount() const
+{
+	return RetryCount;
+}
+
+bool UHttpRequest::ShouldRetry(UHttpResponse* const Response, const bool bSucceeded) const
+{
+	// A stream already received part of the failed content.
+	if (RetryCount >= RetryPolicy.MaxRetries || bIntegrityFailed || ResponseStream)
+	{
+		return false;
+	}
+
+	if (bCancelled && !bTimedOut)
+	{
+		return false;
+	}
+
+	const FString Verb = GetVerb();
+	if (!RetryPolicy.bRetryNonIdempotent && (Verb == TEXT("POST") || Verb == TEXT("PATCH")))
+	{
+		return false;
+	}
+
+	if (bTimedOut)
+	{
+		return RetryPolicy.bRetryOnTimeout && !(DeadlineBudget && DeadlineBudget->IsExpired());
+	}
+
+	if (!bSucceeded)
+	{
+		// Also covers native requests that failed with the ConnectionError failure reason.
+		return GetStatus() == EBlueprintHttpRequestStatus::Failed_ConnectionError;
+	}
+
+	const int32 ResponseCode = Response ? Response->GetResponseCode() : 0;
+
+	return RetryPolicy.bRetryOnServerErrors && (ResponseCode == 408 || ResponseCode == 429 || ResponseCode == 500
+		|| ResponseCode == 502 || ResponseCode == 503 || ResponseCode == 504);
+}
+
+float UHttpRequest::GetRetryDelay(UHttpResponse* const Response) const
+{
+	float Delay = RetryPolicy.GetBackoffDelay(RetryCount);
+
+	// Only the delay in seconds is understood, not the date.
+	const FString RetryAfter = Response ? Response->GetHeader(TEXT("Retry-After")) : FString();
+	if (!RetryAfter.IsEmpty() && RetryAfter.IsNumeric())
+	{
+		Delay = FMath::Max(Delay, FCString::Atof(*RetryAfter));
+	}
+
+	return RetryPolicy.MaxDelay > 0.f ? FMath::Min(Delay, RetryPolicy.MaxDelay) : Delay;
+}
+
+void UHttpRequest::ScheduleRetry(UHttpResponse* const Response)
+{
+	const float Delay = GetRetryDelay(Response);
+
+	++RetryCount;
+
+	UE_LOG(LogHttp, Log, TEXT("Request to \"%s\" failed (%d), retry %d/%d in %.2fs."),
+		*GetURL(), Response ? Response->GetResponseCode() : 0, RetryCount, RetryPolicy.MaxRetries, Delay);
+
+	RetryHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+	{
+		RetryHandle.Reset();
+
+		if (!StartAttempt())
+		{
+			CompleteFromTransport(UHttpResponse::CreateFromSnapshot(nullptr, 0.f), false, EBlueprintHttpRequestStatus::Failed, 0.f);
+		}
+
+		return false;
+	}), Delay);
+
+	OnRequestWillRetry.Broadcast(this, Response, Delay);
+}
+
+void UHttpRequest::SetDeadlineBudget(UHttpDeadlineBudget* const Budget)
+{
+	DeadlineBudget = Budget;
+}
+
+UHttpDeadlineBudget* UHttpRequest::GetDeadlineBudget() const
+{
+	return DeadlineBudget;
+}
+
+void UHttpRequest::SetResponseStream(const TSharedPtr<FArchive, ESPMode::ThreadSafe>& Stream)
+{
+	ResponseStream = Stream;
+}
+
+void UHttpRequest::SetIntegrityCheck(const FHttpIntegrityCheck& InIntegrityCheck)
+{
+	IntegrityCheck = InIntegrityCheck;
+}
+
+FHttpIntegrityCheck UHttpRequest::GetIntegrityCheck() const
+{
+	return IntegrityCheck;
+}
+
+bool UHttpRequest::VerifyIntegrity(UHttpResponse* const Response)
+{
+	if (!IntegrityCheck.IsEnabled() || !Response || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	{
+		return true;
+	}
+
+	const FString AlgorithmName = UEnum::GetDisplayValueAsText(IntegrityCheck.Algorithm).ToString();
+
+	const FString ExpectedValue = IntegrityCheck.ExpectedDigest.IsEmpty()
+		? Response->GetHeader(IntegrityCheck.DigestHeader)
+		: IntegrityCheck.ExpectedDigest;
+
+	TArray<uint8> Expected;
+	TArray<uint8> Digest;
+
+	if (!FHttpStreamingHash::ParseDigest(ExpectedValue, IntegrityCheck.Algorithm, Expected))
+	{
+		UE_LOG(LogHttp, Error, TEXT("Request to \"%s\" failed its integrity check: no %s digest in \"%s\"."), *GetURL(), *AlgorithmName, *ExpectedValue);
+		bIntegrityFailed = true;
+	}
+	else
+	{
+		if (ResponseBody && Response->GetBody() == ResponseBody)
+		{
+			Digest = ResponseBody->GetDigest();
+		}
+		else
+		{
+			// Served by a transport, the content is already in memory.
+			TArray<uint8> Content;
+			Response->GetContent(Content);
+
+			FHttpStreamingHash Hash(IntegrityCheck.Algorithm);
+			Hash.Update(Content.GetData(), Content.Num());
+			Digest = Hash.Finalize();
+		}
+
+		bIntegrityFailed = Digest != Expected;
+
+		UE_CLOG(bIntegrityFailed, LogHttp, Error, TEXT("Request to \"%s\" failed its integrity check: expected %s %s, received %s."),
+			*GetURL(), *AlgorithmName, *BytesToHex(Expected.GetData(), Expected.Num()), *BytesToHex(Digest.GetData(), Digest.Num()));
+	}
+
+	// The corrupt content is never handed out.
+	if (bIntegrityFailed && ResponseBody)
+	{
+		ResponseBody->Discard();
+	}
+
+	return !bIntegrityFailed;
+}
+
+float UHttpRequest::GetTimeToFirstByte() const
+{
+	return TimeToFirstByte;
+}
+
+void UHttpRequest::NoteFirstByte()
+{
+	if (TimeToFirstByte > 0.f || !bInFlight)
+	{
+		return;
+	}
+
+	// Time spent waiting for bandwidth isn't the server's.
+	TimeToFirstByte = FMath::Max(static_cast<float>(FPlatformTime::Seconds() - (bDispatched ? DispatchTime : StartTime)), UE_SMALL_NUMBER);
+
+	FHttpConnectionWarmer::ReportFirstByte(FPlatformHttp::GetUrlDomain(GetURL()), TimeToFirstByte);
+}
+
+void UHttpRequest::SetDefaultProgressPolicy(const FHttpProgressPolicy& Policy)
+{
+	DefaultProgressPolicy = Policy;
+}
+
+const FHttpProgressPolicy& UHttpRequest::GetDefaultProgressPolicy()
+{
+	return DefaultProgressPolicy;
+}
+
+void UHttpRequest::CompleteRequest(UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	if (Transport && Transport->DeferCompletion(this, Response, bConnectedSuccessfully))
+	{
+		return;
+	}
+
+	const bool bSucceeded = bConnectedSuccessfully && VerifyIntegrity(Response);
+
+	if (bInFlight)
+	{
+		bInFlight = false;
+		FHttpThreadTuner::NotifyRequestFinished();
+	}
+
+	if (ResponseBody)
+	{
+		ResponseBody->Complete();
+	}
+
+	FHttpRequestScheduler::NotifyFinished(this);
+
+	// Listeners see the last progress before the completion.
+	FlushProgress();
+
+	// Released first so the request can be started again from the delegates.
+	const TSharedPtr<IHttpTransport> CompletedTransport = MoveTemp(Transport);
+
+	if (CompletedTransport)
+	{
+		CompletedTransport->OnRequestCompleted(this, Response, bSucceeded);
+	}
+
+	// Only the last attempt is delivered.
+	if (RetryPolicy.IsEnabled() && ShouldRetry(Response, bSucceeded))
+	{
+		ScheduleRetry(Response);
+		return;
+	}
+
+	// Started before the game thread delivery so it doesn't wait for the frame budget.
+	if (RequestCompleteOnWorker.IsBound())
+	{
+		const TSharedRef<const FHttpWorkerCompletion, ESPMode::ThreadSafe> Completion = FHttpWorkerCompletion::Capture(this, Response, bSucceeded);
+
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Delegate = RequestCompleteOnWorker, Completion]()
+		{
+			Delegate.ExecuteIfBound(*Completion);
+		}, Priority == EHttpRequestPriority::Background ? UE::Tasks::ETaskPriority::BackgroundNormal : UE::Tasks::ETaskPriority::Normal);
+	}
+
+	FHttpCompletionDispatcher::Dispatch(this, Response, bSucceeded);
+}
+
+void UHttpRequest::DeliverCompletion(UHttpResponse* const Response, const bool bConnectedSuccessfully)
+{
+	OnRequestComplete.Broadcast(this, Response, bConnectedSuccessfully);
 }
 
 void UHttpRequest::OnRequestCompleteInternal(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, TSharedPtr<IHttpResponse, ESPMode::ThreadSafe>  RawResponse, bool bConnectedSuccessfully)
 {
-	OnRequestComplete.Broadcast(this, CreateResponse(RawRequest, RawResponse), bConnectedSuccessfully);
+	CompleteRequest(CreateResponse(RawRequest, RawResponse), bConnectedSuccessfully);
 }
 
 void UHttpRequest::OnRequestProgressInternal(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, const int32 BytesSent, const int32 BytesReceived)
 {
-	OnRequestProgress.Broadcast(this, BytesSent, BytesReceived);
+	ReportProgress(BytesSent, BytesReceived);
 }
 
-void UHttpRequest::OnHeaderReceivedInternal(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, const FString& HeaderName, const FString& HeaderValue)
+void UHttpRequest::ReportProgress(const int32 BytesSent, const int32 BytesReceived)
+{
+	if (bDispatched && static_cast<int64>(BytesSent) + BytesReceived > LastActivityBytes)
+	{
+		bHadActivity	  = true;
+		LastActivityTime  = FPlatformTime::Seconds();
+		LastActivityBytes = static_cast<int64>(BytesSent) + BytesReceived;
+	}
+
+	if (BytesReceived > 0)
+	{
+		NoteFirstByte();
+	}
+
+	if (BytesReceived > LastBytesReceived)
+	{
+		FHttpThreadTuner::NotifyBytesReceived(BytesReceived - LastBytesReceived);
+		FHttpRequestScheduler::NotifyBytesReceived(this, BytesReceived - LastBytesReceived);
+		LastBytesReceived = BytesReceived;
+	}
+
+	// Nothing to build when nobody listens.
+	if (ProgressPolicy.Reporting == EHttpProgressReporting::Off || !OnRequestProgress.IsBound())
+	{
+		return;
+	}
+
+	PendingBytesSent	  = BytesSent;
+	PendingBytesReceived  = BytesReceived;
+	bProgressPending	  = true;
+	LastProgressEventTime = FPlatformTime::Seconds();
+
+	if (ShouldBroadcastProgress(BytesSent, BytesReceived))
+	{
+		FlushProgress();
+	}
+	else
+	{
+		ScheduleProgressFlush();
+	}
+}
+
+bool UHttpRequest::ShouldBroadcastProgress(const int32 BytesSent, const int32 BytesReceived) const
+{
+	// Coalesces the events of a frame.
+	if (LastProgressFrame == GFrameCounter)
+	{
+		return false;
+	}
+
+	if (ProgressPolicy.Reporting != EHttpProgressReporting::Throttled)
+	{
+		return true;
+	}
+
+	if (FPlatformTime::Seconds() - LastProgressTime < ProgressPolicy.MinInterval)
+	{
+		return false;
+	}
+
+	const bool bHasByteDelta	= ProgressPolicy.MinBytesDelta > 0;
+	const bool bHasPercentDelta = ProgressPolicy.MinPercentDelta > 0.f && ExpectedContentLength > 0;
+
+	if (!bHasByteDelta && !bHasPercentDelta)
+	{
+		return true;
+	}
+
+	const bool bByteDeltaReached = bHasByteDelta
+		&& (static_cast<int64>(BytesSent) + BytesReceived - LastBroadcastBytes) >= ProgressPolicy.MinBytesDelta;
+
+	const bool bPercentDeltaReached = bHasPercentDelta
+		&& (BytesReceived - LastBroadcastBytesReceived) * 100.f / ExpectedContentLength >= ProgressPolicy.MinPercentDelta;
+
+	return bByteDeltaReached || bPercentDeltaReached;
+}
+
+void UHttpRequest::FlushProgress()
 {
+	if (!bProgressPending)
+	{
+		return;
+	}
+
+	bProgressPending		   = false;
+	LastProgressFrame		   = GFrameCounter;
+	LastProgressTime		   = FPlatformTime::Seconds();
+	LastBroadcastBytes		   = PendingBytesSent + PendingBytesReceived;
+	LastBroadcastBytesReceived = PendingBytesReceived;
+
+	OnRequestProgress.Broadcast(this, PendingBytesSent, PendingBytesReceived);
+}
+
+void UHttpRequest::ScheduleProgressFlush()
+{
+	if (ProgressFlushHandle.IsValid())
+	{
+		return;
+	}
+
+	// Without it a stalled transfer would never report its last bytes. Deltas still apply while events keep coming.
+	const float Interval = ProgressPolicy.Reporting == EHttpProgressReporting::Throttled ? FMath::Max(ProgressPolicy.MinInterval, MinProgressStallInterval) : 0.f;
+
+	ProgressFlushHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, Interval](float)
+	{
+		if (bProgressPending && (LastProgressFrame == GFrameCounter || FPlatformTime::Seconds() - LastProgressEventTime < Interval))
+		{
+			return true;
+		}
+
+		ProgressFlushHandle.Reset();
+
+		FlushProgress();
+
+		return false;
+	}), Interval);
+}
+
+void UHttpRequest::ReportHeader(const FString& HeaderName, const FString& HeaderValue)
+{
+	if (bDispatched)
+	{
+		bHadActivity	 = true;
+		LastActivityTime = FPlatformTime::Seconds();
+	}
+
+	NoteFirstByte();
+
+	if (HeaderName.Equals(TEXT("Content-Length"), ESearchCase::IgnoreCase))
+	{
+		LexFromString(ExpectedContentLength, *HeaderValue);
+
+		if (ResponseBody)
+		{
+			ResponseBody->SetExpectedSize(ExpectedContentLength);
+		}
+	}
+
 	OnRequestHeaderReceived.Broadcast(this, HeaderName, HeaderValue);
 }
 
+void UHttpRequest::BeginDestroy()
+{
+	if (RetryHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RetryHandle);
+		RetryHandle.Reset();
+	}
+
+	if (ProgressFlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ProgressFlushHandle);
+		ProgressFlushHandle.Reset();
+	}
+
+	// Requests collected before completing never broadcast.
+	if (bInFlight)
+	{
+		bInFlight = false;
+		FHttpThreadTuner::NotifyRequestFinished();
+		FHttpRequestScheduler::NotifyFinished(this);
+	}
+
+	if (ResponseBody)
+	{
+		ResponseBody->Complete();
+	}
+
+	Super::BeginDestroy();
+}
+
+void UHttpRequest::OnHeaderReceivedInternal(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, const FString& HeaderName, const FString& HeaderValue)
+{
+	ReportHeader(HeaderName, HeaderValue);
+}
+
 void UHttpRequest::OnRequestWillRetryInternal(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> RawResponse, float SecondsToRetry)
 {
 	OnRequestWillRetry.Broadcast(this, CreateResponse(RawRequest, RawResponse), SecondsToRetry);
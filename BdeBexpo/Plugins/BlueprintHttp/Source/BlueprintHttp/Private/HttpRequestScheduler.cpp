@@ -0,0 +1,422 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpRequestScheduler.h"
+#include "HttpResponseBody.h"
+#include "BlueprintHttpStats.h"
+#include "Http.h"
+#include "Interfaces/IHttpRequest.h"
+#include "PlatformHttp.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Requests Waiting For Bandwidth"), STAT_BlueprintHttp_BandwidthQueue, STATGROUP_BlueprintHttp);
+
+namespace
+{
+	/* Seconds of traffic a bucket can save up. */
+	constexpr double BurstSeconds = 1.;
+
+	constexpr int32 PriorityCount = 3;
+
+	struct FBucketPair
+	{
+		FHttpTokenBucket Download;
+		FHttpTokenBucket Upload;
+
+		void SetLimit(const FHttpBandwidthLimit& Limit)
+		{
+			Download.SetRate(Limit.DownloadKBps * 1024.);
+			Upload	.SetRate(Limit.UploadKBps	* 1024.);
+		}
+
+		void Refill(const double Now)
+		{
+			Download.Refill(Now);
+			Upload	.Refill(Now);
+		}
+
+		bool IsLimited() const
+		{
+			return Download.IsLimited() || Upload.IsLimited();
+		}
+	};
+
+	struct FSchedulerState
+	{
+		FBucketPair Global;
+		FBucketPair Priorities[PriorityCount];
+
+		TMap<FString, FHttpBandwidthLimit> HostLimits;
+		FHttpBandwidthLimit DefaultHostLimit;
+		TMap<FString, FBucketPair> HostBuckets;
+
+		/* Queued requests, one FIFO per priority. */
+		TArray<TWeakObjectPtr<UHttpRequest>> Queues[PriorityCount];
+
+		/* Host of the admitted requests, to charge their downloads. */
+		TMap<const UHttpRequest*, FString> ActiveHosts;
+
+		FTSTicker::FDelegateHandle TickerHandle;
+
+		bool HasLimits() const
+		{
+			bool bHasHostLimits = !DefaultHostLimit.IsUnlimited();
+			for (const auto& Pair : HostLimits)
+			{
+				bHasHostLimits |= !Pair.Value.IsUnlimited();
+			}
+
+			return Global.IsLimited() || bHasHostLimits || FHttpResponseMemory::GetBudget() > 0
+				|| Priorities[0].IsLimited() || Priorities[1].IsLimited() || Priorities[2].IsLimited();
+		}
+
+		int32 GetQueuedCount() const
+		{
+			return Queues[0].Num() + Queues[1].Num() + Queues[2].Num();
+		}
+
+		FBucketPair& GetHostBuckets(const FString& Host)
+		{
+			if (FBucketPair* const Buckets = HostBuckets.Find(Host))
+			{
+				return *Buckets;
+			}
+
+			FBucketPair& Buckets = HostBuckets.Add(Host);
+			const FHttpBandwidthLimit* const Limit = HostLimits.Find(Host);
+			Buckets.SetLimit(Limit ? *Limit : DefaultHostLimit);
+			return Buckets;
+		}
+	};
+
+	FSchedulerState& GetState()
+	{
+		static FSchedulerState State;
+		return State;
+	}
+
+	/* The direction of a transfer. */
+	using FBucketSelector = FHttpTokenBucket FBucketPair::*;
+
+	/* Foreground requests can use the Background tokens when their own are spent. */
+	bool CanBorrow(const FSchedulerState& State, const EHttpRequestPriority Priority, const FBucketSelector Direction)
+	{
+		return Priority != EHttpRequestPriority::Background
+			&& (State.Priorities[static_cast<int32>(EHttpRequestPriority::Background)].*Direction).GetAvailable() > 0.;
+	}
+
+	bool CanTransfer(const FSchedulerState& State, const FBucketPair& HostBuckets, const EHttpRequestPriority Priority, const FBucketSelector Direction)
+	{
+		const FHttpTokenBucket& PriorityBucket = State.Priorities[static_cast<int32>(Priority)].*Direction;
+
+		return !(State.Global.*Direction).IsInDebt()
+			&& !(HostBuckets.*Direction).IsInDebt()
+			&& (!PriorityBucket.IsInDebt() || CanBorrow(State, Priority, Direction));
+	}
+
+	void Charge(FSchedulerState& State, FBucketPair& HostBuckets, const EHttpRequestPriority Priority, const FBucketSelector Direction, const double Bytes)
+	{
+		(State.Global.*Direction).Consume(Bytes);
+		(HostBuckets.*Direction).Consume(Bytes);
+
+		FHttpTokenBucket& PriorityBucket = State.Priorities[static_cast<int32>(Priority)].*Direction;
+
+		double Borrowed = 0.;
+		if (PriorityBucket.IsLimited() && Priority != EHttpRequestPriority::Background)
+		{
+			FHttpTokenBucket& BackgroundBucket = State.Priorities[static_cast<int32>(EHttpRequestPriority::Background)].*Direction;
+
+			const double Missing = Bytes - PriorityBucket.GetAvailable();
+			Borrowed = FMath::Clamp(Missing, 0., BackgroundBucket.GetAvailable());
+
+			BackgroundBucket.Consume(Borrowed);
+		}
+
+		PriorityBucket.Consume(Bytes - Borrowed);
+	}
+
+	bool TryAdmit(FSchedulerState& State, UHttpRequest* const Request)
+	{
+		// Waits for the requests in flight to release enough of their response buffers for this one.
+		const int64 Reservation = FHttpResponseMemory::GetBudget() > 0 ? FHttpResponseMemory::GetReservation() : 0;
+
+		if (!FHttpResponseMemory::HasRoom(Reservation))
+		{
+			return false;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+
+		const FString Host = FPlatformHttp::GetUrlDomain(Request->GetURL());
+		const EHttpRequestPriority Priority = Request->GetPriority();
+
+		FBucketPair& HostBuckets = State.GetHostBuckets(Host);
+
+		State.Global.Refill(Now);
+		HostBuckets .Refill(Now);
+		for (FBucketPair& Buckets : State.Priorities)
+		{
+			Buckets.Refill(Now);
+		}
+
+		if (!CanTransfer(State, HostBuckets, Priority, &FBucketPair::Download) || !CanTransfer(State, HostBuckets, Priority, &FBucketPair::Upload))
+		{
+			return false;
+		}
+
+		Charge(State, HostBuckets, Priority, &FBucketPair::Upload, static_cast<double>(Request->GetNativeRequest()->GetContentLength()));
+
+		State.ActiveHosts.Add(Request, Host);
+
+		Request->ReserveResponseMemory(Reservation);
+
+		return true;
+	}
+
+	void UpdateStats(const FSchedulerState& State)
+	{
+		SET_DWORD_STAT(STAT_BlueprintHttp_BandwidthQueue, State.GetQueuedCount());
+	}
+
+	bool Tick(float)
+	{
+		FSchedulerState& State = GetState();
+
+		for (int32 Priority = PriorityCount - 1; Priority >= 0; --Priority)
+		{
+			TArray<TWeakObjectPtr<UHttpRequest>>& Queue = State.Queues[Priority];
+
+			while (Queue.Num() > 0)
+			{
+				UHttpRequest* const Request = Queue[0].Get();
+
+				if (Request && !TryAdmit(State, Request))
+				{
+					break;
+				}
+
+				Queue.RemoveAt(0, 1, EAllowShrinking::No);
+
+				if (Request)
+				{
+					Request->StartOnTransport();
+				}
+			}
+		}
+
+		UpdateStats(State);
+
+		if (State.GetQueuedCount() == 0)
+		{
+			State.TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+}
+
+void FHttpTokenBucket::SetRate(const double InRate)
+{
+	Rate		   = InRate;
+	Tokens		   = FMath::Max(InRate, 0.) * BurstSeconds;
+	LastRefillTime = FPlatformTime::Seconds();
+}
+
+void FHttpTokenBucket::Refill(const double Now)
+{
+	if (IsLimited())
+	{
+		Tokens = FMath::Min(Tokens + (Now - LastRefillTime) * Rate, Rate * BurstSeconds);
+	}
+
+	LastRefillTime = Now;
+}
+
+void FHttpTokenBucket::Consume(const double Bytes)
+{
+	if (IsLimited())
+	{
+		Tokens -= Bytes;
+	}
+}
+
+void FHttpRequestScheduler::SetGlobalLimit(const FHttpBandwidthLimit& Limit)
+{
+	GetState().Global.SetLimit(Limit);
+}
+
+void FHttpRequestScheduler::SetHostLimit(const FString& Host, const FHttpBandwidthLimit& Limit)
+{
+	FSchedulerState& State = GetState();
+
+	if (Host.IsEmpty())
+	{
+		State.DefaultHostLimit = Limit;
+	}
+	else
+	{
+		// Kept when unlimited so the host doesn't fall back to the default limit.
+		State.HostLimits.Add(Host, Limit);
+	}
+
+	for (auto& Pair : State.HostBuckets)
+	{
+		const FHttpBandwidthLimit* const HostLimit = State.HostLimits.Find(Pair.Key);
+		Pair.Value.SetLimit(HostLimit ? *HostLimit : State.DefaultHostLimit);
+	}
+}
+
+void FHttpRequestScheduler::SetPriorityLimit(const EHttpRequestPriority Priority, const FHttpBandwidthLimit& Limit)
+{
+	GetState().Priorities[static_cast<int32>(Priority)].SetLimit(Limit);
+}
+
+void FHttpRequestScheduler::ClearLimits()
+{
+	FSchedulerState& State = GetState();
+
+	State.Global.SetLimit(FHttpBandwidthLimit());
+
+	for (FBucketPair& Buckets : State.Priorities)
+	{
+		Buckets.SetLimit(FHttpBandwidthLimit());
+	}
+
+	State.HostLimits.Empty();
+	State.HostBuckets.Empty();
+	State.DefaultHostLimit = FHttpBandwidthLimit();
+
+	if (State.GetQueuedCount() > 0)
+	{
+		Tick(0.f);
+	}
+}
+
+bool FHttpRequestScheduler::Admit(UHttpRequest* const Request)
+{
+	FSchedulerState& State = GetState();
+
+	if (!State.HasLimits())
+	{
+		return true;
+	}
+
+	// Requests of the same or a higher priority that are already waiting go first.
+	bool bHasPriorityQueued = false;
+	for (int32 Priority = static_cast<int32>(Request->GetPriority()); Priority < PriorityCount; ++Priority)
+	{
+		bHasPriorityQueued |= State.Queues[Priority].Num() > 0;
+	}
+
+	if (!bHasPriorityQueued && TryAdmit(State, Request))
+	{
+		return true;
+	}
+
+	State.Queues[static_cast<int32>(Request->GetPriority())].Add(Request);
+
+	UpdateStats(State);
+
+	if (!State.TickerHandle.IsValid())
+	{
+		State.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+	}
+
+	return false;
+}
+
+bool FHttpRequestScheduler::Dequeue(UHttpRequest* const Request)
+{
+	FSchedulerState& State = GetState();
+
+	for (TArray<TWeakObjectPtr<UHttpRequest>>& Queue : State.Queues)
+	{
+		if (Queue.RemoveSingle(Request) > 0)
+		{
+			UpdateStats(State);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FHttpRequestScheduler::NotifyBytesReceived(const UHttpRequest* const Request, const int64 Bytes)
+{
+	FSchedulerState& State = GetState();
+
+	const FString* const Host = State.ActiveHosts.Find(Request);
+	if (!Host)
+	{
+		return;
+	}
+
+	Charge(State, State.GetHostBuckets(*Host), Request->GetPriority(), &FBucketPair::Download, static_cast<double>(Bytes));
+}
+
+void FHttpRequestScheduler::NotifyFinished(const UHttpRequest* const Request)
+{
+	GetState().ActiveHosts.Remove(Request);
+}
+
+int32 FHttpRequestScheduler::GetQueuedCount()
+{
+	return GetState().GetQueuedCount();
+}
+
+void FHttpRequestScheduler::Reset()
+{
+	FSchedulerState& State = GetState();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(State.TickerHandle);
+	State.TickerHandle.Reset();
+
+	for (TArray<TWeakObjectPtr<UHttpRequest>>& Queue : State.Queues)
+	{
+		Queue.Empty();
+	}
+
+	State.ActiveHosts.Empty();
+
+	UpdateStats(State);
+}
+
+static FAutoConsoleCommand GHttpBandwidthCommand(
+	TEXT("http.Bandwidth"),
+	TEXT("Limits the bandwidth of BlueprintHttp requests. Args: <Global|Host=<Host>|Background|Normal|Interactive|Clear> <DownloadKBps> <UploadKBps>. 0 is unlimited."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	if (Args.Num() > 0 && Args[0] == TEXT("Clear"))
+	{
+		FHttpRequestScheduler::ClearLimits();
+		return;
+	}
+
+	if (Args.Num() < 3)
+	{
+		UE_LOG(LogHttp, Display, TEXT("Bandwidth: %d requests waiting."), FHttpRequestScheduler::GetQueuedCount());
+		return;
+	}
+
+	FHttpBandwidthLimit Limit;
+	Limit.DownloadKBps = FCString::Atof(*Args[1]);
+	Limit.UploadKBps   = FCString::Atof(*Args[2]);
+
+	FString Host;
+	const int64 Priority = StaticEnum<EHttpRequestPriority>()->GetValueByNameString(Args[0]);
+
+	if (Args[0] == TEXT("Global"))
+	{
+		FHttpRequestScheduler::SetGlobalLimit(Limit);
+	}
+	else if (Args[0].Split(TEXT("="), nullptr, &Host))
+	{
+		FHttpRequestScheduler::SetHostLimit(Host, Limit);
+	}
+	else if (Priority != INDEX_NONE)
+	{
+		FHttpRequestScheduler::SetPriorityLimit(static_cast<EHttpRequestPriority>(Priority), Limit);
+	}
+})
+);
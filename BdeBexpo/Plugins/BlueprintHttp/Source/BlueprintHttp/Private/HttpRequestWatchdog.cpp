@@ -0,0 +1,77 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpRequestWatchdog.h"
+#include "HttpRequest.h"
+#include "BlueprintHttpStats.h"
+#include "Containers/Ticker.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Requests With Timeouts"), STAT_BlueprintHttp_WatchedRequests, STATGROUP_BlueprintHttp);
+
+namespace
+{
+	/* Seconds between two checks, the precision of the time limits. */
+	constexpr float WatchdogInterval = 0.05f;
+
+	struct FWatchdogState
+	{
+		TArray<TWeakObjectPtr<UHttpRequest>> Requests;
+
+		FTSTicker::FDelegateHandle TickerHandle;
+	};
+
+	FWatchdogState& GetState()
+	{
+		static FWatchdogState State;
+		return State;
+	}
+
+	bool Tick(float)
+	{
+		FWatchdogState& State = GetState();
+
+		const double Now = FPlatformTime::Seconds();
+
+		// Timing out completes requests, which can process new ones from their delegates.
+		for (int32 Index = State.Requests.Num() - 1; Index >= 0 && Index < State.Requests.Num(); --Index)
+		{
+			UHttpRequest* const Request = State.Requests[Index].Get();
+
+			if (!Request || !Request->CheckTimeouts(Now))
+			{
+				State.Requests.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			}
+		}
+
+		SET_DWORD_STAT(STAT_BlueprintHttp_WatchedRequests, State.Requests.Num());
+
+		if (State.Requests.Num() == 0)
+		{
+			State.TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+}
+
+void FHttpRequestWatchdog::Watch(UHttpRequest* const Request)
+{
+	FWatchdogState& State = GetState();
+
+	State.Requests.AddUnique(Request);
+
+	if (!State.TickerHandle.IsValid())
+	{
+		State.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick), WatchdogInterval);
+	}
+}
+
+void FHttpRequestWatchdog::Reset()
+{
+	FWatchdogState& State = GetState();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(State.TickerHandle);
+	State.TickerHandle.Reset();
+
+	State.Requests.Empty();
+}
@@ -0,0 +1,20 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UHttpRequest;
+
+/**
+ *  Checks the time limits of the requests in flight from the core ticker.
+ **/
+class FHttpRequestWatchdog
+{
+public:
+	/* Checks the request until it completes. */
+	static void Watch(UHttpRequest* const Request);
+
+	/* Stops checking the requests. */
+	static void Reset();
+};
@@ -1,14 +1,62 @@
 // Copyright Pandores Marketplace 2024. All Rights Reserved.
 
 #include "HttpResponse.h"
+#include "HttpHeaderUtils.h"
+#include "HttpResponseBody.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+
+FString FHttpResponseSnapshot::GetHeader(const FString& Key) const
+{
+	for (const FString& Header : Headers)
+	{
+		if (Header.StartsWith(Key, ESearchCase::IgnoreCase) && Header.Mid(Key.Len(), 2) == TEXT(": "))
+		{
+			return Header.Mid(Key.Len() + 2);
+		}
+	}
+
+	return FString();
+}
+
+TSharedRef<FHttpResponseSnapshot, ESPMode::ThreadSafe> FHttpResponseSnapshot::Capture(const IHttpResponse& Response)
+{
+	TSharedRef<FHttpResponseSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FHttpResponseSnapshot, ESPMode::ThreadSafe>();
+
+	Snapshot->URL			= Response.GetURL();
+	Snapshot->ResponseCode	= Response.GetResponseCode();
+	Snapshot->Headers		= Response.GetAllHeaders();
+	Snapshot->Content		= Response.GetContent();
+
+	return Snapshot;
+}
+
+FArchive& operator<<(FArchive& Ar, FHttpResponseSnapshot& Snapshot)
+{
+	Ar << Snapshot.URL;
+	Ar << Snapshot.ResponseCode;
+	Ar << Snapshot.Headers;
+	Ar << Snapshot.Content;
+
+	return Ar;
+}
 
 UHttpResponse::UHttpResponse()
 	: Super()
 	, RequestDuration(0.f)
 {}
 
+UHttpResponse* UHttpResponse::CreateFromSnapshot(TSharedPtr<const FHttpResponseSnapshot, ESPMode::ThreadSafe> InSnapshot, const float InRequestDuration)
+{
+	UHttpResponse* const WrappedResponse = NewObject<UHttpResponse>();
+
+	WrappedResponse->Snapshot		 = MoveTemp(InSnapshot);
+	WrappedResponse->RequestDuration = InRequestDuration;
+
+	return WrappedResponse;
+}
+
 void UHttpResponse::InitInternal(TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> InResponse, const float& InRequestDuration)
 {
 	Response = InResponse;
@@ -17,83 +65,108 @@ void UHttpResponse::InitInternal(TSharedPtr<IHttpResponse, ESPMode::ThreadSafe>
 
 TMap<FString, FString> UHttpResponse::GetAllHeaders() const
 {
-	if (!Response)
+	if (Snapshot)
 	{
-		return TMap<FString, FString>();
+		return BlueprintHttp::SplitHeaders(Snapshot->Headers);
 	}
 
-	TArray<FString> Headers = Response->GetAllHeaders();
-
-	TMap<FString, FString> OutHeaders;
-	
-	FString* Key;
-	FString* Value;
-
-	for (FString & Header : Headers)
+	if (!Response)
 	{
-		Key		= nullptr;
-		Value	= nullptr;
-
-		Header.Split(TEXT(": "), Key, Value, ESearchCase::CaseSensitive);
-
-		if (Key && Value)
-		{
-			OutHeaders.Emplace(*Key, *Value);
-		}
+		return TMap<FString, FString>();
 	}
 
-	return OutHeaders;
+	return BlueprintHttp::SplitHeaders(Response->GetAllHeaders());
 }
 
 void UHttpResponse::GetContent(TArray<uint8>& OutContent) const
 {
-	if (Response)
+	if (Body)
+	{
+		OutContent = Body->GetContent();
+	}
+	else if (Response)
 	{
 		OutContent = Response->GetContent();
 	}
+	else if (Snapshot)
+	{
+		OutContent = Snapshot->Content;
+	}
 }
 
 FString UHttpResponse::GetContentAsString() const
 {
+	if (Body)
+	{
+		const TArray<uint8>& Content = Body->GetContent();
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData()), Content.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
 	if (Response)
 	{
 		return Response->GetContentAsString();
 	}
+	if (Snapshot)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Snapshot->Content.GetData()), Snapshot->Content.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
 	return TEXT("");
 }
 
 int32 UHttpResponse::GetContentLength() const
 {
-	return Response ? Response->GetContentLength() : 0;
+	return Body ? static_cast<int32>(Body->GetSize()) : Response ? static_cast<int32>(Response->GetContentLength()) : Snapshot ? Snapshot->Content.Num() : 0;
 }
 
 FString UHttpResponse::GetContentType() const
 {
-	return Response ? Response->GetContentType() : TEXT("");
+	return Response ? Response->GetContentType() : Snapshot ? Snapshot->GetHeader(TEXT("Content-Type")) : TEXT("");
 }
 
 FString UHttpResponse::GetHeader(const FString& Key) const
 {
-	return Response ? Response->GetHeader(Key) : TEXT("");
+	return Response ? Response->GetHeader(Key) : Snapshot ? Snapshot->GetHeader(Key) : TEXT("");
 }
 
 int32 UHttpResponse::GetResponseCode() const
 {
-	return Response ? Response->GetResponseCode() : -1;
+	return Response ? Response->GetResponseCode() : Snapshot ? Snapshot->ResponseCode : -1;
 }
 
 FString UHttpResponse::GetURL() const
 {
-	return Response ? Response->GetURL() : TEXT("");
+	return Response ? Response->GetURL() : Snapshot ? Snapshot->URL : TEXT("");
 }
 
 FString UHttpResponse::GetURLParameter(const FString& ParameterName) const
 {
-	return Response ? Response->GetURLParameter(ParameterName) : TEXT("");
+	const FHttpUrl& Url = GetCachedUrl();
+	if (!Url.IsValid())
+	{
+		return Snapshot ? FGenericPlatformHttp::GetUrlParameter(Snapshot->URL, ParameterName).Get(FString()) : Response ? Response->GetURLParameter(ParameterName) : TEXT("");
+	}
+
+	const FString* const Value = Url.FindQueryParameter(ParameterName);
+	return Value ? *Value : FString();
+}
+
+FHttpUrl UHttpResponse::GetParsedURL() const
+{
+	return GetCachedUrl();
+}
+
+const FHttpUrl& UHttpResponse::GetCachedUrl() const
+{
+	if (!ParsedUrl.IsSet())
+	{
+		FHttpUrl::Parse(GetURL(), ParsedUrl.Emplace());
+	}
+
+	return ParsedUrl.GetValue();
 }
 
 float UHttpResponse::GetElapsedTime() const
 {
 	return RequestDuration;
 }
-
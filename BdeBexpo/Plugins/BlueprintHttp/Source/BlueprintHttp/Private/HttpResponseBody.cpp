@@ -0,0 +1,373 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpResponseBody.h"
+#include "BlueprintHttpStats.h"
+#include "Http.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+LLM_DEFINE_TAG(BlueprintHttp_ResponseBuffers);
+
+DECLARE_MEMORY_STAT(TEXT("Buffered Responses"), STAT_BlueprintHttp_BufferedResponses, STATGROUP_BlueprintHttp);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spilled Responses"), STAT_BlueprintHttp_SpilledResponses, STATGROUP_BlueprintHttp);
+
+static int32 GHttpResponseBudgetMB = 0;
+static FAutoConsoleVariableRef CVarHttpResponseBudget(
+	TEXT("http.Memory.ResponseBudgetMB"),
+	GHttpResponseBudgetMB,
+	TEXT("Response bytes BlueprintHttp requests in flight can hold in memory, in megabytes. New requests wait while it's exhausted. 0 disables it."));
+
+static int32 GHttpResponseSpillThresholdMB = 0;
+static FAutoConsoleVariableRef CVarHttpResponseSpillThreshold(
+	TEXT("http.Memory.SpillThresholdMB"),
+	GHttpResponseSpillThresholdMB,
+	TEXT("Size above which BlueprintHttp responses are moved to temporary files, in megabytes. 0 disables it."));
+
+static int32 GHttpResponseReservationKB = 1024;
+static FAutoConsoleVariableRef CVarHttpResponseReservation(
+	TEXT("http.Memory.ReservationKB"),
+	GHttpResponseReservationKB,
+	TEXT("Response bytes reserved in the budget for a BlueprintHttp request when it's admitted, until its Content-Length is received, in kilobytes."));
+
+namespace
+{
+	std::atomic<int64> GBufferedResponseBytes(0);
+
+	constexpr int64 BytesPerKB = 1024;
+	constexpr int64 BytesPerMB = 1024 * 1024;
+}
+
+FHttpResponseBody::FHttpResponseBody(const int64 InSpillThreshold)
+	: Size(0)
+	, SpillThreshold(InSpillThreshold)
+	, CountedBytes(0)
+	, ReservedBytes(0)
+	, bSpillRequested(false)
+	, bCanSpill(true)
+	, bCompleted(false)
+	, bLoaded(false)
+{
+	SetIsSaving(true);
+}
+
+FHttpResponseBody::~FHttpResponseBody()
+{
+	Uncount();
+
+	FileWriter.Reset();
+
+	if (!SpillFilename.IsEmpty())
+	{
+		IFileManager::Get().Delete(*SpillFilename, false, false, true);
+	}
+}
+
+void FHttpResponseBody::Serialize(void* Data, int64 Length)
+{
+	LLM_SCOPE_BYTAG(BlueprintHttp_ResponseBuffers);
+
+	FScopeLock ScopeLock(&Lock);
+
+	Size += Length;
+
+	if (Hash)
+	{
+		Hash->Update(static_cast<const uint8*>(Data), Length);
+	}
+
+	if (ForwardStream)
+	{
+		ForwardStream->Serialize(Data, Length);
+		return;
+	}
+
+	if (!FileWriter)
+	{
+		// Growing past what is already counted while the budget is exhausted goes to the disk instead.
+		const int64 Growth = Memory.Num() + Length - CountedBytes;
+
+		if (bSpillRequested || (SpillThreshold > 0 && Memory.Num() + Length > SpillThreshold)
+			|| (bCanSpill && Growth > 0 && !FHttpResponseMemory::HasRoom(Growth)))
+		{
+			Spill();
+		}
+	}
+
+	if (FileWriter)
+	{
+		FileWriter->Serialize(Data, Length);
+		return;
+	}
+
+	Memory.Append(static_cast<const uint8*>(Data), Length);
+
+	Recount();
+}
+
+void FHttpResponseBody::Spill()
+{
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("HttpResponses");
+
+	SpillFilename = FPaths::CreateTempFilename(*Directory, TEXT("Response"), TEXT(".tmp"));
+
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*SpillFilename));
+
+	if (!FileWriter)
+	{
+		UE_LOG(LogHttp, Error, TEXT("Response body: Failed to create \"%s\", the response is kept in memory."), *FPaths::ConvertRelativePathToFull(SpillFilename));
+		SpillFilename.Reset();
+		SpillThreshold	= 0;
+		bSpillRequested = false;
+		bCanSpill		= false;
+		return;
+	}
+
+	FileWriter->Serialize(Memory.GetData(), Memory.Num());
+
+	Memory.Empty();
+	Recount();
+
+	INC_DWORD_STAT(STAT_BlueprintHttp_SpilledResponses);
+}
+
+void FHttpResponseBody::Recount()
+{
+	const int64 Held = bCompleted || FileWriter || ForwardStream ? 0 : FMath::Max<int64>(ReservedBytes, Memory.Num());
+
+	FHttpResponseMemory::AddBufferedBytes(Held - CountedBytes);
+	CountedBytes = Held;
+}
+
+void FHttpResponseBody::Uncount()
+{
+	FHttpResponseMemory::AddBufferedBytes(-CountedBytes);
+	CountedBytes = 0;
+}
+
+void FHttpResponseBody::Reserve(const int64 Bytes)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	ReservedBytes = FMath::Max<int64>(Bytes, 0);
+
+	Recount();
+}
+
+void FHttpResponseBody::SetExpectedSize(const int64 ExpectedSize)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const int64 Growth = ExpectedSize - FMath::Max<int64>(CountedBytes, Memory.Num());
+
+	bSpillRequested = (SpillThreshold > 0 && ExpectedSize > SpillThreshold)
+		|| (bCanSpill && Growth > 0 && !FHttpResponseMemory::HasRoom(Growth));
+
+	// A body going to the disk doesn't need its reservation anymore.
+	ReservedBytes = bSpillRequested ? 0 : FMath::Max<int64>(ExpectedSize, 0);
+
+	Recount();
+}
+
+void FHttpResponseBody::SetForwardStream(const TSharedPtr<FArchive, ESPMode::ThreadSafe>& Stream)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	ForwardStream = Stream;
+
+	Recount();
+}
+
+void FHttpResponseBody::SetHashAlgorithm(const EHttpHashAlgorithm Algorithm)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (Algorithm == EHttpHashAlgorithm::None)
+	{
+		Hash.Reset();
+	}
+	else
+	{
+		Hash = MakeUnique<FHttpStreamingHash>(Algorithm);
+	}
+}
+
+TArray<uint8> FHttpResponseBody::GetDigest()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (Hash)
+	{
+		Digest = Hash->Finalize();
+		Hash.Reset();
+	}
+
+	return Digest;
+}
+
+void FHttpResponseBody::Complete()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	bCompleted = true;
+
+	Uncount();
+
+	if (FileWriter)
+	{
+		FileWriter->Close();
+		FileWriter.Reset();
+	}
+}
+
+int64 FHttpResponseBody::GetSize() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return Size;
+}
+
+bool FHttpResponseBody::IsSpilled() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return !SpillFilename.IsEmpty();
+}
+
+FString FHttpResponseBody::GetSpillFilename() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return SpillFilename;
+}
+
+const TArray<uint8>& FHttpResponseBody::GetContent() const
+{
+	LLM_SCOPE_BYTAG(BlueprintHttp_ResponseBuffers);
+
+	FScopeLock ScopeLock(&Lock);
+
+	if (!SpillFilename.IsEmpty() && !bLoaded && bCompleted)
+	{
+		bLoaded = true;
+
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*SpillFilename));
+
+		if (Reader)
+		{
+			Memory.SetNumUninitialized(Reader->TotalSize());
+			Reader->Serialize(Memory.GetData(), Memory.Num());
+		}
+		else
+		{
+			UE_LOG(LogHttp, Error, TEXT("Response body: Failed to read \"%s\"."), *FPaths::ConvertRelativePathToFull(SpillFilename));
+		}
+	}
+
+	return Memory;
+}
+
+bool FHttpResponseBody::MoveSpilledFileTo(const FString& Filename)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (SpillFilename.IsEmpty() || !bCompleted)
+	{
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*Filename, *SpillFilename))
+	{
+		return false;
+	}
+
+	SpillFilename.Reset();
+
+	return true;
+}
+
+void FHttpResponseBody::Discard()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Uncount();
+
+	FileWriter.Reset();
+
+	if (!SpillFilename.IsEmpty())
+	{
+		IFileManager::Get().Delete(*SpillFilename, false, false, true);
+		SpillFilename.Reset();
+	}
+
+	Memory.Empty();
+	Size	= 0;
+	bLoaded = false;
+}
+
+void FHttpResponseMemory::SetBudget(const int64 Bytes)
+{
+	GHttpResponseBudgetMB = static_cast<int32>(FMath::Max<int64>(Bytes, 0) / BytesPerMB);
+}
+
+int64 FHttpResponseMemory::GetBudget()
+{
+	return GHttpResponseBudgetMB * BytesPerMB;
+}
+
+void FHttpResponseMemory::SetSpillThreshold(const int64 Bytes)
+{
+	GHttpResponseSpillThresholdMB = static_cast<int32>(FMath::Max<int64>(Bytes, 0) / BytesPerMB);
+}
+
+int64 FHttpResponseMemory::GetSpillThreshold()
+{
+	return GHttpResponseSpillThresholdMB * BytesPerMB;
+}
+
+bool FHttpResponseMemory::IsEnabled()
+{
+	return GHttpResponseBudgetMB > 0 || GHttpResponseSpillThresholdMB > 0;
+}
+
+void FHttpResponseMemory::SetReservation(const int64 Bytes)
+{
+	GHttpResponseReservationKB = static_cast<int32>(FMath::Max<int64>(Bytes, 0) / BytesPerKB);
+}
+
+int64 FHttpResponseMemory::GetReservation()
+{
+	return GHttpResponseReservationKB * BytesPerKB;
+}
+
+bool FHttpResponseMemory::HasRoom(const int64 Bytes)
+{
+	if (GHttpResponseBudgetMB <= 0)
+	{
+		return true;
+	}
+
+	const int64 Buffered = GBufferedResponseBytes.load(std::memory_order_relaxed);
+
+	return Buffered == 0 || Buffered + Bytes <= GetBudget();
+}
+
+int64 FHttpResponseMemory::GetBufferedBytes()
+{
+	return GBufferedResponseBytes.load(std::memory_order_relaxed);
+}
+
+void FHttpResponseMemory::AddBufferedBytes(const int64 Bytes)
+{
+	if (Bytes == 0)
+	{
+		return;
+	}
+
+	const int64 Buffered = GBufferedResponseBytes.fetch_add(Bytes, std::memory_order_relaxed) + Bytes;
+
+	SET_MEMORY_STAT(STAT_BlueprintHttp_BufferedResponses, Buffered);
+}
@@ -0,0 +1,261 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpThreadTuner.h"
+#include "BlueprintHttpStats.h"
+#include "HttpModule.h"
+#include "Http.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Requests In Flight"),			  STAT_BlueprintHttp_RequestsInFlight,	 STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Throughput (KB/s)"),			  STAT_BlueprintHttp_Throughput,		 STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Thread Active Frame Time (ms)"),  STAT_BlueprintHttp_ActiveFrameTime,	 STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Thread Active Min Sleep (ms)"),   STAT_BlueprintHttp_ActiveMinSleep,	 STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Thread Idle Frame Time (ms)"),	  STAT_BlueprintHttp_IdleFrameTime,		 STATGROUP_BlueprintHttp);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Thread Idle Min Sleep (ms)"),	  STAT_BlueprintHttp_IdleMinSleep,		 STATGROUP_BlueprintHttp);
+
+namespace
+{
+	/* Seconds between two retunings. */
+	constexpr float TuningInterval = 0.25f;
+
+	/* Relative change under which the HTTP thread isn't retuned. */
+	constexpr float RetuneTolerance = 0.05f;
+
+	/* Battery percentage under which the battery is considered low. */
+	constexpr int32 LowBatteryLevel = 20;
+
+	struct FPresetTuning
+	{
+		/* Timing used when nothing is going on. */
+		FHttpThreadTiming Relaxed;
+
+		/* Timing used under load. */
+		FHttpThreadTiming Busy;
+
+		/* Load at which the busy timing is fully used. */
+		float RequestsForBusy;
+		float ThroughputForBusy;
+	};
+
+	const FPresetTuning& GetPresetTuning(const EHttpThreadTuningPreset Preset)
+	{
+		static const FPresetTuning LatencyTuning
+		{
+			{ 1.f / 120.f, 0.f,	   1.f / 30.f, 0.f  },
+			{ 1.f / 500.f, 0.f,	   1.f / 60.f, 0.f  },
+			1.f, 256.f * 1024.f
+		};
+
+		static const FPresetTuning EfficiencyTuning
+		{
+			{ 1.f / 60.f,  0.002f, 0.1f,	   0.01f },
+			{ 1.f / 200.f, 0.f,	   1.f / 30.f, 0.f   },
+			8.f, 2.f * 1024.f * 1024.f
+		};
+
+		return Preset == EHttpThreadTuningPreset::Latency ? LatencyTuning : EfficiencyTuning;
+	}
+}
+
+FHttpThreadTiming FHttpThreadTiming::Lerp(const FHttpThreadTiming& A, const FHttpThreadTiming& B, const float Alpha)
+{
+	FHttpThreadTiming Timing;
+	Timing.ActiveFrameTime	  = FMath::Lerp(A.ActiveFrameTime,	  B.ActiveFrameTime,	Alpha);
+	Timing.ActiveMinimumSleep = FMath::Lerp(A.ActiveMinimumSleep, B.ActiveMinimumSleep, Alpha);
+	Timing.IdleFrameTime	  = FMath::Lerp(A.IdleFrameTime,	  B.IdleFrameTime,		Alpha);
+	Timing.IdleMinimumSleep	  = FMath::Lerp(A.IdleMinimumSleep,	  B.IdleMinimumSleep,	Alpha);
+	return Timing;
+}
+
+bool FHttpThreadTiming::IsNearlyEqual(const FHttpThreadTiming& Other, const float Tolerance) const
+{
+	auto IsClose = [Tolerance](const float A, const float B)
+	{
+		return FMath::Abs(A - B) <= Tolerance * FMath::Max(FMath::Abs(A), FMath::Abs(B));
+	};
+
+	return IsClose(ActiveFrameTime,	   Other.ActiveFrameTime)
+		&& IsClose(ActiveMinimumSleep, Other.ActiveMinimumSleep)
+		&& IsClose(IdleFrameTime,	   Other.IdleFrameTime)
+		&& IsClose(IdleMinimumSleep,   Other.IdleMinimumSleep);
+}
+
+EHttpThreadTuningPreset		FHttpThreadTuner::Preset	 = EHttpThreadTuningPreset::Manual;
+EHttpPowerHint				FHttpThreadTuner::PowerHint	 = EHttpPowerHint::Auto;
+FTSTicker::FDelegateHandle	FHttpThreadTuner::TickerHandle;
+int32						FHttpThreadTuner::RequestsInFlight	 = 0;
+int64						FHttpThreadTuner::BytesSinceLastTick = 0;
+double						FHttpThreadTuner::LastTickTime		 = 0.;
+float						FHttpThreadTuner::Throughput		 = 0.f;
+TOptional<FHttpThreadTiming> FHttpThreadTuner::AppliedTiming;
+
+void FHttpThreadTuner::SetPreset(const EHttpThreadTuningPreset InPreset)
+{
+	if (Preset == InPreset)
+	{
+		return;
+	}
+
+	Preset = InPreset;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	AppliedTiming.Reset();
+
+	if (Preset != EHttpThreadTuningPreset::Manual)
+	{
+		BytesSinceLastTick = 0;
+		LastTickTime	   = FPlatformTime::Seconds();
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FHttpThreadTuner::Tick), TuningInterval);
+
+		// Tunes right away instead of waiting for the first interval.
+		Tick(0.f);
+	}
+}
+
+EHttpThreadTuningPreset FHttpThreadTuner::GetPreset()
+{
+	return Preset;
+}
+
+void FHttpThreadTuner::SetPowerHint(const EHttpPowerHint Hint)
+{
+	PowerHint = Hint;
+}
+
+EHttpPowerHint FHttpThreadTuner::GetPowerHint()
+{
+	return PowerHint;
+}
+
+void FHttpThreadTuner::NotifyRequestStarted()
+{
+	++RequestsInFlight;
+	SET_DWORD_STAT(STAT_BlueprintHttp_RequestsInFlight, RequestsInFlight);
+}
+
+void FHttpThreadTuner::NotifyRequestFinished()
+{
+	RequestsInFlight = FMath::Max(RequestsInFlight - 1, 0);
+	SET_DWORD_STAT(STAT_BlueprintHttp_RequestsInFlight, RequestsInFlight);
+}
+
+void FHttpThreadTuner::NotifyBytesReceived(const int64 Bytes)
+{
+	BytesSinceLastTick += Bytes;
+}
+
+int32 FHttpThreadTuner::GetRequestsInFlight()
+{
+	return RequestsInFlight;
+}
+
+float FHttpThreadTuner::GetThroughput()
+{
+	return Throughput;
+}
+
+EHttpPowerHint FHttpThreadTuner::ResolvePowerHint()
+{
+	if (PowerHint != EHttpPowerHint::Auto)
+	{
+		return PowerHint;
+	}
+
+	if (!FPlatformMisc::IsRunningOnBattery())
+	{
+		return EHttpPowerHint::Plugged;
+	}
+
+	const int32 BatteryLevel = FPlatformMisc::GetBatteryLevel();
+
+	return BatteryLevel >= 0 && BatteryLevel < LowBatteryLevel ? EHttpPowerHint::LowBattery : EHttpPowerHint::OnBattery;
+}
+
+bool FHttpThreadTuner::Tick(float DeltaTime)
+{
+	// The ticker passes the delta time of the frame, not the time since the last interval.
+	const double Now	 = FPlatformTime::Seconds();
+	const double Elapsed = Now - LastTickTime;
+
+	if (DeltaTime > 0.f && Elapsed > 0.)
+	{
+		// Smoothed so a single large chunk doesn't flip the timing back and forth.
+		Throughput = FMath::Lerp(Throughput, static_cast<float>(BytesSinceLastTick / Elapsed), 0.3f);
+		BytesSinceLastTick = 0;
+		LastTickTime	   = Now;
+	}
+
+	SET_FLOAT_STAT(STAT_BlueprintHttp_Throughput, Throughput / 1024.f);
+
+	const FPresetTuning& Tuning = GetPresetTuning(Preset);
+
+	float Load = FMath::Max(RequestsInFlight / Tuning.RequestsForBusy, Throughput / Tuning.ThroughputForBusy);
+
+	switch (ResolvePowerHint())
+	{
+	case EHttpPowerHint::OnBattery:  Load = FMath::Min(Load, 0.5f); break;
+	case EHttpPowerHint::LowBattery: Load = 0.f;					 break;
+	default: break;
+	}
+
+	Apply(FHttpThreadTiming::Lerp(Tuning.Relaxed, Tuning.Busy, FMath::Clamp(Load, 0.f, 1.f)));
+
+	return true;
+}
+
+void FHttpThreadTuner::Apply(const FHttpThreadTiming& Timing)
+{
+	if (AppliedTiming.IsSet() && AppliedTiming->IsNearlyEqual(Timing, RetuneTolerance))
+	{
+		return;
+	}
+
+	AppliedTiming = Timing;
+
+	FHttpModule& Module = FHttpModule::Get();
+	Module.SetHttpThreadActiveFrameTimeInSeconds	   (Timing.ActiveFrameTime);
+	Module.SetHttpThreadActiveMinimumSleepTimeInSeconds(Timing.ActiveMinimumSleep);
+	Module.SetHttpThreadIdleFrameTimeInSeconds		   (Timing.IdleFrameTime);
+	Module.SetHttpThreadIdleMinimumSleepTimeInSeconds  (Timing.IdleMinimumSleep);
+
+	SET_FLOAT_STAT(STAT_BlueprintHttp_ActiveFrameTime, Timing.ActiveFrameTime	 * 1000.f);
+	SET_FLOAT_STAT(STAT_BlueprintHttp_ActiveMinSleep,  Timing.ActiveMinimumSleep * 1000.f);
+	SET_FLOAT_STAT(STAT_BlueprintHttp_IdleFrameTime,   Timing.IdleFrameTime		 * 1000.f);
+	SET_FLOAT_STAT(STAT_BlueprintHttp_IdleMinSleep,	   Timing.IdleMinimumSleep	 * 1000.f);
+
+	UE_LOG(LogHttp, Verbose, TEXT("ThreadTuner: Active %.2fms (sleep %.2fms), idle %.2fms (sleep %.2fms) for %d requests at %.0fKB/s."),
+		Timing.ActiveFrameTime * 1000.f, Timing.ActiveMinimumSleep * 1000.f, Timing.IdleFrameTime * 1000.f, Timing.IdleMinimumSleep * 1000.f,
+		RequestsInFlight, Throughput / 1024.f);
+}
+
+static FAutoConsoleCommand GHttpThreadTuningCommand(
+	TEXT("http.ThreadTuning"),
+	TEXT("Sets how the HTTP thread is tuned. Args: <Manual|Latency|Efficiency> [Plugged|OnBattery|LowBattery|Auto]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	const UEnum* const PresetEnum = StaticEnum<EHttpThreadTuningPreset>();
+	const UEnum* const HintEnum	  = StaticEnum<EHttpPowerHint>();
+
+	const int64 NewPreset = Args.Num() > 0 ? PresetEnum->GetValueByNameString(Args[0]) : INDEX_NONE;
+	const int64 NewHint	  = Args.Num() > 1 ? HintEnum  ->GetValueByNameString(Args[1]) : INDEX_NONE;
+
+	if (NewHint != INDEX_NONE)
+	{
+		FHttpThreadTuner::SetPowerHint(static_cast<EHttpPowerHint>(NewHint));
+	}
+
+	if (NewPreset != INDEX_NONE)
+	{
+		FHttpThreadTuner::SetPreset(static_cast<EHttpThreadTuningPreset>(NewPreset));
+	}
+
+	UE_LOG(LogHttp, Display, TEXT("ThreadTuner: Preset %s, power hint %s, %d requests in flight at %.0fKB/s."),
+		*PresetEnum->GetNameStringByValue(static_cast<int64>(FHttpThreadTuner::GetPreset())),
+		*HintEnum  ->GetNameStringByValue(static_cast<int64>(FHttpThreadTuner::GetPowerHint())),
+		FHttpThreadTuner::GetRequestsInFlight(), FHttpThreadTuner::GetThroughput() / 1024.f);
+})
+);
@@ -0,0 +1,133 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpTransport.h"
+#include "HttpRecordReplayTransport.h"
+#include "HttpNetworkSimulator.h"
+#include "HttpRequest.h"
+#include "Http.h"
+#include "Interfaces/IHttpRequest.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+/**
+ *  Sends requests through the engine's HTTP module.
+ **/
+class FHttpNetworkTransport final : public IHttpTransport
+{
+public:
+	virtual bool ProcessRequest(UHttpRequest* const Request) override
+	{
+		return Request->GetNativeRequest()->ProcessRequest();
+	}
+
+	virtual void CancelRequest(UHttpRequest* const Request) override
+	{
+		Request->GetNativeRequest()->CancelRequest();
+	}
+
+	virtual EHttpTransportMode GetMode() const override
+	{
+		return EHttpTransportMode::Network;
+	}
+};
+
+TSharedPtr<IHttpTransport> FHttpTransports::Transport;
+
+TSharedRef<IHttpTransport> FHttpTransports::Get()
+{
+	const TSharedRef<IHttpTransport> Current = Transport ? Transport.ToSharedRef() : GetNetwork();
+
+	return FHttpNetworkSimulator::IsEnabled() ? FHttpNetworkSimulator::Wrap(Current) : Current;
+}
+
+EHttpTransportMode FHttpTransports::GetMode()
+{
+	// The simulator keeps the mode of the transport it wraps.
+	return Transport ? Transport->GetMode() : EHttpTransportMode::Network;
+}
+
+void FHttpTransports::Set(TSharedPtr<IHttpTransport> InTransport)
+{
+	Transport = MoveTemp(InTransport);
+}
+
+TSharedRef<IHttpTransport> FHttpTransports::GetNetwork()
+{
+	static const TSharedRef<IHttpTransport> Network = MakeShared<FHttpNetworkTransport>();
+	return Network;
+}
+
+bool FHttpTransports::SetMode(const EHttpTransportMode Mode, const FString& ArchivePath, const bool bReplayOriginalTiming)
+{
+	if (Mode == EHttpTransportMode::Network)
+	{
+		Set(nullptr);
+		return true;
+	}
+
+	if (ArchivePath.IsEmpty())
+	{
+		UE_LOG(LogHttp, Error, TEXT("Transport: An archive path is required to record or replay requests."));
+		return false;
+	}
+
+	const TSharedRef<FHttpRecordReplayTransport> NewTransport = MakeShared<FHttpRecordReplayTransport>(Mode, ArchivePath, bReplayOriginalTiming);
+
+	if (!NewTransport->Initialize())
+	{
+		return false;
+	}
+
+	Set(NewTransport);
+
+	return true;
+}
+
+bool FHttpTransports::FlushRecording()
+{
+	if (!Transport || Transport->GetMode() != EHttpTransportMode::Record)
+	{
+		return false;
+	}
+
+	return StaticCastSharedPtr<FHttpRecordReplayTransport>(Transport)->Save();
+}
+
+void FHttpTransports::InitFromCommandLine()
+{
+	FString ArchivePath;
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("HttpReplay="), ArchivePath))
+	{
+		SetMode(EHttpTransportMode::Replay, ArchivePath, FParse::Param(FCommandLine::Get(), TEXT("HttpReplayTiming")));
+	}
+	else if (FParse::Value(FCommandLine::Get(), TEXT("HttpRecord="), ArchivePath))
+	{
+		SetMode(EHttpTransportMode::Record, ArchivePath, false);
+	}
+}
+
+void FHttpTransports::Shutdown()
+{
+	// Recording transports save when destroyed.
+	Set(nullptr);
+}
+
+static FAutoConsoleCommand GHttpTransportCommand(
+	TEXT("http.Transport"),
+	TEXT("Sets the transport of BlueprintHttp requests. Args: <Network|Record|Replay> [ArchivePath] [Timing]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+	const UEnum* const ModeEnum = StaticEnum<EHttpTransportMode>();
+	const int64 Mode = Args.Num() > 0 ? ModeEnum->GetValueByNameString(Args[0]) : INDEX_NONE;
+
+	if (Mode == INDEX_NONE)
+	{
+		UE_LOG(LogHttp, Display, TEXT("Transport: Current mode is %s."), *ModeEnum->GetNameStringByValue(static_cast<int64>(FHttpTransports::GetMode())));
+		return;
+	}
+
+	FHttpTransports::SetMode(static_cast<EHttpTransportMode>(Mode), Args.Num() > 1 ? Args[1] : FString(), Args.Contains(TEXT("Timing")));
+})
+);
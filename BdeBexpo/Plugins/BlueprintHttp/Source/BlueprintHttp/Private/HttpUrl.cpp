@@ -0,0 +1,346 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpUrl.h"
+#include "HttpUrlCodec.h"
+
+namespace
+{
+	/* Calls Visitor with each part of Text between Separator, empty parts included. */
+	template<typename VisitorType>
+	void SplitView(FStringView Text, const TCHAR Separator, VisitorType&& Visitor)
+	{
+		for (;;)
+		{
+			int32 Index = INDEX_NONE;
+			if (!Text.FindChar(Separator, Index))
+			{
+				Visitor(Text);
+				return;
+			}
+
+			Visitor(Text.Left(Index));
+			Text.RightChopInline(Index + 1);
+		}
+	}
+
+	void AppendHost(FString& Out, const FHttpUrl& Url)
+	{
+		// IPv6 addresses are written in brackets.
+		int32 Colon = INDEX_NONE;
+		if (Url.Host.FindChar(TEXT(':'), Colon))
+		{
+			Out += TEXT("[") + Url.Host + TEXT("]");
+		}
+		else
+		{
+			Out += Url.Host;
+		}
+
+		if (Url.Port != 0)
+		{
+			Out += TEXT(":");
+			Out.AppendInt(Url.Port);
+		}
+	}
+}
+
+bool FHttpUrl::Parse(FStringView Url, FHttpUrl& OutUrl)
+{
+	OutUrl = FHttpUrl();
+
+	const int32 SchemeEnd = Url.Find(TEXT("://"), 0, ESearchCase::CaseSensitive);
+	if (SchemeEnd <= 0)
+	{
+		return false;
+	}
+
+	OutUrl.Scheme = FString(Url.Left(SchemeEnd)).ToLower();
+
+	FStringView Rest = Url.Mid(SchemeEnd + 3);
+
+	int32 Index = INDEX_NONE;
+	if (Rest.FindChar(TEXT('#'), Index))
+	{
+		OutUrl.Fragment = BlueprintHttp::UrlDecode(Rest.Mid(Index + 1));
+		Rest.LeftInline(Index);
+	}
+
+	FStringView QueryString;
+	if (Rest.FindChar(TEXT('?'), Index))
+	{
+		QueryString = Rest.Mid(Index + 1);
+		Rest.LeftInline(Index);
+	}
+
+	FStringView Authority = Rest;
+	FStringView Path;
+
+	const bool bHasPath = Rest.FindChar(TEXT('/'), Index);
+	if (bHasPath)
+	{
+		Authority = Rest.Left(Index);
+		Path	  = Rest.Mid(Index + 1);
+	}
+
+	// User info isn't kept.
+	if (Authority.FindLastChar(TEXT('@'), Index))
+	{
+		Authority.RightChopInline(Index + 1);
+	}
+
+	FStringView Host = Authority;
+	FStringView Port;
+
+	if (Authority.Len() > 0 && Authority[0] == TEXT('['))
+	{
+		if (!Authority.FindChar(TEXT(']'), Index))
+		{
+			return false;
+		}
+
+		Host = Authority.Mid(1, Index - 1);
+
+		if (Index + 1 < Authority.Len())
+		{
+			if (Authority[Index + 1] != TEXT(':'))
+			{
+				return false;
+			}
+
+			Port = Authority.Mid(Index + 2);
+		}
+	}
+	else if (Authority.FindLastChar(TEXT(':'), Index))
+	{
+		Host = Authority.Left(Index);
+		Port = Authority.Mid(Index + 1);
+	}
+
+	if (Host.IsEmpty())
+	{
+		return false;
+	}
+
+	OutUrl.Host = FString(Host);
+
+	for (const TCHAR Digit : Port)
+	{
+		if (!FChar::IsDigit(Digit) || OutUrl.Port > 65535)
+		{
+			return false;
+		}
+
+		OutUrl.Port = OutUrl.Port * 10 + (Digit - TEXT('0'));
+	}
+
+	if (OutUrl.Port > 65535)
+	{
+		return false;
+	}
+
+	// A trailing slash gives an empty last segment so the path is written back the same.
+	if (bHasPath)
+	{
+		SplitView(Path, TEXT('/'), [&OutUrl](const FStringView Segment)
+		{
+			OutUrl.PathSegments.Add(BlueprintHttp::UrlDecode(Segment));
+		});
+	}
+
+	if (!QueryString.IsEmpty())
+	{
+		SplitView(QueryString, TEXT('&'), [&OutUrl](const FStringView Parameter)
+		{
+			if (Parameter.IsEmpty())
+			{
+				return;
+			}
+
+			int32 Equals = INDEX_NONE;
+			const bool bHasValue = Parameter.FindChar(TEXT('='), Equals);
+
+			FString Name = BlueprintHttp::UrlDecode(bHasValue ? Parameter.Left(Equals) : Parameter);
+			if (!OutUrl.Query.Contains(Name))
+			{
+				OutUrl.Query.Emplace(MoveTemp(Name), bHasValue ? BlueprintHttp::UrlDecode(Parameter.Mid(Equals + 1)) : FString());
+			}
+		});
+	}
+
+	return true;
+}
+
+int32 FHttpUrl::GetEffectivePort() const
+{
+	if (Port != 0)
+	{
+		return Port;
+	}
+
+	if (Scheme == TEXT("https") || Scheme == TEXT("wss"))
+	{
+		return 443;
+	}
+
+	if (Scheme == TEXT("http") || Scheme == TEXT("ws"))
+	{
+		return 80;
+	}
+
+	return 0;
+}
+
+FString FHttpUrl::GetPath() const
+{
+	if (PathSegments.IsEmpty())
+	{
+		return TEXT("/");
+	}
+
+	FString Path;
+	for (const FString& Segment : PathSegments)
+	{
+		Path += TEXT("/");
+		BlueprintHttp::AppendUrlEncoded(Path, Segment);
+	}
+
+	return Path;
+}
+
+FString FHttpUrl::ToString() const
+{
+	FString Base;
+	Base.Reserve(Scheme.Len() + Host.Len() + 16);
+
+	Base += Scheme;
+	Base += TEXT("://");
+	AppendHost(Base, *this);
+
+	FHttpUrlBuilder Builder(Base);
+
+	for (const FString& Segment : PathSegments)
+	{
+		Builder.AddPathSegment(Segment);
+	}
+
+	Builder.AddQueryParameters(Query);
+
+	FString Url = Builder.Build();
+
+	if (!Fragment.IsEmpty())
+	{
+		Url += TEXT("#");
+		BlueprintHttp::AppendUrlEncoded(Url, Fragment);
+	}
+
+	return Url;
+}
+
+FHttpUrlBuilder::FHttpUrlBuilder(FStringView BaseUrl, const int32 ExtraCapacity)
+{
+	Reset(BaseUrl, ExtraCapacity);
+}
+
+FHttpUrlBuilder& FHttpUrlBuilder::Reset(FStringView BaseUrl, const int32 ExtraCapacity)
+{
+	int32 Index = INDEX_NONE;
+	if (BaseUrl.FindChar(TEXT('#'), Index))
+	{
+		BaseUrl.LeftInline(Index);
+	}
+
+	Base = FString(BaseUrl);
+	BaseQueryStart = BaseUrl.FindChar(TEXT('?'), Index) ? Index : INDEX_NONE;
+
+	Buffer.Reset(Base.Len() + ExtraCapacity);
+
+	return Rewind();
+}
+
+FHttpUrlBuilder& FHttpUrlBuilder::Rewind()
+{
+	// Copied back rather than truncated, path segments can be inserted in the base's query.
+	Buffer.Reset();
+	Buffer += Base;
+
+	QueryStart = BaseQueryStart;
+
+	return *this;
+}
+
+FHttpUrlBuilder& FHttpUrlBuilder::AddPathSegment(FStringView Segment)
+{
+	if (QueryStart == INDEX_NONE)
+	{
+		if (!Buffer.EndsWith(TEXT("/"), ESearchCase::CaseSensitive))
+		{
+			Buffer += TEXT("/");
+		}
+
+		BlueprintHttp::AppendUrlEncoded(Buffer, Segment);
+		return *this;
+	}
+
+	FString Encoded;
+	if (QueryStart == 0 || Buffer[QueryStart - 1] != TEXT('/'))
+	{
+		Encoded += TEXT("/");
+	}
+
+	BlueprintHttp::AppendUrlEncoded(Encoded, Segment);
+
+	Buffer.InsertAt(QueryStart, Encoded);
+	QueryStart += Encoded.Len();
+
+	return *this;
+}
+
+FHttpUrlBuilder& FHttpUrlBuilder::AddPath(FStringView Path)
+{
+	SplitView(Path, TEXT('/'), [this](const FStringView Segment)
+	{
+		if (!Segment.IsEmpty())
+		{
+			AddPathSegment(Segment);
+		}
+	});
+
+	return *this;
+}
+
+FHttpUrlBuilder& FHttpUrlBuilder::AddQueryParameter(FStringView Name, FStringView Value)
+{
+	if (QueryStart == INDEX_NONE)
+	{
+		QueryStart = Buffer.Len();
+		Buffer += TEXT("?");
+	}
+	else if (!Buffer.EndsWith(TEXT("?"), ESearchCase::CaseSensitive) && !Buffer.EndsWith(TEXT("&"), ESearchCase::CaseSensitive))
+	{
+		Buffer += TEXT("&");
+	}
+
+	BlueprintHttp::AppendUrlEncoded(Buffer, Name);
+	Buffer += TEXT("=");
+	BlueprintHttp::AppendUrlEncoded(Buffer, Value);
+
+	return *this;
+}
+
+FHttpUrlBuilder& FHttpUrlBuilder::AddQueryParameters(const TMap<FString, FString>& Parameters)
+{
+	int32 Length = 0;
+	for (const auto& Pair : Parameters)
+	{
+		Length += Pair.Key.Len() + Pair.Value.Len() + 2;
+	}
+
+	Buffer.Reserve(Buffer.Len() + Length);
+
+	for (const auto& Pair : Parameters)
+	{
+		AddQueryParameter(Pair.Key, Pair.Value);
+	}
+
+	return *this;
+}
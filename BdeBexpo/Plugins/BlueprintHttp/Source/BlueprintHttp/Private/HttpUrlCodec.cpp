@@ -0,0 +1,333 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpUrlCodec.h"
+#include "HttpVectorIntrinsics.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Containers/StringConv.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	/* Set of bytes. ASCII bytes are tested 16 at a time. */
+	class FByteClass
+	{
+	public:
+		FByteClass()
+		{
+			FMemory::Memzero(Members);
+			FMemory::Memzero(Rows);
+		}
+
+		void Add(const uint8 Byte)
+		{
+			Members[Byte] = true;
+
+			if (Byte < 0x80)
+			{
+				Rows[Byte & 0x0F] |= 1 << (Byte >> 4);
+			}
+		}
+
+		/* Returns the index of the first byte from Index that isn't in the set, or Length. */
+		int32 Skip(const uint8* const Data, int32 Index, const int32 Length) const
+		{
+			while (Index < Length)
+			{
+				Index = SkipBlocks(Data, Index, Length);
+
+				if (Index == Length || !Members[Data[Index]])
+				{
+					break;
+				}
+
+				++Index;
+			}
+
+			return Index;
+		}
+
+	private:
+		/* Skips the blocks of 16 bytes in the set. Stops at the first byte it can't vouch for, bytes above 127 included. */
+		int32 SkipBlocks(const uint8* const Data, int32 Index, const int32 Length) const
+		{
+#if BLUEPRINTHTTP_SSSE3
+			const __m128i Lut		= _mm_loadu_si128(reinterpret_cast<const __m128i*>(Rows));
+			const __m128i HighBits	= _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+			const __m128i Nibble	= _mm_set1_epi8(0x0F);
+
+			for (; Index + 16 <= Length; Index += 16)
+			{
+				const __m128i Input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Index));
+
+				// The low nibble selects the high nibbles in the set, the high nibble its bit.
+				const __m128i Row = _mm_shuffle_epi8(Lut,	   _mm_and_si128(Input, Nibble));
+				const __m128i Bit = _mm_shuffle_epi8(HighBits, _mm_and_si128(_mm_srli_epi16(Input, 4), Nibble));
+
+				const uint32 Rejected = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Row, Bit), _mm_setzero_si128()));
+				if (Rejected != 0)
+				{
+					return Index + FMath::CountTrailingZeros(Rejected);
+				}
+			}
+#elif BLUEPRINTHTTP_NEON
+			static const uint8 HighBitValues[16] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+
+			const uint8x16_t Lut	  = vld1q_u8(Rows);
+			const uint8x16_t HighBits = vld1q_u8(HighBitValues);
+
+			for (; Index + 16 <= Length; Index += 16)
+			{
+				const uint8x16_t Input = vld1q_u8(Data + Index);
+
+				const uint8x16_t Row = vqtbl1q_u8(Lut,		vandq_u8(Input, vdupq_n_u8(0x0F)));
+				const uint8x16_t Bit = vqtbl1q_u8(HighBits, vshrq_n_u8(Input, 4));
+
+				// Narrows the comparison to one nibble per byte.
+				const uint8x16_t Rejected = vceqq_u8(vandq_u8(Row, Bit), vdupq_n_u8(0));
+				const uint64 Mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Rejected), 4)), 0);
+
+				if (Mask != 0)
+				{
+					return Index + FMath::CountTrailingZeros64(Mask) / 4;
+				}
+			}
+#endif
+			return Index;
+		}
+
+		bool  Members[256];
+
+		// For each low nibble, the bits of the high nibbles 0 to 7 in the set.
+		uint8 Rows[16];
+	};
+
+	/**
+	 * What FPlatformHttp does with each byte, read from it once.
+	 * If it doesn't behave as expected the fast paths are disabled and it's called instead.
+	 **/
+	struct FUrlTables
+	{
+		FUrlTables();
+
+		/* Kept as-is by UrlEncode(). */
+		FByteClass Unreserved;
+
+		/* Copied as-is by UrlDecode(). */
+		FByteClass Literal;
+
+		/* Accepted by IsURLEncoded(). */
+		FByteClass Payload;
+
+		TCHAR Escapes[256][3];
+
+		bool bEmptyPayloadEncoded;
+		bool bEncodeSupported;
+		bool bDecodeSupported;
+	};
+
+	FUrlTables::FUrlTables()
+		: bEmptyPayloadEncoded(FPlatformHttp::IsURLEncoded(TArray<uint8>()))
+		, bEncodeSupported(true)
+		, bDecodeSupported(true)
+	{
+		bool bLowerCaseHex = false;
+
+		for (int32 Byte = 1; Byte < 0x80; ++Byte)
+		{
+			const FString Char	  = FString::Chr(static_cast<TCHAR>(Byte));
+			const FString Encoded = FPlatformHttp::UrlEncode(Char);
+
+			if (Encoded.Equals(Char, ESearchCase::CaseSensitive))
+			{
+				Unreserved.Add(Byte);
+			}
+			else if (Encoded.Len() == 3 && Encoded[0] == TEXT('%') && FChar::IsHexDigit(Encoded[1]) && FChar::IsHexDigit(Encoded[2])
+				&& FParse::HexDigit(Encoded[1]) * 16 + FParse::HexDigit(Encoded[2]) == Byte)
+			{
+				FMemory::Memcpy(Escapes[Byte], *Encoded, sizeof(Escapes[Byte]));
+				bLowerCaseHex |= FChar::IsLower(Encoded[1]) || FChar::IsLower(Encoded[2]);
+			}
+			else
+			{
+				bEncodeSupported = false;
+			}
+
+			if (Byte != '%' && FPlatformHttp::UrlDecode(Char).Equals(Char, ESearchCase::CaseSensitive))
+			{
+				Literal.Add(Byte);
+			}
+		}
+
+		const TCHAR* const HexDigits = bLowerCaseHex ? TEXT("0123456789abcdef") : TEXT("0123456789ABCDEF");
+
+		for (int32 Byte = 0x80; Byte < 0x100; ++Byte)
+		{
+			Escapes[Byte][0] = TEXT('%');
+			Escapes[Byte][1] = HexDigits[Byte >> 4];
+			Escapes[Byte][2] = HexDigits[Byte & 0x0F];
+		}
+
+		// Non-ASCII characters are escaped byte by byte in UTF-8.
+		const FString NonAscii = TEXT("\u00e9");
+		bEncodeSupported &= FPlatformHttp::UrlEncode(NonAscii).Equals(bLowerCaseHex ? TEXT("%c3%a9") : TEXT("%C3%A9"), ESearchCase::CaseSensitive);
+
+		bDecodeSupported = FPlatformHttp::UrlDecode(TEXT("%41%c3%A9")).Equals(TEXT("A\u00e9"), ESearchCase::CaseSensitive);
+
+		if (FPlatformHttp::UrlDecode(NonAscii).Equals(NonAscii, ESearchCase::CaseSensitive))
+		{
+			for (int32 Byte = 0x80; Byte < 0x100; ++Byte)
+			{
+				Literal.Add(Byte);
+			}
+		}
+
+		for (int32 Byte = 0; Byte < 0x100; ++Byte)
+		{
+			if (FPlatformHttp::IsURLEncoded(TArray<uint8>({ static_cast<uint8>(Byte) })))
+			{
+				Payload.Add(Byte);
+			}
+		}
+	}
+
+	const FUrlTables& GetTables()
+	{
+		static const FUrlTables Tables;
+		return Tables;
+	}
+
+	void AppendEncodedBytes(FString& Out, const uint8* const Data, const int32 Length, const FUrlTables& Tables)
+	{
+		// Sizes the output first so it's allocated once.
+		int32 EncodedLength = 0;
+
+		for (int32 Index = 0; Index < Length;)
+		{
+			const int32 RunEnd = Tables.Unreserved.Skip(Data, Index, Length);
+
+			EncodedLength += RunEnd - Index;
+			EncodedLength += RunEnd < Length && Data[RunEnd] != 0 ? 3 : 0;
+
+			Index = RunEnd + 1;
+		}
+
+		if (EncodedLength == 0)
+		{
+			return;
+		}
+
+		TArray<TCHAR>& Chars = Out.GetCharArray();
+
+		const int32 Start = Out.Len();
+		Chars.SetNumUninitialized(Start + EncodedLength + 1, EAllowShrinking::No);
+
+		TCHAR* Dest = Chars.GetData() + Start;
+
+		for (int32 Index = 0; Index < Length;)
+		{
+			const int32 RunEnd = Tables.Unreserved.Skip(Data, Index, Length);
+
+			for (; Index < RunEnd; ++Index)
+			{
+				*Dest++ = static_cast<TCHAR>(Data[Index]);
+			}
+
+			// Null bytes are dropped, as FPlatformHttp does.
+			if (RunEnd < Length && Data[RunEnd] != 0)
+			{
+				FMemory::Memcpy(Dest, Tables.Escapes[Data[RunEnd]], sizeof(Tables.Escapes[0]));
+				Dest += 3;
+			}
+
+			Index = RunEnd + 1;
+		}
+
+		*Dest = TEXT('\0');
+	}
+}
+
+FString BlueprintHttp::UrlEncode(FStringView Text)
+{
+	FString Encoded;
+	AppendUrlEncoded(Encoded, Text);
+	return Encoded;
+}
+
+void BlueprintHttp::AppendUrlEncoded(FString& Out, FStringView Text)
+{
+	const FUrlTables& Tables = GetTables();
+
+	if (!Tables.bEncodeSupported)
+	{
+		Out += FPlatformHttp::UrlEncode(FString(Text));
+		return;
+	}
+
+	const FTCHARToUTF8 Utf8(Text.GetData(), Text.Len());
+	AppendEncodedBytes(Out, reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), Tables);
+}
+
+FString BlueprintHttp::UrlDecode(FStringView Text)
+{
+	const FUrlTables& Tables = GetTables();
+
+	if (!Tables.bDecodeSupported)
+	{
+		return FPlatformHttp::UrlDecode(FString(Text));
+	}
+
+	const FTCHARToUTF8 Utf8(Text.GetData(), Text.Len());
+
+	const uint8* const Data	  = reinterpret_cast<const uint8*>(Utf8.Get());
+	const int32		   Length = Utf8.Length();
+
+	TArray<UTF8CHAR> Decoded;
+	Decoded.SetNumUninitialized(Length + 1);
+
+	UTF8CHAR* Dest = Decoded.GetData();
+
+	for (int32 Index = 0; Index < Length;)
+	{
+		const int32 RunEnd = Tables.Literal.Skip(Data, Index, Length);
+
+		FMemory::Memcpy(Dest, Data + Index, RunEnd - Index);
+		Dest += RunEnd - Index;
+		Index = RunEnd;
+
+		if (Index == Length)
+		{
+			break;
+		}
+
+		// Only well-formed escapes of non-null bytes are decoded here, FPlatformHttp handles the rest.
+		if (Data[Index] != '%' || Index + 3 > Length || !FCharAnsi::IsHexDigit(Data[Index + 1]) || !FCharAnsi::IsHexDigit(Data[Index + 2]))
+		{
+			return FPlatformHttp::UrlDecode(FString(Text));
+		}
+
+		const uint8 Byte = static_cast<uint8>(FParse::HexDigit(Data[Index + 1]) * 16 + FParse::HexDigit(Data[Index + 2]));
+		if (Byte == 0)
+		{
+			return FPlatformHttp::UrlDecode(FString(Text));
+		}
+
+		*Dest++ = static_cast<UTF8CHAR>(Byte);
+		Index += 3;
+	}
+
+	*Dest = UTF8CHAR('\0');
+
+	return FString(UTF8_TO_TCHAR(Decoded.GetData()));
+}
+
+bool BlueprintHttp::IsUrlEncoded(TArrayView<const uint8> Payload)
+{
+	const FUrlTables& Tables = GetTables();
+
+	if (Payload.Num() == 0)
+	{
+		return Tables.bEmptyPayloadEncoded;
+	}
+
+	return Tables.Payload.Skip(Payload.GetData(), 0, Payload.Num()) == Payload.Num();
+}
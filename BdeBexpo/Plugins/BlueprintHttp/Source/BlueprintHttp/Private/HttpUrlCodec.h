@@ -0,0 +1,26 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace BlueprintHttp
+{
+	/**
+	 * Percent-encoding with the same output as FPlatformHttp, without going through it one character
+	 * at a time. Runs of characters that don't need escaping are found 16 bytes at a time and copied
+	 * at once. The characters FPlatformHttp keeps are read from it the first time, so both always agree.
+	 **/
+
+	/* Same as FPlatformHttp::UrlEncode(). */
+	FString UrlEncode(FStringView Text);
+
+	/* Appends the encoded text to Out, growing it once. */
+	void AppendUrlEncoded(FString& Out, FStringView Text);
+
+	/* Same as FPlatformHttp::UrlDecode(). */
+	FString UrlDecode(FStringView Text);
+
+	/* Same as FPlatformHttp::IsURLEncoded(). */
+	bool IsUrlEncoded(TArrayView<const uint8> Payload);
+}
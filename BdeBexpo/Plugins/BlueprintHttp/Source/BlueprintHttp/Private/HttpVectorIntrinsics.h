@@ -0,0 +1,25 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Vector instruction sets the text kernels of the plugin can rely on without checking the CPU:
+ * SSSE3 on x64 targets that require SSE4.1, NEON on ARM64.
+ **/
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY && PLATFORM_ALWAYS_HAS_SSE4_1
+	#define BLUEPRINTHTTP_SSSE3 1
+	#include <tmmintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+	#define BLUEPRINTHTTP_NEON 1
+	#include <arm_neon.h>
+#endif
+
+#ifndef BLUEPRINTHTTP_SSSE3
+	#define BLUEPRINTHTTP_SSSE3 0
+#endif
+
+#ifndef BLUEPRINTHTTP_NEON
+	#define BLUEPRINTHTTP_NEON 0
+#endif
@@ -0,0 +1,549 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpWebSocket.h"
+#include "HttpClientProfile.h"
+#include "BlueprintHttpStats.h"
+#include "Http.h"
+#include "IWebSocket.h"
+#include "WebSocketsModule.h"
+#include "Misc/Compression.h"
+#include "Containers/StringConv.h"
+#include "Modules/ModuleManager.h"
+#include "CoreGlobals.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("WebSockets Open"),			STAT_BlueprintHttp_WebSocketsOpen,	  STATGROUP_BlueprintHttp);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("WebSocket Queued Bytes"),	STAT_BlueprintHttp_WebSocketQueued,	  STATGROUP_BlueprintHttp);
+DECLARE_DWORD_COUNTER_STAT	  (TEXT("WebSocket Messages Sent"),	STAT_BlueprintHttp_WebSocketSent,	  STATGROUP_BlueprintHttp);
+DECLARE_DWORD_COUNTER_STAT	  (TEXT("WebSocket Messages Received"), STAT_BlueprintHttp_WebSocketReceived, STATGROUP_BlueprintHttp);
+
+namespace
+{
+	// "BHZ", the type of the original message and its size.
+	constexpr int32 CompressedHeaderSize = 8;
+
+	// Deflate can't shrink data more than this, larger sizes announced by the header are forged.
+	constexpr int64 MaxCompressionRatio = 1032;
+
+	bool IsCompressedMessage(const uint8* const Data, const int64 Length)
+	{
+		return Length >= CompressedHeaderSize && Data[0] == 'B' && Data[1] == 'H' && Data[2] == 'Z' && (Data[3] == 'T' || Data[3] == 'B');
+	}
+
+	bool CompressMessage(const TArray<uint8>& Data, const bool bBinary, TArray<uint8>& OutCompressed)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Data.Num());
+
+		OutCompressed.SetNumUninitialized(CompressedHeaderSize + CompressedSize);
+
+		if (!FCompression::CompressMemory(NAME_Zlib, OutCompressed.GetData() + CompressedHeaderSize, CompressedSize, Data.GetData(), Data.Num()))
+		{
+			return false;
+		}
+
+		// Not worth it for data that doesn't compress.
+		if (CompressedHeaderSize + CompressedSize >= Data.Num())
+		{
+			return false;
+		}
+
+		const uint32 Size = Data.Num();
+
+		OutCompressed[0] = 'B';
+		OutCompressed[1] = 'H';
+		OutCompressed[2] = 'Z';
+		OutCompressed[3] = bBinary ? 'B' : 'T';
+		OutCompressed[4] = static_cast<uint8>(Size);
+		OutCompressed[5] = static_cast<uint8>(Size >> 8);
+		OutCompressed[6] = static_cast<uint8>(Size >> 16);
+		OutCompressed[7] = static_cast<uint8>(Size >> 24);
+
+		OutCompressed.SetNum(CompressedHeaderSize + CompressedSize, EAllowShrinking::No);
+
+		return true;
+	}
+
+	uint32 GetUncompressedSize(const uint8* const Data)
+	{
+		return Data[4] | (Data[5] << 8) | (Data[6] << 16) | (static_cast<uint32>(Data[7]) << 24);
+	}
+
+	FString ToWebSocketUrl(const FString& Url)
+	{
+		if (Url.StartsWith(TEXT("http://"), ESearchCase::IgnoreCase))
+		{
+			return TEXT("ws://") + Url.RightChop(7);
+		}
+
+		if (Url.StartsWith(TEXT("https://"), ESearchCase::IgnoreCase))
+		{
+			return TEXT("wss://") + Url.RightChop(8);
+		}
+
+		return Url;
+	}
+
+	bool ShouldReconnect(const int32 StatusCode, const bool bWasClean)
+	{
+		// Going away, abnormal closure and the server side failures, the others are refusals.
+		return !bWasClean || StatusCode == 1001 || StatusCode == 1006 || (StatusCode >= 1011 && StatusCode <= 1014);
+	}
+}
+
+UHttpWebSocket::UHttpWebSocket()
+	: Super()
+	, State(EHttpWebSocketState::Closed)
+	, ReconnectAttempts(0)
+	, QueuedBytes(0)
+	, bBackpressured(false)
+	, FrameCounter(0)
+	, FrameBytesSent(0)
+{
+	ReconnectPolicy.MaxRetries = 10;
+}
+
+UHttpWebSocket* UHttpWebSocket::CreateWebSocket(const FString& Url, const TMap<FString, FString>& Headers, const TArray<FString>& Protocols, const FName Profile)
+{
+	UHttpWebSocket* const WebSocket = NewObject<UHttpWebSocket>();
+
+	WebSocket->Protocols = Protocols;
+
+	if (Profile.IsNone())
+	{
+		WebSocket->Url = ToWebSocketUrl(Url);
+	}
+	else
+	{
+		FHttpClientProfile ProfileSettings;
+		if (FHttpClientProfiles::Find(Profile, ProfileSettings))
+		{
+			WebSocket->Headers = FHttpClientProfiles::GetHeaders(Profile);
+
+			if (ProfileSettings.RetryPolicy.IsEnabled())
+			{
+				WebSocket->ReconnectPolicy = ProfileSettings.RetryPolicy;
+			}
+		}
+		else
+		{
+			UE_LOG(LogHttp, Warning, TEXT("WebSocket: Unknown profile \"%s\", \"%s\" opened without it."), *Profile.ToString(), *Url);
+		}
+
+		WebSocket->Url = ToWebSocketUrl(FHttpClientProfiles::ResolveUrl(Profile, Url, {}));
+	}
+
+	WebSocket->Headers.Append(Headers);
+
+	return WebSocket;
+}
+
+bool UHttpWebSocket::Connect()
+{
+	if (ReconnectHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+		ReconnectHandle.Reset();
+	}
+
+	ReleaseSocket(1000, FString());
+
+	ReconnectAttempts = 0;
+
+	return StartConnection();
+}
+
+void UHttpWebSocket::Close(const int32 StatusCode, const FString& Reason)
+{
+	if (ReconnectHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+		ReconnectHandle.Reset();
+	}
+
+	if (FlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+		FlushHandle.Reset();
+	}
+
+	ReleaseSocket(StatusCode, Reason);
+
+	DEC_DWORD_STAT_BY(STAT_BlueprintHttp_WebSocketQueued, QueuedBytes);
+
+	Queue.Empty();
+	QueuedBytes	   = 0;
+	bBackpressured = false;
+
+	State = EHttpWebSocketState::Closed;
+}
+
+bool UHttpWebSocket::SendText(const FString& Message)
+{
+	const FTCHARToUTF8 Converted(*Message);
+
+	return Enqueue(TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length()), false);
+}
+
+bool UHttpWebSocket::SendBinary(const TArray<uint8>& Data)
+{
+	return Enqueue(TArray<uint8>(Data), true);
+}
+
+EHttpWebSocketState UHttpWebSocket::GetState() const
+{
+	return State;
+}
+
+int64 UHttpWebSocket::GetQueuedBytes() const
+{
+	return QueuedBytes;
+}
+
+int32 UHttpWebSocket::GetQueuedMessageCount() const
+{
+	return Queue.Num();
+}
+
+FString UHttpWebSocket::GetUrl() const
+{
+	return Url;
+}
+
+bool UHttpWebSocket::StartConnection()
+{
+	if (!Url.StartsWith(TEXT("ws://"), ESearchCase::IgnoreCase) && !Url.StartsWith(TEXT("wss://"), ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogHttp, Error, TEXT("WebSocket: \"%s\" isn't a WebSocket URL."), *Url);
+
+		Close();
+		OnClosed.Broadcast(this, 0, TEXT("Invalid URL"), false);
+		return false;
+	}
+
+	FWebSocketsModule& WebSockets = FModuleManager::LoadModuleChecked<FWebSocketsModule>(TEXT("WebSockets"));
+
+	Socket = WebSockets.CreateWebSocket(Url, Protocols, Headers);
+
+	Socket->OnConnected()		 .AddUObject(this, &UHttpWebSocket::OnSocketConnected);
+	Socket->OnConnectionError()	 .AddUObject(this, &UHttpWebSocket::OnSocketConnectionError);
+	Socket->OnClosed()			 .AddUObject(this, &UHttpWebSocket::OnSocketClosed);
+	Socket->OnMessage()			 .AddUObject(this, &UHttpWebSocket::OnSocketMessage);
+	Socket->OnBinaryMessage()	 .AddUObject(this, &UHttpWebSocket::OnSocketBinaryMessage);
+
+	State = EHttpWebSocketState::Connecting;
+
+	Socket->Connect();
+
+	return true;
+}
+
+void UHttpWebSocket::ReleaseSocket(const int32 StatusCode, const FString& Reason, const bool bCloseSocket)
+{
+	if (!Socket)
+	{
+		return;
+	}
+
+	if (State == EHttpWebSocketState::Open)
+	{
+		DEC_DWORD_STAT(STAT_BlueprintHttp_WebSocketsOpen);
+	}
+
+	// Unbound first, the close is reported later by the socket.
+	Socket->OnConnected()	   .RemoveAll(this);
+	Socket->OnConnectionError().RemoveAll(this);
+	Socket->OnClosed()		   .RemoveAll(this);
+	Socket->OnMessage()		   .RemoveAll(this);
+	Socket->OnBinaryMessage()  .RemoveAll(this);
+
+	if (bCloseSocket)
+	{
+		Socket->Close(StatusCode, Reason);
+	}
+
+	Socket.Reset();
+	PartialMessage.Empty();
+}
+
+void UHttpWebSocket::OnSocketConnected()
+{
+	INC_DWORD_STAT(STAT_BlueprintHttp_WebSocketsOpen);
+
+	State			  = EHttpWebSocketState::Open;
+	ReconnectAttempts = 0;
+
+	UE_LOG(LogHttp, Log, TEXT("WebSocket: Connected to \"%s\"."), *Url);
+
+	// The listeners may release the socket that is calling.
+	const TSharedPtr<IWebSocket> CurrentSocket = Socket;
+
+	OnConnected.Broadcast(this);
+
+	// Messages sent while connecting go out now.
+	if (Socket == CurrentSocket && State == EHttpWebSocketState::Open)
+	{
+		ScheduleFlush();
+	}
+}
+
+void UHttpWebSocket::OnSocketConnectionError(const FString& Error)
+{
+	const TSharedPtr<IWebSocket> KeepAlive = Socket;
+
+	UE_LOG(LogHttp, Warning, TEXT("WebSocket: Connection to \"%s\" failed: %s"), *Url, *Error);
+
+	HandleDisconnect(0, Error, false);
+}
+
+void UHttpWebSocket::OnSocketClosed(const int32 StatusCode, const FString& Reason, const bool bWasClean)
+{
+	const TSharedPtr<IWebSocket> KeepAlive = Socket;
+
+	UE_LOG(LogHttp, Log, TEXT("WebSocket: \"%s\" closed by the server (%d %s)."), *Url, StatusCode, *Reason);
+
+	HandleDisconnect(StatusCode, Reason, bWasClean);
+}
+
+void UHttpWebSocket::HandleDisconnect(const int32 StatusCode, const FString& Reason, const bool bWasClean)
+{
+	ReleaseSocket(StatusCode, Reason, /* bCloseSocket */ false);
+
+	if (FlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+		FlushHandle.Reset();
+	}
+
+	const bool bReconnect = ReconnectPolicy.IsEnabled() && ReconnectAttempts < ReconnectPolicy.MaxRetries && ShouldReconnect(StatusCode, bWasClean);
+
+	if (!bReconnect)
+	{
+		Close();
+		OnClosed.Broadcast(this, StatusCode, Reason, false);
+		return;
+	}
+
+	ScheduleReconnect();
+	OnClosed.Broadcast(this, StatusCode, Reason, true);
+}
+
+void UHttpWebSocket::ScheduleReconnect()
+{
+	const float Delay = ReconnectPolicy.GetBackoffDelay(ReconnectAttempts);
+
+	++ReconnectAttempts;
+
+	UE_LOG(LogHttp, Log, TEXT("WebSocket: Reconnecting to \"%s\" in %.2fs (attempt %d/%d)."), *Url, Delay, ReconnectAttempts, ReconnectPolicy.MaxRetries);
+
+	State = EHttpWebSocketState::Connecting;
+
+	ReconnectHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+	{
+		ReconnectHandle.Reset();
+		StartConnection();
+		return false;
+	}), Delay);
+}
+
+bool UHttpWebSocket::Enqueue(TArray<uint8>&& Data, const bool bBinary)
+{
+	bool bSendBinary = bBinary;
+
+	if (bUseCustomCompressionFraming && Data.Num() > CompressionThreshold)
+	{
+		TArray<uint8> Compressed;
+		if (CompressMessage(Data, bBinary, Compressed))
+		{
+			Data		= MoveTemp(Compressed);
+			bSendBinary = true;
+		}
+	}
+
+	// An empty queue takes any message, otherwise a message larger than the limit could never be sent.
+	if (MaxQueuedBytes > 0 && QueuedBytes + Data.Num() > MaxQueuedBytes && Queue.Num() > 0)
+	{
+		UE_LOG(LogHttp, Verbose, TEXT("WebSocket: Queue of \"%s\" full (%lld bytes), message of %d bytes refused."), *Url, QueuedBytes, Data.Num());
+
+		bBackpressured = true;
+		return false;
+	}
+
+	QueuedBytes += Data.Num();
+	INC_DWORD_STAT_BY(STAT_BlueprintHttp_WebSocketQueued, Data.Num());
+
+	Queue.Add({ MoveTemp(Data), bSendBinary });
+
+	if (State == EHttpWebSocketState::Open)
+	{
+		ScheduleFlush();
+	}
+
+	return true;
+}
+
+void UHttpWebSocket::ScheduleFlush()
+{
+	if (FlushQueue() && !FlushHandle.IsValid())
+	{
+		FlushHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+		{
+			const bool bRemaining = State == EHttpWebSocketState::Open && FlushQueue();
+			if (!bRemaining)
+			{
+				FlushHandle.Reset();
+			}
+			return bRemaining;
+		}));
+	}
+}
+
+bool UHttpWebSocket::FlushQueue()
+{
+	if (FrameCounter != GFrameCounter)
+	{
+		FrameCounter   = GFrameCounter;
+		FrameBytesSent = 0;
+	}
+
+	int32 Sent = 0;
+	int64 SentBytes = 0;
+
+	// At least one message a frame, whatever its size.
+	while (Sent < Queue.Num() && (MaxBytesPerFrame <= 0 || FrameBytesSent == 0 || FrameBytesSent + Queue[Sent].Data.Num() <= MaxBytesPerFrame))
+	{
+		const FQueuedMessage& Message = Queue[Sent];
+
+		Socket->Send(Message.Data.GetData(), Message.Data.Num(), Message.bBinary);
+
+		FrameBytesSent += Message.Data.Num();
+		SentBytes	   += Message.Data.Num();
+		++Sent;
+	}
+
+	if (Sent > 0)
+	{
+		Queue.RemoveAt(0, Sent, EAllowShrinking::No);
+		QueuedBytes -= SentBytes;
+
+		INC_DWORD_STAT_BY(STAT_BlueprintHttp_WebSocketSent, Sent);
+		DEC_DWORD_STAT_BY(STAT_BlueprintHttp_WebSocketQueued, SentBytes);
+	}
+
+	if (Queue.Num() > 0)
+	{
+		return true;
+	}
+
+	if (bBackpressured)
+	{
+		bBackpressured = false;
+		OnSendQueueDrained.Broadcast(this);
+	}
+
+	return false;
+}
+
+void UHttpWebSocket::OnSocketMessage(const FString& Message)
+{
+	const TSharedPtr<IWebSocket> KeepAlive = Socket;
+
+	INC_DWORD_STAT(STAT_BlueprintHttp_WebSocketReceived);
+
+	OnMessage.Broadcast(this, Message);
+}
+
+void UHttpWebSocket::OnSocketBinaryMessage(const void* Data, SIZE_T Size, bool bIsLastFragment)
+{
+	// The listeners may release the socket that is calling.
+	const TSharedPtr<IWebSocket> KeepAlive = Socket;
+
+	if (PartialMessage.Num() == 0 && bIsLastFragment)
+	{
+		DeliverMessage(static_cast<const uint8*>(Data), Size, true);
+		return;
+	}
+
+	if (MaxMessageSize > 0 && PartialMessage.Num() + Size > static_cast<SIZE_T>(MaxMessageSize))
+	{
+		UE_LOG(LogHttp, Error, TEXT("WebSocket: Message from \"%s\" larger than %d bytes."), *Url, MaxMessageSize);
+
+		Close(1009, TEXT("Message too big"));
+		OnClosed.Broadcast(this, 1009, TEXT("Message too big"), false);
+		return;
+	}
+
+	PartialMessage.Append(static_cast<const uint8*>(Data), Size);
+
+	if (bIsLastFragment)
+	{
+		const TArray<uint8> Message = MoveTemp(PartialMessage);
+		PartialMessage.Reset();
+
+		DeliverMessage(Message.GetData(), Message.Num(), true);
+	}
+}
+
+void UHttpWebSocket::DeliverMessage(const uint8* const Data, const int64 Length, const bool bBinary)
+{
+	if (MaxMessageSize > 0 && Length > MaxMessageSize)
+	{
+		UE_LOG(LogHttp, Error, TEXT("WebSocket: Message from \"%s\" larger than %d bytes."), *Url, MaxMessageSize);
+
+		Close(1009, TEXT("Message too big"));
+		OnClosed.Broadcast(this, 1009, TEXT("Message too big"), false);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_BlueprintHttp_WebSocketReceived);
+
+	if (!bUseCustomCompressionFraming || !IsCompressedMessage(Data, Length))
+	{
+		OnBinaryMessage.Broadcast(this, TArray<uint8>(Data, Length));
+		return;
+	}
+
+	const int64 Size = GetUncompressedSize(Data);
+
+	if (Size > (Length - CompressedHeaderSize) * MaxCompressionRatio)
+	{
+		UE_LOG(LogHttp, Warning, TEXT("WebSocket: Compressed message from \"%s\" announces %lld bytes from %lld, dropped."), *Url, Size, Length - CompressedHeaderSize);
+		return;
+	}
+
+	// Arrays are indexed with int32 even without a limit.
+	const int32 SizeLimit = MaxMessageSize > 0 ? MaxMessageSize : MAX_int32;
+
+	if (Size > SizeLimit)
+	{
+		UE_LOG(LogHttp, Error, TEXT("WebSocket: Compressed message from \"%s\" larger than %d bytes."), *Url, SizeLimit);
+
+		Close(1009, TEXT("Message too big"));
+		OnClosed.Broadcast(this, 1009, TEXT("Message too big"), false);
+		return;
+	}
+
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(static_cast<int32>(Size));
+
+	if (!FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), Uncompressed.Num(), Data + CompressedHeaderSize, Length - CompressedHeaderSize))
+	{
+		UE_LOG(LogHttp, Warning, TEXT("WebSocket: Failed to decompress a message from \"%s\", dropped."), *Url);
+		return;
+	}
+
+	if (Data[3] == 'B')
+	{
+		OnBinaryMessage.Broadcast(this, Uncompressed);
+		return;
+	}
+
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Uncompressed.GetData()), Uncompressed.Num());
+	OnMessage.Broadcast(this, FString(Converted.Length(), Converted.Get()));
+}
+
+void UHttpWebSocket::BeginDestroy()
+{
+	// Otherwise the connection would stay open.
+	Close(1001, TEXT("Going away"));
+
+	Super::BeginDestroy();
+}
@@ -0,0 +1,194 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpWebSocketEchoTest.h"
+#include "Http.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "Containers/StringConv.h"
+
+#if WITH_BLUEPRINTHTTP_BENCHMARKS
+static FAutoConsoleCommand GHttpWebSocketEchoCommand(
+	TEXT("http.WebSocket.Echo"),
+	TEXT("Sends text and binary messages to a WebSocket echo server and checks the echoes. ")
+	TEXT("Args: <Url> [Count=200] [Size=4096] [Compress] [Quit]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&UHttpWebSocketEchoTest::Run)
+);
+#endif // WITH_BLUEPRINTHTTP_BENCHMARKS
+
+void UHttpWebSocketEchoTest::Run(const TArray<FString>& Args)
+{
+	UHttpWebSocketEchoTest* const Test = NewObject<UHttpWebSocketEchoTest>();
+
+	Test->AddToRoot();
+
+	if (!Test->Start(Args))
+	{
+		Test->Finish(TEXT("Usage: http.WebSocket.Echo <Url> [Count=200] [Size=4096] [Compress] [Quit]"));
+	}
+}
+
+bool UHttpWebSocketEchoTest::Start(const TArray<FString>& Args)
+{
+	bool bCompress = false;
+
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Count="), Count);
+		FParse::Value(*Arg, TEXT("Size="),  Size);
+
+		bCompress	  |= Arg.Equals(TEXT("Compress"), ESearchCase::IgnoreCase);
+		bQuitWhenDone |= Arg.Equals(TEXT("Quit"),	  ESearchCase::IgnoreCase);
+	}
+
+	if (Args.Num() == 0 || Count <= 0 || Size <= 0)
+	{
+		return false;
+	}
+
+	WebSocket = UHttpWebSocket::CreateWebSocket(Args[0], {}, {});
+
+	WebSocket->bUseCustomCompressionFraming = bCompress;
+
+	// Fails on the first lost connection, the echoes of the lost messages would never come.
+	WebSocket->ReconnectPolicy.MaxRetries = 0;
+
+	WebSocket->OnConnected		  .AddDynamic(this, &UHttpWebSocketEchoTest::OnConnected);
+	WebSocket->OnMessage		  .AddDynamic(this, &UHttpWebSocketEchoTest::OnMessage);
+	WebSocket->OnBinaryMessage	  .AddDynamic(this, &UHttpWebSocketEchoTest::OnBinaryMessage);
+	WebSocket->OnClosed			  .AddDynamic(this, &UHttpWebSocketEchoTest::OnClosed);
+	WebSocket->OnSendQueueDrained .AddDynamic(this, &UHttpWebSocketEchoTest::OnSendQueueDrained);
+
+	UE_LOG(LogHttp, Display, TEXT("WebSocket: Echo test of %d messages of %d bytes against \"%s\"%s."),
+		Count, Size, *WebSocket->GetUrl(), bCompress ? TEXT(" with compression") : TEXT(""));
+
+	// Failures are reported by OnClosed.
+	WebSocket->Connect();
+
+	return true;
+}
+
+TArray<uint8> UHttpWebSocketEchoTest::MakePayload(const int32 Index) const
+{
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(Size);
+
+	// Even messages are text, kept to lowercase letters so they survive the UTF-8 round trip.
+	const bool bBinary = Index % 2 == 1;
+
+	for (int32 i = 0; i < Size; ++i)
+	{
+		Payload[i] = bBinary ? static_cast<uint8>((i + Index) * 31) : static_cast<uint8>('a' + (i / 16 + Index) % 26);
+	}
+
+	return Payload;
+}
+
+void UHttpWebSocketEchoTest::SendPending()
+{
+	while (Sent < Count)
+	{
+		const TArray<uint8> Payload = MakePayload(Sent);
+
+		bool bQueued;
+		if (Sent % 2 == 1)
+		{
+			bQueued = WebSocket->SendBinary(Payload);
+		}
+		else
+		{
+			const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+			bQueued = WebSocket->SendText(FString(Text.Length(), Text.Get()));
+		}
+
+		// Resumed by OnSendQueueDrained.
+		if (!bQueued)
+		{
+			++Refused;
+			return;
+		}
+
+		++Sent;
+	}
+}
+
+void UHttpWebSocketEchoTest::OnConnected(UHttpWebSocket* const Socket)
+{
+	StartTime = FPlatformTime::Seconds();
+
+	SendPending();
+}
+
+void UHttpWebSocketEchoTest::OnSendQueueDrained(UHttpWebSocket* const Socket)
+{
+	SendPending();
+}
+
+void UHttpWebSocketEchoTest::OnMessage(UHttpWebSocket* const Socket, const FString& Message)
+{
+	const FTCHARToUTF8 Converted(*Message);
+
+	CheckEcho(TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length()), false);
+}
+
+void UHttpWebSocketEchoTest::OnBinaryMessage(UHttpWebSocket* const Socket, const TArray<uint8>& Data)
+{
+	CheckEcho(Data, true);
+}
+
+void UHttpWebSocketEchoTest::CheckEcho(const TArray<uint8>& Data, const bool bBinary)
+{
+	// Echo servers answer in order.
+	if (bBinary != (Echoed % 2 == 1) || Data != MakePayload(Echoed))
+	{
+		++Mismatches;
+	}
+
+	if (++Echoed == Count)
+	{
+		Finish(FString());
+	}
+}
+
+void UHttpWebSocketEchoTest::OnClosed(UHttpWebSocket* const Socket, const int32 StatusCode, const FString& Reason, const bool bWillReconnect)
+{
+	Finish(FString::Printf(TEXT("Connection closed (%d %s)."), StatusCode, *Reason));
+}
+
+void UHttpWebSocketEchoTest::Finish(const FString& Error)
+{
+	const double Elapsed = StartTime > 0. ? FPlatformTime::Seconds() - StartTime : 0.;
+	const bool bSucceeded = Error.IsEmpty() && Mismatches == 0;
+
+	if (WebSocket)
+	{
+		WebSocket->OnClosed.RemoveAll(this);
+		WebSocket->Close();
+		WebSocket = nullptr;
+	}
+
+	if (!Error.IsEmpty())
+	{
+		UE_LOG(LogHttp, Error, TEXT("WebSocket: Echo test failed after %d/%d echoes: %s"), Echoed, Count, *Error);
+	}
+	else
+	{
+		UE_LOG(LogHttp, Display, TEXT("WebSocket: Echo test %s, %d messages in %.1fms (%.0f msg/s), %d mismatches, %d refused by the full queue."),
+			bSucceeded ? TEXT("passed") : TEXT("failed"), Echoed, Elapsed * 1000., Elapsed > 0. ? Echoed / Elapsed : 0., Mismatches, Refused);
+	}
+
+	RemoveFromRoot();
+
+	if (bQuitWhenDone)
+	{
+		if (bSucceeded)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+		else
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpWebSocket.h"
+#include "HttpWebSocketEchoTest.generated.h"
+
+/**
+ *  Round trip of text, binary and optionally compressed messages through a WebSocket echo server.
+ *  Messages are sent as fast as the queue takes them, so backpressure is exercised, and each echo
+ *  is compared with what was sent.
+ *
+ *  Run it against a local echo server with:
+ *  UnrealEditor-Cmd BdeBexpo.uproject -game -nullrhi -unattended -ExecCmds="http.WebSocket.Echo ws://127.0.0.1:8080 Quit"
+ **/
+UCLASS(Transient)
+class UHttpWebSocketEchoTest final : public UObject
+{
+	GENERATED_BODY()
+public:
+	/* Console entry point. Args: <Url> [Count=200] [Size=4096] [Compress] [Quit] */
+	static void Run(const TArray<FString>& Args);
+
+private:
+	bool Start(const TArray<FString>& Args);
+	void Finish(const FString& Error);
+
+	void SendPending();
+	TArray<uint8> MakePayload(const int32 Index) const;
+
+	UFUNCTION()
+	void OnConnected(UHttpWebSocket* const Socket);
+
+	UFUNCTION()
+	void OnMessage(UHttpWebSocket* const Socket, const FString& Message);
+
+	UFUNCTION()
+	void OnBinaryMessage(UHttpWebSocket* const Socket, const TArray<uint8>& Data);
+
+	UFUNCTION()
+	void OnClosed(UHttpWebSocket* const Socket, const int32 StatusCode, const FString& Reason, const bool bWillReconnect);
+
+	UFUNCTION()
+	void OnSendQueueDrained(UHttpWebSocket* const Socket);
+
+	void CheckEcho(const TArray<uint8>& Data, const bool bBinary);
+
+	UPROPERTY()
+	UHttpWebSocket* WebSocket;
+
+	int32 Count	  = 200;
+	int32 Size	  = 4096;
+	int32 Sent	  = 0;
+	int32 Echoed  = 0;
+	int32 Refused = 0;
+	int32 Mismatches = 0;
+
+	double StartTime = 0.;
+	bool bQuitWhenDone = false;
+};
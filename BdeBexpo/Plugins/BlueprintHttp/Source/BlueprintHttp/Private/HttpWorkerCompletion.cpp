@@ -0,0 +1,54 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpWorkerCompletion.h"
+#include "HttpResponseBody.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Async/Async.h"
+
+const TArray<uint8>& FHttpWorkerCompletion::GetContent() const
+{
+	static const TArray<uint8> Empty;
+
+	return Body ? Body->GetContent() : NativeResponse ? NativeResponse->GetContent() : Snapshot ? Snapshot->Content : Empty;
+}
+
+FString FHttpWorkerCompletion::GetHeader(const FString& Key) const
+{
+	return NativeResponse ? NativeResponse->GetHeader(Key) : Snapshot ? Snapshot->GetHeader(Key) : FString();
+}
+
+TArray<FString> FHttpWorkerCompletion::GetAllHeaders() const
+{
+	return NativeResponse ? NativeResponse->GetAllHeaders() : Snapshot ? Snapshot->Headers : TArray<FString>();
+}
+
+void FHttpWorkerCompletion::MarshalToGameThread(TUniqueFunction<void(UHttpRequest* const Request)> Callback) const
+{
+	AsyncTask(ENamedThreads::GameThread, [WeakRequest = Request, Callback = MoveTemp(Callback)]()
+	{
+		Callback(WeakRequest.Get());
+	});
+}
+
+TSharedRef<const FHttpWorkerCompletion, ESPMode::ThreadSafe> FHttpWorkerCompletion::Capture(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bInConnectedSuccessfully)
+{
+	check(IsInGameThread());
+
+	const TSharedRef<FHttpWorkerCompletion, ESPMode::ThreadSafe> Completion = MakeShared<FHttpWorkerCompletion, ESPMode::ThreadSafe>();
+
+	Completion->Request				   = InRequest;
+	Completion->URL					   = InRequest->GetURL();
+	Completion->bConnectedSuccessfully = bInConnectedSuccessfully;
+	Completion->Status				   = InRequest->GetStatus();
+	Completion->ElapsedTime			   = InRequest->GetElapsedTime();
+
+	if (Response)
+	{
+		Completion->ResponseCode   = Response->GetResponseCode();
+		Completion->NativeResponse = Response->GetNativeResponse();
+		Completion->Snapshot	   = Response->GetSnapshot();
+		Completion->Body		   = Response->GetBody();
+	}
+
+	return Completion;
+}
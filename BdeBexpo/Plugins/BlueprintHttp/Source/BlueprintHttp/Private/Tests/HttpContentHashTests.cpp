@@ -0,0 +1,108 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#include "HttpContentHash.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BlueprintHttpContentHashTests
+{
+	struct FKnownAnswer
+	{
+		EHttpHashAlgorithm Algorithm;
+		const ANSICHAR*	   Input;
+		int32			   Repeat;
+		const TCHAR*	   Digest;
+	};
+
+	/* Vectors of FIPS 180-2, of the CRC-32 catalogue and of the xxHash reference implementation. */
+	const FKnownAnswer KnownAnswers[] =
+	{
+		{ EHttpHashAlgorithm::SHA256,	"",			1,		 TEXT("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855") },
+		{ EHttpHashAlgorithm::SHA256,	"abc",		1,		 TEXT("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") },
+		{ EHttpHashAlgorithm::SHA256,	"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1, TEXT("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1") },
+		{ EHttpHashAlgorithm::SHA256,	"a",		1000000, TEXT("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0") },
+		{ EHttpHashAlgorithm::CRC32,	"",			1,		 TEXT("00000000") },
+		{ EHttpHashAlgorithm::CRC32,	"123456789", 1,		 TEXT("cbf43926") },
+		{ EHttpHashAlgorithm::CRC32,	"The quick brown fox jumps over the lazy dog", 1, TEXT("414fa339") },
+		{ EHttpHashAlgorithm::XxHash64, "",			1,		 TEXT("ef46db3751d8e999") },
+		{ EHttpHashAlgorithm::XxHash64, "a",		1,		 TEXT("d24ec4f1a98c6e5b") },
+		{ EHttpHashAlgorithm::XxHash64, "abc",		1,		 TEXT("44bc2cf5ad770999") },
+		{ EHttpHashAlgorithm::XxHash64, "The quick brown fox jumps over the lazy dog", 1, TEXT("0b242d361fda71bc") },
+		{ EHttpHashAlgorithm::XxHash64, "a",		1000000, TEXT("dc483aaa9b4fdc40") },
+	};
+
+	TArray<uint8> MakeInput(const FKnownAnswer& Answer)
+	{
+		const int32 Length = FCStringAnsi::Strlen(Answer.Input);
+
+		TArray<uint8> Input;
+		Input.Reserve(Length * Answer.Repeat);
+
+		for (int32 Index = 0; Index < Answer.Repeat; ++Index)
+		{
+			Input.Append(reinterpret_cast<const uint8*>(Answer.Input), Length);
+		}
+
+		return Input;
+	}
+
+	/* Feeds the input in ChunkSize pieces, zero for a single call. */
+	FString Hash(const EHttpHashAlgorithm Algorithm, const TArray<uint8>& Input, const int32 ChunkSize)
+	{
+		FHttpStreamingHash StreamingHash(Algorithm);
+
+		const int32 Step = ChunkSize > 0 ? ChunkSize : FMath::Max(Input.Num(), 1);
+
+		for (int32 Offset = 0; Offset < Input.Num(); Offset += Step)
+		{
+			StreamingHash.Update(Input.GetData() + Offset, FMath::Min(Step, Input.Num() - Offset));
+		}
+
+		const TArray<uint8> Digest = StreamingHash.Finalize();
+
+		return BytesToHex(Digest.GetData(), Digest.Num()).ToLower();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHttpContentHashKnownAnswerTest, "BlueprintHttp.ContentHash.KnownAnswers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHttpContentHashKnownAnswerTest::RunTest(const FString& Parameters)
+{
+	using namespace BlueprintHttpContentHashTests;
+
+	const UEnum* const AlgorithmEnum = StaticEnum<EHttpHashAlgorithm>();
+
+	for (const FKnownAnswer& Answer : KnownAnswers)
+	{
+		const TArray<uint8> Input = MakeInput(Answer);
+		const FString Name = FString::Printf(TEXT("%s of %d x \"%hs\""), *AlgorithmEnum->GetNameStringByValue(static_cast<int64>(Answer.Algorithm)), Answer.Repeat, Answer.Input);
+
+		// Odd chunk sizes cross the 64 bytes blocks of SHA-256 and the 32 bytes stripes of xxHash64 at every offset.
+		TestEqual(*FString::Printf(TEXT("%s in one call"),	  *Name), Hash(Answer.Algorithm, Input, 0),	   FString(Answer.Digest));
+		TestEqual(*FString::Printf(TEXT("%s by 63 bytes"),	  *Name), Hash(Answer.Algorithm, Input, 63),   FString(Answer.Digest));
+		TestEqual(*FString::Printf(TEXT("%s by 4097 bytes"), *Name), Hash(Answer.Algorithm, Input, 4097), FString(Answer.Digest));
+
+		if (Input.Num() <= 4096)
+		{
+			TestEqual(*FString::Printf(TEXT("%s by 1 byte"), *Name), Hash(Answer.Algorithm, Input, 1), FString(Answer.Digest));
+		}
+	}
+
+	// The SHA-256 of the streaming hash is FHttpSha256, checked on its own as well.
+	{
+		FHttpSha256 Sha256;
+		Sha256.Update(reinterpret_cast<const uint8*>("abc"), 3);
+
+		uint8 Digest[FHttpSha256::DigestSize];
+		Sha256.Final(Digest);
+
+		TestEqual(TEXT("FHttpSha256 of \"abc\""), BytesToHex(Digest, FHttpSha256::DigestSize).ToLower(),
+			FString(TEXT("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -5,6 +5,14 @@
 #include "CoreMinimal.h"
 #include "HttpResponseCode.h"
 #include "HttpRequest.h"
+#include "HttpUrl.h"
+#include "HttpClientProfile.h"
+#include "HttpTransport.h"
+#include "HttpNetworkSimulator.h"
+#include "HttpThreadTuner.h"
+#include "HttpRequestScheduler.h"
+#include "HttpConnectionWarmer.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "BlueprintHttpLibrary.generated.h"
 
@@ -71,19 +79,19 @@ public:
     UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set HTTP Timeout"))
 	static void HttpGlobal_SetHttpTimeout(const float Timeout);
 
-    /* Sets the mimimum tick rate of an idle HTTP thread */
+    /* Sets the mimimum tick rate of an idle HTTP thread. Stops the adaptive thread tuning. */
     UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set HTTP Thread Idle Minimum Sleep Time in Seconds"))
 	static void HttpGlobal_SetHttpThreadIdleMinimumSleepTimeInSeconds(const float Time);
 
-    /* Sets the target tick rate of an idle HTTP thread */
+    /* Sets the target tick rate of an idle HTTP thread. Stops the adaptive thread tuning. */
     UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set HTTP Thread Idle Frame Time in Seconds"))
 	static void HttpGlobal_SetHttpThreadIdleFrameTimeInSeconds(const float Time);
 
-    /* Sets the mimimum tick rate of an active HTTP thread */
+    /* Sets the mimimum tick rate of an active HTTP thread. Stops the adaptive thread tuning. */
     UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set HTTP Thread Active Minimum Sleep Time in Seconds"))
     static void HttpGlobal_SetHttpThreadActiveMinimumSleepTimeInSeconds(const float Time);
 
-    /* Sets the target tick rate of an active HTTP thread */
+    /* Sets the target tick rate of an active HTTP thread. Stops the adaptive thread tuning. */
     UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set HTTP Thread Active Frame Time in Seconds"))
     static void HttpGlobal_SetHttpThreadActiveFrameTimeInSeconds(const float Time);
 
@@ -91,6 +99,178 @@ public:
     UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set HTTP Delay Time"))
     static void HttpGlobal_SetHttpDelayTime(const float Delay);
 
+    /**
+     * Retunes the HTTP thread's frame and sleep times from the requests in flight, the throughput and the power available.
+     * Latency favors responsiveness, Efficiency favors battery life, Manual keeps the values set with the setters above.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set HTTP Thread Tuning Preset"))
+    static void HttpGlobal_SetHttpThreadTuningPreset(const EHttpThreadTuningPreset Preset);
+
+    /* Gets how the HTTP thread is tuned. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Get HTTP Thread Tuning Preset"))
+    static EHttpThreadTuningPreset HttpGlobal_GetHttpThreadTuningPreset();
+
+    /* Tells the adaptive thread tuning how much power is available. Auto reads it from the platform. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Power Hint"))
+    static void HttpGlobal_SetPowerHint(const EHttpPowerHint Hint);
+
+    /**
+     * Sets how often requests created afterwards broadcast their progress, including the ones made by the HTTP nodes.
+     * The Download File node reports its progress every frame when the policy is Off.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Default Progress Policy"))
+    static void HttpGlobal_SetDefaultProgressPolicy(const FHttpProgressPolicy& Policy);
+
+    /**
+     * Sets the time request completions can take each frame on the game thread.
+     * Once spent, completions are delivered on the next frames, Interactive requests first.
+     * @param Milliseconds The budget per frame. Zero delivers all the completions right away.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Completion Frame Budget"))
+    static void HttpGlobal_SetCompletionFrameBudget(const float Milliseconds);
+
+    /* Gets the number of request completions waiting for frame budget. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Get Completion Backlog"))
+    static int32 HttpGlobal_GetCompletionBacklog();
+
+    /**
+     * Limits the bandwidth of all the requests. Requests wait until the bandwidth allows them to start,
+     * started requests aren't slowed down: their downloads delay the next requests instead.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Bandwidth Limit"))
+    static void HttpGlobal_SetBandwidthLimit(const FHttpBandwidthLimit& Limit);
+
+    /**
+     * Limits the bandwidth of the requests to a host. An unlimited limit exempts the host from the default one.
+     * An empty host sets the limit of each host without its own.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Host Bandwidth Limit"))
+    static void HttpGlobal_SetHostBandwidthLimit(const FString& Host, const FHttpBandwidthLimit& Limit);
+
+    /**
+     * Limits the bandwidth of the requests of a priority.
+     * Normal and Interactive requests borrow from the Background bandwidth when they run out of their own.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Priority Bandwidth Limit"))
+    static void HttpGlobal_SetPriorityBandwidthLimit(const EHttpRequestPriority Priority, const FHttpBandwidthLimit& Limit);
+
+    /* Removes all the bandwidth limits. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Clear Bandwidth Limits"))
+    static void HttpGlobal_ClearBandwidthLimits();
+
+    /**
+     * Connects to the hosts so that the first requests don't pay for the handshakes.
+     * @param Hosts             Host names or URLs. Host names are reached with HTTPS.
+     * @param KeepWarmDuration  How long the connections are kept alive, in seconds.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Prewarm Connections"))
+    static void HttpGlobal_PrewarmConnections(const TArray<FString>& Hosts, const float KeepWarmDuration = 60.f);
+
+    /* Returns the time to first byte measured for the host, with and without a warm connection. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Get Time To First Byte"))
+    static FHttpFirstByteStats HttpGlobal_GetTimeToFirstByte(const FString& Host);
+
+    /**
+     * Limits the response bytes the requests in flight hold in memory. New requests wait until the budget has room for
+     * the reservation of http.Memory.ReservationKB, responses that would exceed it are moved to temporary files.
+     * @param BudgetMB          The budget in megabytes, zero to disable it.
+     * @param SpillThresholdMB  Size above which responses are moved to temporary files, zero to keep them in memory.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Response Memory Budget"))
+    static void HttpGlobal_SetResponseMemoryBudget(const int32 BudgetMB, const int32 SpillThresholdMB);
+
+    /* Returns the response bytes held in memory by the requests in flight. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Get Buffered Response Bytes"))
+    static int64 HttpGlobal_GetBufferedResponseBytes();
+
+    /* Cancels the request when Owner is destroyed or when its world is cleaned up. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Bind Request to Owner", DefaultToSelf = "Owner"))
+    static void HttpGlobal_BindRequestToOwner(UHttpRequest* const Request, UObject* const Owner);
+
+    /* Cancels the request when the scope is cancelled. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Bind Request to Scope"))
+    static void HttpGlobal_BindRequestToScope(UHttpRequest* const Request, const FName Scope);
+
+    /**
+     * Cancels the request of an HTTP node when Owner is destroyed.
+     * The node is released without firing its outputs.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "Bind HTTP Node to Owner", DefaultToSelf = "Owner"))
+    static void BindHttpNodeToOwner(UBlueprintAsyncActionBase* const Node, UObject* const Owner);
+
+    /* Cancels the request of an HTTP node when the scope is cancelled. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "Bind HTTP Node to Scope"))
+    static void BindHttpNodeToScope(UBlueprintAsyncActionBase* const Node, const FName Scope);
+
+    /**
+     * Cancels the requests bound to the scope.
+     * @param bNotifyListeners  If the requests still broadcast their failed completion.
+     * @return The number of requests cancelled.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "Cancel HTTP Scope"))
+    static int32 CancelHttpScope(const FName Scope, const bool bNotifyListeners = false);
+
+    /* Cancels the requests bound to Owner. Returns the number of requests cancelled. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "Cancel HTTP Requests of Owner", DefaultToSelf = "Owner"))
+    static int32 CancelHttpRequestsOfOwner(UObject* const Owner, const bool bNotifyListeners = false);
+
+    /**
+     * Sets how new requests reach their server.
+     * @param Mode                  Network sends requests, Record also saves each exchange, Replay serves them from the archive.
+     * @param ArchivePath           The archive to record to or to replay from. Unused for Network.
+     * @param bReplayOriginalTiming When replaying, completes requests after the time they originally took.
+     * @return If the mode could be set. The previous mode is kept otherwise.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Transport Mode"))
+    static bool HttpGlobal_SetTransportMode(const EHttpTransportMode Mode, const FString& ArchivePath, const bool bReplayOriginalTiming = false);
+
+    /* Gets how new requests reach their server. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Get Transport Mode"))
+    static EHttpTransportMode HttpGlobal_GetTransportMode();
+
+    /* Saves the exchanges recorded so far to the archive. Returns false if not recording. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Flush Recording"))
+    static bool HttpGlobal_FlushRecording();
+
+    /**
+     * Simulates a degraded network for new requests using a registered profile.
+     * Built-in profiles are ExpoWifi, 3G, Edge, Lossy and HighLatency. None disables the simulation.
+     * @return If the profile exists.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Network Simulation Profile"))
+    static bool HttpGlobal_SetNetworkSimulationProfile(const FName ProfileName);
+
+    /* Simulates a degraded network for new requests using custom conditions. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Set Network Simulation Conditions"))
+    static void HttpGlobal_SetNetworkSimulationConditions(const FHttpNetworkConditions& Conditions);
+
+    /* Stops simulating network conditions for new requests. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Disable Network Simulation"))
+    static void HttpGlobal_DisableNetworkSimulation();
+
+    /* Gets the simulated profile, Custom for custom conditions or None when disabled. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Get Network Simulation Profile"))
+    static FName HttpGlobal_GetNetworkSimulationProfile();
+
+    /* Adds or replaces a network simulation profile. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Register Network Simulation Profile"))
+    static void HttpGlobal_RegisterNetworkSimulationProfile(const FName ProfileName, const FHttpNetworkConditions& Conditions);
+
+    /**
+     * Adds or replaces a client profile: the base URL, headers, timeouts, retry policy and priority
+     * of the requests sent to one API. Unlike default headers, only the requests using the profile get them.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Register Client Profile"))
+    static void HttpGlobal_RegisterClientProfile(const FName ProfileName, const FHttpClientProfile& Profile);
+
+    /* Removes a client profile. Returns false if it doesn't exist. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Unregister Client Profile"))
+    static bool HttpGlobal_UnregisterClientProfile(const FName ProfileName);
+
+    /* Gets a registered client profile. Returns false if it doesn't exist. */
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (DisplayName = "GLOBAL HTTP - Find Client Profile"))
+    static bool HttpGlobal_FindClientProfile(const FName ProfileName, FHttpClientProfile& OutProfile);
+
     /* Converts the response code to its official name code. */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
     static FString HttpResponseCodeToString(const int32 ResponseCode);
@@ -122,8 +302,8 @@ public:
      * if the wanted MIME-Type isn't defined in the enum.
      * @return The initialized request.
      **/
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (AutoCreateRefTerm = "Headers, UrlParameters"))
-    static UHttpRequest* CreateInitializedRequest(const FString& Url, const TMap<FString, FString> & UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers);
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (AutoCreateRefTerm = "Headers, UrlParameters", AdvancedDisplay = "Profile"))
+    static UHttpRequest* CreateInitializedRequest(const FString& Url, const TMap<FString, FString> & UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers, const FName Profile = NAME_None);
 
     /**
      * Create a request and initialize it to the specified properties. 
@@ -131,13 +311,47 @@ public:
      * if the wanted MIME-Type isn't defined in the enum.
      * @return The initialized request.
      **/
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (AutoCreateRefTerm = "Headers, Content, UrlParameters"))
-    static UHttpRequest* CreateInitializedBinaryRequest(const FString& Url, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8> & Content, const TMap<FString, FString>& Headers);
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (AutoCreateRefTerm = "Headers, Content, UrlParameters", AdvancedDisplay = "Profile"))
+    static UHttpRequest* CreateInitializedBinaryRequest(const FString& Url, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8> & Content, const TMap<FString, FString>& Headers, const FName Profile = NAME_None);
+
+    /**
+     * Creates a request with the settings of a client profile.
+     * @param Path  Appended to the base URL of the profile. Absolute URLs are used as-is.
+     **/
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (AutoCreateRefTerm = "UrlParameters"))
+    static UHttpRequest* CreateRequestFromProfile(const FName Profile, const FString& Path, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb);
+
+    /**
+     * Sets the URL, MIME type, headers and timeouts of a new request, through a client profile unless Profile is None.
+     * With a profile, Url is a path appended to its base URL. Headers replace the profile's,
+     * a Content-Type header replaces the MIME type and timeouts replace the profile's when any is set.
+     **/
+    static void InitializeRequest(UHttpRequest* const Request, const FName Profile, const FString& Url, const TMap<FString, FString>& UrlParameters,
+        const EHttpMimeType MimeType, const TMap<FString, FString>& Headers, const FHttpRequestTimeouts& Timeouts = FHttpRequestTimeouts());
 
     /* Escape the Parameters and add them to the end of the URL*/
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
     static FString AddParametersToUrl(FString InUrl, const TMap<FString, FString>& Parameters);
 
+    /**
+     * Builds a URL from a base, encoded path segments and encoded parameters.
+     * Unlike AddParametersToUrl, the parameters are appended to the base's query if it has one.
+     **/
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|URL", meta = (AutoCreateRefTerm = "PathSegments, Parameters"))
+    static FString BuildUrl(const FString& BaseUrl, const TArray<FString>& PathSegments, const TMap<FString, FString>& Parameters);
+
+    /* Splits an absolute URL into its parts. Returns false if it has no scheme or no host. */
+    UFUNCTION(BlueprintCallable, Category = "HTTP|URL")
+    static bool ParseUrl(const FString& Url, FHttpUrl& OutUrl);
+
+    /* Returns the decoded value of a query parameter of a parsed URL. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|URL")
+    static bool FindUrlQueryParameter(const FHttpUrl& Url, const FString& Name, FString& OutValue);
+
+    /* Returns the encoded URL. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|URL", meta = (DisplayName = "To String (URL)", CompactNodeTitle = "->", BlueprintAutocast))
+    static FString Conv_HttpUrlToString(const FHttpUrl& Url);
+
     /* Escape the following string to comply to URL specification. */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP, meta = (Keywords = "url escape encode string"))
     static FString UrlEncodeString(const FString& StringToEscape);
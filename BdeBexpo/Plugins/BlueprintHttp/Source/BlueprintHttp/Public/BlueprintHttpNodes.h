@@ -51,9 +51,14 @@ public:
      * @param Content           The request's content.
      * @param Headers           The request's headers.
      * @param SaveFileLocation  Where we want to save the download.
+     * @param Timeouts          The time limits of the request.
+     * @param IntegrityCheck    How the file is verified as it's received. Nothing is saved if it doesn't match.
+     * @param DeadlineBudget    The optional deadline shared with other requests.
+     * @param Profile           The optional client profile. FileUrl is then a path appended to its base URL.
     */
-    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Headers, UrlParameters", DisplayName = "Download File through HTTP"))
-    static UHttpDownloadFileProxy* HttpDownloadFile(const FString& FileUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers, const FString& SaveFileLocation);
+    UFUNCTION(BlueprintCallable, Category = HTTP, meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Headers, UrlParameters, Timeouts, IntegrityCheck", AdvancedDisplay = "Timeouts, IntegrityCheck, DeadlineBudget, Profile", DisplayName = "Download File through HTTP"))
+    static UHttpDownloadFileProxy* HttpDownloadFile(const FString& FileUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers, const FString& SaveFileLocation,
+        const FHttpRequestTimeouts& Timeouts, const FHttpIntegrityCheck& IntegrityCheck, UHttpDeadlineBudget* DeadlineBudget = nullptr, const FName Profile = NAME_None);
 
 private:
     UFUNCTION()
@@ -68,6 +73,10 @@ private:
         return ContentLength != 0 ? (Downloaded * 100.f / ContentLength) : 0.f;
     }
 
+public:
+    /* Returns the request downloading the file. */
+    FORCEINLINE UHttpRequest* GetHttpRequest() const { return Request; }
+
 private:
     UPROPERTY()
     UHttpRequest* Request;
@@ -107,6 +116,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = HTTP, meta = (BlueprintInternalUseOnly = "true", DisplayName="Send Initialized Http Request"))
     static UProcessHttpRequestProxy* InlineProcessRequest(UHttpRequest* const Request);
 
+    /* Returns the request processed by this node. */
+    FORCEINLINE UHttpRequest* GetHttpRequest() const { return RequestWrapper; }
+
 private:
     UFUNCTION()
     void OnCompleteInternal(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully);
@@ -131,6 +143,9 @@ public:
 
     virtual void Activate() override {};
 
+    /* Returns the request sent by this node. */
+    FORCEINLINE UHttpRequest* GetHttpRequest() const { return RequestWrapper; }
+
 protected:
     /* Request Events */
     virtual void OnTickInternal   ()                              {};
@@ -188,10 +203,13 @@ public:
      *   @param Verb           The verb we want to use for this request. (GET, HEAD, POST, ...)
      *   @param Content        This request's content.
      *   @param Headers        This request's headers.
+     *   @param Timeouts       The time limits of the request.
+     *   @param DeadlineBudget The optional deadline shared with other requests.
+     *   @param Profile        The optional client profile. ServerUrl is then a path appended to its base URL.
      **/
-    UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Headers, UrlParameters"),  Category = HTTP)
+    UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Headers, UrlParameters, Timeouts", AdvancedDisplay = "Timeouts, DeadlineBudget, Profile"),  Category = HTTP)
     static USendHttpRequestProxy* SendHttpRequest(const FString & ServerUrl, const TMap<FString, FString> & UrlParameters, const EHttpVerb Verb, 
-        const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers);
+        const EHttpMimeType MimeType, const FString& Content, const TMap<FString, FString>& Headers, const FHttpRequestTimeouts& Timeouts, UHttpDeadlineBudget* DeadlineBudget = nullptr, const FName Profile = NAME_None);
 
 protected:
     virtual void OnTickInternal();
@@ -230,9 +248,13 @@ public:
      *   @param Verb           The verb we want to use for this request. (GET, HEAD, POST, ...)
      *   @param Content        This request's content.
      *   @param Headers        This request's headers.
+     *   @param Timeouts       The time limits of the request.
+     *   @param DeadlineBudget The optional deadline shared with other requests.
+     *   @param Profile        The optional client profile. ServerUrl is then a path appended to its base URL.
      **/
-    UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Headers, UrlParameters, Content"), Category = HTTP)
-    static USendBinaryHttpRequestProxy* SendBinaryHttpRequest(const FString& ServerUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8>& Content, const TMap<FString, FString>& Headers);
+    UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Headers, UrlParameters, Content, Timeouts", AdvancedDisplay = "Timeouts, DeadlineBudget, Profile"), Category = HTTP)
+    static USendBinaryHttpRequestProxy* SendBinaryHttpRequest(const FString& ServerUrl, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb, const EHttpMimeType MimeType, const TArray<uint8>& Content, const TMap<FString, FString>& Headers,
+        const FHttpRequestTimeouts& Timeouts, UHttpDeadlineBudget* DeadlineBudget = nullptr, const FName Profile = NAME_None);
 
 protected:
     virtual void OnTickInternal() override;
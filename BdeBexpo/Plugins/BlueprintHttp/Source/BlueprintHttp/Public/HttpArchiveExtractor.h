@@ -0,0 +1,204 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "HAL/CriticalSection.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "HttpRequest.h"
+#include "HttpArchiveExtractor.generated.h"
+
+class UHttpRequest;
+class UHttpResponse;
+struct z_stream_s;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnArchiveEntryEvent, const FString&, EntryName, const int64, BytesWritten, const int64, EntrySize);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams  (FOnArchiveEvent,      const int32, EntriesExtracted, const int64, BytesWritten);
+
+/**
+ *  Extracts a zip, tar or tar.gz archive as it's written, without storing the archive.
+ *
+ *  The format is detected from the first bytes. Zip entries must be stored or deflated,
+ *  stored entries must have their sizes in their local header. Tar entries other than
+ *  files and directories are skipped.
+ *
+ *  Written by the HTTP thread when used as a response stream, read from the game thread.
+ **/
+class BLUEPRINTHTTP_API FHttpArchiveExtractor : public FArchive
+{
+public:
+	struct FEntryProgress
+	{
+		FString Name;
+		int64	BytesWritten = 0;
+
+		// -1 when the archive doesn't tell it upfront.
+		int64	Size = -1;
+
+		bool	bCompleted = false;
+	};
+
+	/**
+	 * @param InTargetDirectory	Where the entries are written.
+	 * @param InIncludeFilters	Wildcards of the entries to extract, such as "Images/*.png". All the entries are extracted when empty.
+	 **/
+	FHttpArchiveExtractor(const FString& InTargetDirectory, const TArray<FString>& InIncludeFilters);
+	virtual ~FHttpArchiveExtractor();
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Length) override;
+	virtual FString GetArchiveName() const override { return TEXT("FHttpArchiveExtractor"); }
+	//~ End FArchive Interface
+
+	/* Takes the progress of the entries since the last call. */
+	TArray<FEntryProgress> ConsumeProgress();
+
+	/* Returns if the whole archive was read without error. */
+	bool IsComplete() const;
+
+	/* Returns if any byte was written to the extractor. */
+	bool HasReceivedData() const;
+
+	FString GetError() const;
+
+	int32 GetEntriesExtracted() const;
+	int64 GetBytesWritten() const;
+
+private:
+	enum class EFormat : uint8
+	{
+		Unknown,
+		Zip,
+		Tar,
+		TarGz
+	};
+
+	enum class EState : uint8
+	{
+		ZipHeader,
+		ZipData,
+		ZipDescriptor,
+		TarHeader,
+		TarData,
+		TarPadding,
+		End,
+		Error
+	};
+
+	/* Parses the bytes of the archive, once decompressed for tar.gz. */
+	void Process(const uint8* Data, const int64 Length);
+
+	/* Each returns the bytes consumed from Data. Zero means more bytes are needed. */
+	int64 ProcessZipHeader	  (const uint8* Data, const int64 Length);
+	int64 ProcessZipData	  (const uint8* Data, const int64 Length);
+	int64 ProcessZipDescriptor(const uint8* Data, const int64 Length);
+	int64 ProcessTarHeader	  (const uint8* Data, const int64 Length);
+	int64 ProcessTarData	  (const uint8* Data, const int64 Length);
+
+	void BeginEntry(const FString& Name, const int64 Size, const bool bDirectory);
+	void WriteEntry(const uint8* Data, const int64 Length);
+	void EndEntry(const uint32 ExpectedCrc, const bool bCheckCrc);
+
+	void Fail(const FString& Reason);
+
+	bool ShouldExtract(const FString& Name) const;
+
+	mutable FCriticalSection Lock;
+
+	FString TargetDirectory;
+	TArray<FString> IncludeFilters;
+
+	EFormat Format;
+	EState	State;
+	FString Error;
+
+	// Bytes received before the format is known, and bytes of the archive not parsed yet.
+	TArray<uint8> Pending;
+
+	// Inflates the deflated zip entries and the gzip layer of tar.gz archives.
+	z_stream_s* EntryStream;
+	z_stream_s* GzipStream;
+	TArray<uint8> InflateBuffer;
+
+	// The entry being read.
+	FString EntryName;
+	TUniquePtr<FArchive> EntryWriter;
+	int64  EntrySize;
+	int64  EntryWritten;
+	int64  EntryRemaining;
+	uint32 EntryCrc;
+	uint32 ZipExpectedCrc;
+	uint16 ZipMethod;
+	uint16 ZipFlags;
+	bool   bZip64;
+
+	// Tar metadata entries apply to the next entry.
+	bool   bTarMetadata;
+	uint8  TarTypeFlag;
+	int64  TarPadding;
+	FString TarNextName;
+	TArray<uint8> TarMetadata;
+
+	TArray<FEntryProgress> Progress;
+
+	int32 EntriesExtracted;
+	int64 BytesWritten;
+	bool  bReceivedData;
+};
+
+/**
+ *	Downloads an archive and extracts it while it's received.
+ **/
+UCLASS()
+class BLUEPRINTHTTP_API UHttpExtractArchiveProxy final : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	/* Called while an entry is written. */
+	UPROPERTY(BlueprintAssignable)
+	FOnArchiveEntryEvent OnEntryProgress;
+
+	/* Called once an entry was fully written. */
+	UPROPERTY(BlueprintAssignable)
+	FOnArchiveEntryEvent OnEntryExtracted;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnArchiveEvent OnExtracted;
+
+	/* Called when the download or the extraction failed. The entries already extracted are kept. */
+	UPROPERTY(BlueprintAssignable)
+	FOnArchiveEvent OnFailed;
+
+	virtual void Activate() override;
+
+	/**
+	 * Downloads a zip, tar or tar.gz archive and writes its entries to a directory as they are received.
+	 * @param Url				The URL of the archive.
+	 * @param Headers			The request's headers.
+	 * @param TargetDirectory	Where the entries are written.
+	 * @param IncludeFilters	Wildcards of the entries to extract, such as "Images/*.png". All the entries are extracted when empty.
+	 * @param Timeouts			The time limits of the request.
+	 * @param Profile			The optional client profile. Url is then a path appended to its base URL.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = HTTP, meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Headers, IncludeFilters, Timeouts", AdvancedDisplay = "Timeouts, Profile", DisplayName = "Download and Extract Archive through HTTP"))
+	static UHttpExtractArchiveProxy* HttpDownloadArchive(const FString& Url, const TMap<FString, FString>& Headers, const FString& TargetDirectory, const TArray<FString>& IncludeFilters,
+		const FHttpRequestTimeouts& Timeouts, const FName Profile = NAME_None);
+
+	FORCEINLINE UHttpRequest* GetHttpRequest() const { return Request; }
+
+private:
+	UFUNCTION()
+	void OnRequestCompleted(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	UFUNCTION()
+	void OnRequestProgress(UHttpRequest* const InRequest, const int32 BytesSent, const int32 BytesReceived);
+
+	/* Broadcasts the progress of the entries. */
+	void FlushProgress();
+
+	UPROPERTY()
+	UHttpRequest* Request;
+
+	TSharedPtr<FHttpArchiveExtractor, ESPMode::ThreadSafe> Extractor;
+};
@@ -0,0 +1,137 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+/**
+ *  Base64 with the standard alphabet, vectorized for large payloads.
+ *
+ *  Uses SSSE3 on x64 and NEON on ARM64, and a scalar loop elsewhere and for the tails.
+ *  The output matches FBase64: encoded text is padded, decoding accepts padded and
+ *  unpadded text and fails on any character outside of the alphabet.
+ *  The vector kernels can be disabled with http.Base64.Vectorized 0.
+ **/
+class BLUEPRINTHTTP_API FHttpBase64
+{
+public:
+	/* Returns the length of the padded text encoding Size bytes. */
+	static int64 GetEncodedLength(const int64 Size);
+
+	/* Returns the maximum number of bytes Length characters decode to. */
+	static int64 GetMaxDecodedSize(const int64 Length);
+
+	/**
+	 * Encodes into preallocated text of at least GetEncodedLength(Size) characters. Doesn't null-terminate.
+	 * @return The number of characters written.
+	 **/
+	static int64 Encode(const uint8* const Source, const int64 Size, ANSICHAR* const Dest);
+	static int64 Encode(const uint8* const Source, const int64 Size, TCHAR* const Dest);
+
+	/**
+	 * Decodes into a preallocated buffer of at least GetMaxDecodedSize(Length) bytes.
+	 * @param OutSize	The number of bytes written.
+	 * @return False if the text isn't valid Base64.
+	 **/
+	static bool Decode(const ANSICHAR* const Source, const int64 Length, uint8* const Dest, int64& OutSize);
+	static bool Decode(const TCHAR* const Source, const int64 Length, uint8* const Dest, int64& OutSize);
+
+	static FString Encode(TArrayView<const uint8> Data);
+	static void Encode(TArrayView<const uint8> Data, FString& OutText);
+
+	static bool Decode(const FString& Text, TArray<uint8>& OutData);
+
+	/* Returns the name of the kernel in use: "SSSE3", "NEON" or "Scalar". */
+	static const TCHAR* GetKernelName();
+};
+
+/**
+ *  Encodes a stream of bytes to Base64 chunk by chunk.
+ *  The bytes that don't fill a group of three are kept for the next chunk.
+ **/
+class BLUEPRINTHTTP_API FHttpBase64Encoder
+{
+public:
+	/* Appends the text of the complete groups to Out. */
+	void Update(const uint8* Data, int64 Size, TArray<ANSICHAR>& Out);
+
+	/* Appends the padded last group to Out. The encoder can be reused afterwards. */
+	void Finalize(TArray<ANSICHAR>& Out);
+
+private:
+	uint8 Pending[3] = {};
+	int32 NumPending = 0;
+};
+
+/**
+ *  Decodes a stream of Base64 text chunk by chunk.
+ *  Line breaks and spaces are skipped so MIME-wrapped text can be decoded.
+ **/
+class BLUEPRINTHTTP_API FHttpBase64Decoder
+{
+public:
+	/* Appends the bytes of the complete groups to Out. Returns false once the text was invalid. */
+	bool Update(const ANSICHAR* Chunk, int64 Length, TArray<uint8>& Out);
+
+	/* Appends the bytes of the last group to Out. Returns false if the text was invalid. The decoder can be reused afterwards. */
+	bool Finalize(TArray<uint8>& Out);
+
+	bool HasError() const { return bError; }
+
+private:
+	TArray<ANSICHAR> Text;
+
+	// Set once padding was read, nothing but padding can follow.
+	bool bPadded = false;
+	bool bError	 = false;
+};
+
+/**
+ *  Archive encoding or decoding what is written to it and writing the result to another archive.
+ *
+ *  Used as the response stream of a request, it decodes a Base64 response as it arrives
+ *  without keeping the text. Written to from the content of a response body, it encodes it
+ *  without building the whole text first.
+ **/
+class BLUEPRINTHTTP_API FHttpBase64Stream : public FArchive
+{
+public:
+	enum class EMode : uint8
+	{
+		Encode,
+		Decode
+	};
+
+	/* @param InInner	Receives the result. */
+	FHttpBase64Stream(const EMode InMode, const TSharedRef<FArchive, ESPMode::ThreadSafe>& InInner);
+	virtual ~FHttpBase64Stream();
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Length) override;
+	virtual bool Close() override;
+	virtual FString GetArchiveName() const override { return TEXT("FHttpBase64Stream"); }
+	//~ End FArchive Interface
+
+	/* Writes the last group. Called by Close(). Returns false if the decoded text was invalid. */
+	bool Finalize();
+
+	/* Returns the number of bytes written to the inner archive. */
+	int64 GetBytesWritten() const { return BytesWritten; }
+
+private:
+	void Flush();
+
+	TSharedRef<FArchive, ESPMode::ThreadSafe> Inner;
+
+	FHttpBase64Encoder Encoder;
+	FHttpBase64Decoder Decoder;
+
+	TArray<ANSICHAR> EncodedChunk;
+	TArray<uint8>	 DecodedChunk;
+
+	int64 BytesWritten;
+
+	EMode Mode;
+	bool  bFinalized;
+};
@@ -0,0 +1,75 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class UHttpRequest;
+class UBlueprintAsyncActionBase;
+class UWorld;
+
+/**
+ *  Cancels groups of requests with one call.
+ *
+ *  Requests, and the HTTP nodes running them, are bound to an owner object or to a named
+ *  scope. They are cancelled when the scope is cancelled, when their owner is destroyed
+ *  or when the world of their owner is cleaned up. Queued requests are removed from the
+ *  queue without being sent.
+ *
+ *  By default cancelled requests don't broadcast anything: their delegates are cleared
+ *  first so that objects going away aren't called back.
+ **/
+class BLUEPRINTHTTP_API FHttpCancellation
+{
+public:
+	/**
+	 * Cancels the request when Owner is destroyed.
+	 * @param Node	The HTTP node running the request, if any. It is released when the request is cancelled.
+	 **/
+	static void BindToOwner(UHttpRequest* const Request, UObject* const Owner, UBlueprintAsyncActionBase* const Node = nullptr);
+
+	/* Cancels the request when the scope is cancelled. */
+	static void BindToScope(UHttpRequest* const Request, const FName Scope, UBlueprintAsyncActionBase* const Node = nullptr);
+
+	/**
+	 * Cancels the requests bound to the scope.
+	 * @param bNotifyListeners	If the requests broadcast their failed completion.
+	 * @return The number of requests cancelled.
+	 **/
+	static int32 CancelScope(const FName Scope, const bool bNotifyListeners = false);
+
+	/* Cancels the requests bound to the owner. Returns the number of requests cancelled. */
+	static int32 CancelOwner(const UObject* const Owner, const bool bNotifyListeners = false);
+
+	/* Returns the HTTP request run by one of the plugin's nodes, or nullptr. */
+	static UHttpRequest* GetNodeRequest(const UBlueprintAsyncActionBase* const Node);
+
+	static void Startup();
+	static void Shutdown();
+
+private:
+	struct FBinding
+	{
+		TWeakObjectPtr<UHttpRequest> Request;
+		TWeakObjectPtr<UBlueprintAsyncActionBase> Node;
+		TWeakObjectPtr<UObject> Owner;
+		FName Scope;
+	};
+
+	template<typename PredicateType>
+	static int32 CancelIf(PredicateType&& Predicate, const bool bNotifyListeners);
+
+	static void Cancel(const FBinding& Binding, const bool bNotifyListeners);
+
+	static void StartTicker();
+
+	static bool Tick(float DeltaTime);
+
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	static TArray<FBinding> Bindings;
+
+	static FTSTicker::FDelegateHandle TickerHandle;
+	static FDelegateHandle WorldCleanupHandle;
+};
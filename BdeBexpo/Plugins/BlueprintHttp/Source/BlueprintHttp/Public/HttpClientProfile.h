@@ -0,0 +1,78 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRequest.h"
+#include "HttpClientProfile.generated.h"
+
+/**
+ *  Settings shared by the requests sent to one API.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpClientProfile
+{
+	GENERATED_BODY()
+public:
+	/* URL the paths of the requests are appended to, such as "https://api.example.com/v1". */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Profile")
+	FString BaseUrl;
+
+	/* Headers set on each request. A Content-Type header here replaces the MIME type of the request. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Profile")
+	TMap<FString, FString> Headers;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Profile")
+	FHttpRequestTimeouts Timeouts;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Profile")
+	FHttpRetryPolicy RetryPolicy;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Profile")
+	EHttpRequestPriority Priority = EHttpRequestPriority::Normal;
+};
+
+/**
+ *  Named client profiles, to configure the requests sent to an API in one place instead of
+ *  on each node and without affecting the other requests of the process.
+ *
+ *  Profiles are prepared when registered: header names and values are trimmed and deduplicated
+ *  once, so applying a profile to a request only sets prepared values.
+ *  Profiles are registered and applied on the game thread.
+ **/
+class BLUEPRINTHTTP_API FHttpClientProfiles
+{
+public:
+	/* Adds or replaces a profile. Requests already created keep the settings they had. */
+	static void Register(const FName ProfileName, const FHttpClientProfile& Profile);
+
+	/* Removes a profile. Returns false if it doesn't exist. */
+	static bool Unregister(const FName ProfileName);
+
+	/* Returns if the profile is registered. */
+	static bool Contains(const FName ProfileName);
+
+	/* Copies a registered profile. Returns false if it doesn't exist. */
+	static bool Find(const FName ProfileName, FHttpClientProfile& OutProfile);
+
+	/* Returns the names of the registered profiles. */
+	static TArray<FName> GetProfileNames();
+
+	/**
+	 * Returns the URL of Path for the profile: Path is appended to its base URL unless it's absolute.
+	 * The parameters are encoded and added to the query. The URL is returned as-is for an unknown profile.
+	 **/
+	static FString ResolveUrl(const FName ProfileName, const FString& Path, const TMap<FString, FString>& UrlParameters);
+
+	/* Returns the prepared headers of the profile, empty for an unknown profile. */
+	static TMap<FString, FString> GetHeaders(const FName ProfileName);
+
+	/**
+	 * Sets the URL, headers, timeouts, retry policy and priority of the profile on the request.
+	 * @return False if the profile doesn't exist, the URL is still set.
+	 **/
+	static bool Apply(const FName ProfileName, UHttpRequest* const Request, const FString& Path, const TMap<FString, FString>& UrlParameters);
+
+	/* Creates a request with the settings of the profile. */
+	static UHttpRequest* CreateRequest(const FName ProfileName, const FString& Path, const TMap<FString, FString>& UrlParameters, const EHttpVerb Verb);
+};
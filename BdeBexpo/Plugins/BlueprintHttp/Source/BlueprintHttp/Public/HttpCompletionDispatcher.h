@@ -0,0 +1,38 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UHttpRequest;
+class UHttpResponse;
+
+/**
+ *  Delivers request completions on the game thread within a per-frame time budget.
+ *
+ *  Completions are broadcast right away while the frame's budget lasts. Once it is
+ *  spent, they are queued and delivered on the next frames, Interactive requests first,
+ *  then Normal and Background ones in completion order. Interactive requests ignore the
+ *  budget, and at least one completion is delivered each frame.
+ *
+ *  The backlog is shown with "stat BlueprintHttp".
+ **/
+class BLUEPRINTHTTP_API FHttpCompletionDispatcher
+{
+public:
+	/* Broadcasts the completion of the request now or once there is budget left. */
+	static void Dispatch(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	/* Sets the time completions can take each frame, in seconds. Zero or less removes the budget. */
+	static void SetFrameBudget(const float Seconds);
+	static float GetFrameBudget();
+
+	/* Returns the number of completions waiting to be delivered. */
+	static int32 GetBacklog();
+
+	/* Delivers all the queued completions now. */
+	static void Flush();
+
+	/* Delivers the queued completions and stops the dispatcher. */
+	static void Reset();
+};
@@ -0,0 +1,64 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpConnectionWarmer.generated.h"
+
+/**
+ *  Time to first byte measured for a host, in seconds.
+ *  Requests sent while the host was warm are measured apart to show the gain.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpFirstByteStats
+{
+	GENERATED_BODY()
+public:
+	/* Time to first byte of the last request. */
+	UPROPERTY(BlueprintReadOnly, Category = HTTP, meta = (Units = "s"))
+	float Last = 0.f;
+
+	/* Average time to first byte of the requests sent without a warm connection. */
+	UPROPERTY(BlueprintReadOnly, Category = HTTP, meta = (Units = "s"))
+	float AverageCold = 0.f;
+
+	/* Average time to first byte of the requests sent while the host was warm. */
+	UPROPERTY(BlueprintReadOnly, Category = HTTP, meta = (Units = "s"))
+	float AverageWarm = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = HTTP)
+	int32 ColdSamples = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = HTTP)
+	int32 WarmSamples = 0;
+};
+
+/**
+ *  Pays for DNS, TCP and TLS handshakes before the requests need them.
+ *
+ *  A HEAD request resolves the host and opens a connection that the HTTP module keeps alive
+ *  for the next requests, which then skip the DNS lookup and the handshakes.
+ *  The connection is kept warm by sending a HEAD again while the host must stay warm.
+ **/
+class BLUEPRINTHTTP_API FHttpConnectionWarmer
+{
+public:
+	/**
+	 * Connects to the hosts.
+	 * @param Hosts				Host names or URLs. Host names are reached with HTTPS.
+	 * @param KeepWarmDuration	How long the connections are kept alive, in seconds.
+	 **/
+	static void Prewarm(const TArray<FString>& Hosts, const float KeepWarmDuration);
+
+	/* Returns if a warm connection to the host should be available. */
+	static bool IsWarm(const FString& Host);
+
+	/* Records the time to first byte of a request to the host. */
+	static void ReportFirstByte(const FString& Host, const float Seconds);
+
+	/* Returns the time to first byte measured for the host. */
+	static FHttpFirstByteStats GetFirstByteStats(const FString& Host);
+
+	/* Stops keeping the connections warm and forgets the measures. */
+	static void Reset();
+};
@@ -0,0 +1,104 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+#include "Hash/xxhash.h"
+#include "HttpContentHash.generated.h"
+
+/**
+ *	Hash used to verify the content of a response.
+ **/
+UENUM(BlueprintType)
+enum class EHttpHashAlgorithm : uint8
+{
+	None		UMETA(ToolTip = "The content isn't verified."),
+	SHA1		UMETA(DisplayName = "SHA-1"),
+	SHA256		UMETA(DisplayName = "SHA-256"),
+	XxHash64	UMETA(DisplayName = "xxHash64"),
+	CRC32		UMETA(DisplayName = "CRC32")
+};
+
+/**
+ *	Verification of the response content, hashed as the bytes arrive.
+ *	A response that doesn't match fails with the Failed: Integrity Check status.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpIntegrityCheck
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	EHttpHashAlgorithm Algorithm = EHttpHashAlgorithm::None;
+
+	/* The expected digest, in hexadecimal or Base64. Takes precedence over DigestHeader. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	FString ExpectedDigest;
+
+	/**
+	 * Response header holding the expected digest when ExpectedDigest is empty, such as "X-Checksum-SHA256".
+	 * The "Digest" and "Repr-Digest" formats, like "sha-256=<Base64>", are understood.
+	 **/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	FString DigestHeader;
+
+	bool IsEnabled() const { return Algorithm != EHttpHashAlgorithm::None && (!ExpectedDigest.IsEmpty() || !DigestHeader.IsEmpty()); }
+};
+
+/**
+ *  SHA-256 computed incrementally.
+ **/
+struct BLUEPRINTHTTP_API FHttpSha256
+{
+	static constexpr int32 DigestSize = 32;
+
+	FHttpSha256();
+
+	void Update(const uint8* Data, int64 Length);
+
+	void Final(uint8 OutDigest[DigestSize]);
+
+private:
+	void Transform(const uint8* Block);
+
+	uint32 State[8];
+	uint8  Buffer[64];
+	uint64 TotalLength;
+	int32  BufferLength;
+};
+
+/**
+ *  Hash of one of the supported algorithms, fed as the data arrives.
+ *  Digests are in big-endian byte order, as they are printed.
+ **/
+class BLUEPRINTHTTP_API FHttpStreamingHash
+{
+public:
+	explicit FHttpStreamingHash(const EHttpHashAlgorithm InAlgorithm);
+
+	void Update(const uint8* Data, const int64 Length);
+
+	/* Returns the digest. The hash can't be updated afterwards. */
+	TArray<uint8> Finalize();
+
+	EHttpHashAlgorithm GetAlgorithm() const { return Algorithm; }
+
+	/* Returns the size of the digests of an algorithm in bytes. */
+	static int32 GetDigestSize(const EHttpHashAlgorithm Algorithm);
+
+	/**
+	 * Reads a digest written in hexadecimal, in Base64 or in the "algorithm=<Base64>" format
+	 * of the Digest headers, which can list several digests.
+	 * @return False if no digest of the algorithm's size could be read.
+	 **/
+	static bool ParseDigest(const FString& Value, const EHttpHashAlgorithm Algorithm, TArray<uint8>& OutDigest);
+
+private:
+	EHttpHashAlgorithm Algorithm;
+
+	FSHA1			 Sha1;
+	FHttpSha256		 Sha256;
+	FXxHash64Builder XxHash64;
+	uint32			 Crc32;
+};
@@ -0,0 +1,172 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "HttpContentHash.h"
+#include "HttpContentSyncSubsystem.generated.h"
+
+class UHttpRequest;
+class UHttpResponse;
+class UHttpDownloadFileProxy;
+class UHttpContentSyncSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams (FOnContentSyncProgress,  const int32, FilesUpdated, const int32, FilesToUpdate, const int64, BytesDownloaded, const int64, BytesToDownload);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnContentSyncCompleted, const bool, bSucceeded, const int32, FilesUpdated, const int64, BytesDownloaded);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam   (FOnContentFileUpdated,   const FString&, Path);
+
+/**
+ *  Listens to the download of a single synced file and keeps its proxy alive.
+ **/
+UCLASS(Transient)
+class UHttpContentSyncDownload final : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION()
+	void OnFileDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UFUNCTION()
+	void OnFileDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UFUNCTION()
+	void OnDownloadProgress(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UPROPERTY()
+	UHttpDownloadFileProxy* Proxy;
+
+	UPROPERTY()
+	UHttpContentSyncSubsystem* Owner;
+
+	/* Index of the file in the manifest. */
+	int32 FileIndex;
+
+	int64 BytesReceived;
+};
+
+/**
+ *  Keeps a content directory in sync with a manifest served over HTTP.
+ *
+ *  The manifest is a JSON document listing the files with their size and hash:
+ *
+ *	{
+ *		"hashAlgorithm": "sha1",						// "sha1", "sha256", "xxh64" or "crc32", "sha1" by default.
+ *		"baseUrl": "https://cdn.example.com/expo/",		// Optional, the manifest's directory by default.
+ *		"files": [
+ *			{ "path": "Maps/Hall1.png", "size": 48213, "hash": "9f2c...", "url": "optional absolute URL" }
+ *		]
+ *	}
+ *
+ *  It's compared with the index of the last sync and only the files that changed are
+ *  downloaded, in parallel. Each file is verified as it's received, written next to its
+ *  destination, then moved over the previous version.
+ *  The manifest is requested with the ETag of the last sync so an unchanged manifest
+ *  costs a 304 response. The files of the index are then checked on disk by size and
+ *  the full manifest is requested again if any is missing or modified.
+ **/
+UCLASS()
+class BLUEPRINTHTTP_API UHttpContentSyncSubsystem final : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+public:
+	UHttpContentSyncSubsystem();
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/**
+	 * Syncs the content directory with the manifest.
+	 * @param ManifestUrl				The URL of the manifest.
+	 * @param ContentDirectory			The directory to sync, relative to the persistent download directory.
+	 * @param MaxConcurrentDownloads	How many files are downloaded at the same time.
+	 * @param bDeleteRemovedFiles		If files that were removed from the manifest are deleted.
+	 * @return False if a sync is already running.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Content Sync")
+	bool StartSync(const FString& ManifestUrl, const FString& ContentDirectory, const int32 MaxConcurrentDownloads = 4, const bool bDeleteRemovedFiles = true);
+
+	/* Stops the running sync. The files already verified are kept. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Content Sync")
+	void CancelSync();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Content Sync")
+	bool IsSyncing() const;
+
+	/* Returns the absolute path of a synced file. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Content Sync")
+	FString GetContentPath(const FString& RelativePath) const;
+
+	/* Called each time a file was updated. */
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Content Sync")
+	FOnContentSyncProgress OnSyncProgress;
+
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Content Sync")
+	FOnContentSyncCompleted OnSyncCompleted;
+
+	/* Called with the relative path of each updated file. */
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Content Sync")
+	FOnContentFileUpdated OnFileUpdated;
+
+	void OnDownloadFinished(UHttpContentSyncDownload* const Download, const bool bSucceeded);
+	void OnDownloadProgress(UHttpContentSyncDownload* const Download);
+
+private:
+	struct FContentFile
+	{
+		FString Path;
+		FString Url;
+		FString Hash;
+		int64	Size = 0;
+	};
+
+	UFUNCTION()
+	void OnManifestReceived(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	bool RequestManifest();
+
+	bool ParseManifest(const FString& Json);
+
+	/* Checks the size of the indexed files on disk and removes the ones that don't match from the index. */
+	bool VerifyIndexedFiles();
+
+	void LoadIndex();
+	void SaveIndex() const;
+
+	void PumpDownloads();
+
+	void Finish(const bool bSucceeded);
+
+	FString GetIndexPath() const;
+
+	UPROPERTY()
+	UHttpRequest* ManifestRequest;
+
+	UPROPERTY()
+	TArray<UHttpContentSyncDownload*> ActiveDownloads;
+
+	FString ManifestUrl;
+	FString ContentRoot;
+	FString ManifestETag;
+
+	TArray<FContentFile> ManifestFiles;
+
+	/* Files of the last sync, by path. */
+	TMap<FString, FContentFile> Index;
+
+	/* Manifest indices of the files to download. */
+	TArray<int32> PendingFiles;
+	int32 NextPendingFile;
+
+	int32 FilesUpdated;
+	int64 BytesToDownload;
+	int64 BytesDownloaded;
+
+	int32 MaxConcurrentDownloads;
+	bool  bDeleteRemovedFiles;
+	bool  bSyncing;
+	bool  bAnyFailure;
+
+	EHttpHashAlgorithm HashAlgorithm;
+};
@@ -0,0 +1,44 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpDeadlineBudget.generated.h"
+
+/**
+ *  A deadline shared by a chain of dependent requests.
+ *
+ *  The clock starts when the first request of the budget is processed. Every request
+ *  of the budget must complete before the deadline: requests still running are then
+ *  cancelled, and requests processed afterwards fail right away without being sent.
+ **/
+UCLASS(BlueprintType)
+class BLUEPRINTHTTP_API UHttpDeadlineBudget : public UObject
+{
+	GENERATED_BODY()
+public:
+	UHttpDeadlineBudget();
+
+	/* Creates a budget of the specified duration, in seconds. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	static UPARAM(DisplayName = "Budget") UHttpDeadlineBudget* CreateDeadlineBudget(const float Seconds);
+
+	/* Returns the time left before the deadline, or the whole budget if it hasn't started yet. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Seconds") float GetRemainingTime() const;
+
+	/* Returns if the deadline is reached. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Expired") bool IsExpired() const;
+
+	/* Starts the clock if it isn't running yet. Called when a request of the budget is processed. */
+	void Start();
+
+	/* Returns the time of the deadline, or zero if the clock hasn't started. */
+	FORCEINLINE double GetDeadline() const { return Deadline; }
+
+private:
+	float Duration;
+
+	double Deadline;
+};
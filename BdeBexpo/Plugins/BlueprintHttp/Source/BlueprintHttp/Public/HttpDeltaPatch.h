@@ -0,0 +1,112 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "HttpContentHash.h"
+#include "HttpDeltaPatch.generated.h"
+
+class UHttpDownloadFileProxy;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFilePatchEvent, const bool, bPatched, const int64, BytesDownloaded);
+
+/**
+ *  Applies binary delta patches.
+ *
+ *  Patches are made with the bsdiff algorithm in a format of this plugin: the "BHTTPDIFF1" magic,
+ *  the size of the new file, then the control, diff and extra blocks of bsdiff 4.3 interleaved in
+ *  a single zlib stream. Standard bsdiff patches compress with bzip2, which the engine doesn't ship,
+ *  so patches are made with Create() or the http.DeltaPatch.Create console command.
+ *
+ *  The patch and the new file are streamed, only the seeks in the old file are random.
+ **/
+class BLUEPRINTHTTP_API FHttpDeltaPatch
+{
+public:
+	/**
+	 * Applies a patch to OldFilename, writing the result to NewFilename.
+	 * @param Hash	Fed with the new file as it's written so it can be verified without reading it again. Can be null.
+	 * @return False with OutError set if the patch is invalid or a file can't be accessed.
+	 **/
+	static bool Apply(const FString& OldFilename, const FString& PatchFilename, const FString& NewFilename, FHttpStreamingHash* const Hash, FString& OutError);
+
+	/**
+	 * Makes the patch from OldFilename to NewFilename. Both files are loaded and the old one is suffix sorted,
+	 * which takes 17 times its size in memory: it's meant for build machines.
+	 * @return False with OutError set if a file can't be accessed.
+	 **/
+	static bool Create(const FString& OldFilename, const FString& NewFilename, const FString& PatchFilename, FString& OutError);
+};
+
+/**
+ *	Updates a local file with a delta patch, or downloads it again when no patch applies.
+ **/
+UCLASS()
+class BLUEPRINTHTTP_API UHttpPatchFileProxy final : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	/* Called with the bytes downloaded so far, bPatched is true while the patch is downloaded. */
+	UPROPERTY(BlueprintAssignable)
+	FOnFilePatchEvent OnProgress;
+
+	/* Called once the file was replaced by its verified new version. */
+	UPROPERTY(BlueprintAssignable)
+	FOnFilePatchEvent OnUpdated;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnFilePatchEvent OnFailed;
+
+	virtual void Activate() override;
+
+	/**
+	 * Updates a file with a delta patch, applied on a worker thread.
+	 * The full file is downloaded when there is no local file, no patch, no expected hash or when the patched file doesn't match the hash.
+	 * @param PatchUrl		The patch from the local version to the new one. Can be empty.
+	 * @param FileUrl		The full new version.
+	 * @param LocalFile		The file to update.
+	 * @param HashAlgorithm	The hash of ExpectedHash.
+	 * @param ExpectedHash	The digest of the new version, in hexadecimal or Base64.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = HTTP, meta = (BlueprintInternalUseOnly = "true", DisplayName = "Update File through HTTP"))
+	static UHttpPatchFileProxy* HttpUpdateFile(const FString& PatchUrl, const FString& FileUrl, const FString& LocalFile, const EHttpHashAlgorithm HashAlgorithm, const FString& ExpectedHash);
+
+private:
+	UFUNCTION()
+	void OnPatchDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UFUNCTION()
+	void OnPatchDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UFUNCTION()
+	void OnFileDownloaded(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UFUNCTION()
+	void OnFileDownloadError(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	UFUNCTION()
+	void OnDownloadProgress(const int32 TotalSizeInBytes, const int32 TotalBytesReceived, const float PercentDownloaded);
+
+	void DownloadPatch();
+	void DownloadFile();
+
+	void OnPatchApplied(const bool bValid, const FString& Error);
+
+	void Complete(const bool bSucceeded);
+
+	UPROPERTY()
+	UHttpDownloadFileProxy* Download;
+
+	FString PatchUrl;
+	FString FileUrl;
+	FString LocalFile;
+	FString ExpectedHash;
+
+	EHttpHashAlgorithm HashAlgorithm;
+
+	// Bytes of the downloads that completed.
+	int64 BytesDownloaded;
+
+	bool bPatching;
+};
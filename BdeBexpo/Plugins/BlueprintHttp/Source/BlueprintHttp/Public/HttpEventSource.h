@@ -0,0 +1,222 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/Ticker.h"
+#include "HttpEventSource.generated.h"
+
+class UHttpRequest;
+class UHttpResponse;
+class UHttpEventSource;
+
+/**
+ *  An event received from a Server-Sent Events stream.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpServerSentEvent
+{
+	GENERATED_BODY()
+public:
+	/* The type of the event, "message" when the server didn't give one. */
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|Server-Sent Events")
+	FString Type;
+
+	/* The data lines of the event, joined with line feeds. */
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|Server-Sent Events")
+	FString Data;
+
+	/* The last event ID received, sent back to the server when reconnecting. */
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|Server-Sent Events")
+	FString Id;
+};
+
+UENUM(BlueprintType)
+enum class EHttpEventSourceState : uint8
+{
+	Closed		UMETA(ToolTip = "Not connected and not reconnecting."),
+	Connecting	UMETA(ToolTip = "Connecting or waiting to reconnect."),
+	Open		UMETA(ToolTip = "The server accepted the stream and events are received.")
+};
+
+/**
+ *  Parses a text/event-stream as it's written.
+ *
+ *  Written by the HTTP thread when used as a response stream, read from the game thread.
+ **/
+class BLUEPRINTHTTP_API FHttpEventStreamParser : public FArchive
+{
+public:
+	/* @param InLastEventId	The ID of the last event received before, kept until the server sends another. */
+	explicit FHttpEventStreamParser(const FString& InLastEventId = FString());
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Length) override;
+	virtual FString GetArchiveName() const override { return TEXT("FHttpEventStreamParser"); }
+	//~ End FArchive Interface
+
+	/* Takes the events completed since the last call. */
+	TArray<FHttpServerSentEvent> ConsumeEvents();
+
+	FString GetLastEventId() const;
+
+	/* Returns the reconnection time the server asked for in milliseconds, or -1. */
+	int64 GetRetryMilliseconds() const;
+
+	/* Returns if any byte was written to the parser. */
+	bool HasReceivedData() const;
+
+private:
+	void ProcessLine(const uint8* Line, int32 Length);
+	void DispatchEvent();
+
+	mutable FCriticalSection Lock;
+
+	// The bytes of a line split between two writes.
+	TArray<uint8> PartialLine;
+
+	// Set when a write ended with a CR, whose LF may start the next one.
+	bool bSkipLineFeed;
+	bool bStreamStarted;
+	bool bReceivedData;
+
+	// The event being read.
+	FString EventType;
+	FString EventData;
+	FString EventIdBuffer;
+
+	FString LastEventId;
+	int64	RetryMilliseconds;
+
+	TArray<FHttpServerSentEvent> Events;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam	 (FOnEventSourceOpen,  UHttpEventSource* const, Source);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams (FOnEventSourceEvent, UHttpEventSource* const, Source, const FHttpServerSentEvent&, Event);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnEventSourceError, UHttpEventSource* const, Source, const int32, ResponseCode, const bool, bWillReconnect);
+
+/**
+ *  Server-Sent Events client: keeps one streaming response open and broadcasts each event as it arrives,
+ *  so pushed updates replace polling.
+ *
+ *  Lost streams are reconnected with the Last-Event-ID header, after the delay the server asked for with
+ *  retry:, doubled after each failed attempt. Events are delivered on the game thread the frame they're received.
+ *  The engine closes connections that stay silent longer than its activity timeout, so servers should send a
+ *  comment line regularly. Keep a reference to the event source, it's closed when collected.
+ **/
+UCLASS(BlueprintType)
+class BLUEPRINTHTTP_API UHttpEventSource : public UObject
+{
+	GENERATED_BODY()
+public:
+	UHttpEventSource();
+
+	/**
+	 * Creates an event source. Bind its events then call Connect().
+	 * @param Url		The URL of the stream.
+	 * @param Headers	Headers sent with each connection.
+	 * @param Profile	The optional client profile. Url is then a path appended to its base URL.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Server-Sent Events", meta = (AutoCreateRefTerm = "Headers", AdvancedDisplay = "Profile"))
+	static UPARAM(DisplayName = "Event Source") UHttpEventSource* CreateEventSource(const FString& Url, const TMap<FString, FString>& Headers, const FName Profile = NAME_None);
+
+	/**
+	 * Opens the stream, closing the current one first.
+	 * @return False if the request couldn't be started.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Server-Sent Events")
+	bool Connect();
+
+	/* Closes the stream and stops reconnecting. No event is broadcast afterwards. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Server-Sent Events")
+	void Close();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Server-Sent Events")
+	UPARAM(DisplayName = "State") EHttpEventSourceState GetState() const;
+
+	/* Returns the ID of the last event received, sent as Last-Event-ID when reconnecting. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Server-Sent Events")
+	UPARAM(DisplayName = "Event ID") FString GetLastEventId() const;
+
+	/* Sets the ID sent with the next connection, to resume a stream received in an earlier session. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Server-Sent Events")
+	void SetLastEventId(const FString& EventId);
+
+	/* Returns the request of the current connection, if any. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Server-Sent Events")
+	UPARAM(DisplayName = "Request") UHttpRequest* GetHttpRequest() const;
+
+	/* Called when the server accepted the stream. */
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Server-Sent Events")
+	FOnEventSourceOpen OnOpen;
+
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Server-Sent Events")
+	FOnEventSourceEvent OnEvent;
+
+	/**
+	 * Called when the stream was lost or refused. The response code is zero for connection errors.
+	 * Streams are reconnected after connection errors, 408, 429 and 5xx responses and streams the server ended.
+	 **/
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Server-Sent Events")
+	FOnEventSourceError OnError;
+
+	/* Delay before reconnecting when the server didn't give one. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Server-Sent Events", meta = (ClampMin = "0", Units = "s"))
+	float ReconnectDelay = 3.f;
+
+	/* Longest delay between two attempts. Zero to not limit it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Server-Sent Events", meta = (ClampMin = "0", Units = "s"))
+	float MaxReconnectDelay = 30.f;
+
+	/* Failed attempts in a row after which the source is closed. Zero to reconnect forever. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Server-Sent Events", meta = (ClampMin = "0"))
+	int32 MaxReconnectAttempts = 0;
+
+	/* Reconnects when nothing was received for this long, keep-alive comments included. Zero to disable. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Server-Sent Events", meta = (ClampMin = "0", Units = "s"))
+	float InactivityTimeout = 0.f;
+
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	//~ End UObject Interface
+
+private:
+	bool StartRequest();
+
+	void ScheduleReconnect(UHttpResponse* const Response);
+
+	/* Broadcasts the events parsed so far. Returns false if a listener closed or restarted the source. */
+	bool FlushEvents();
+
+	UFUNCTION()
+	void OnRequestHeader(UHttpRequest* const InRequest, const FString& HeaderName, const FString& HeaderValue);
+
+	UFUNCTION()
+	void OnRequestProgress(UHttpRequest* const InRequest, const int32 BytesSent, const int32 BytesReceived);
+
+	UFUNCTION()
+	void OnRequestCompleted(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	UPROPERTY()
+	UHttpRequest* Request;
+
+	TSharedPtr<FHttpEventStreamParser, ESPMode::ThreadSafe> Parser;
+
+	FString Url;
+	TMap<FString, FString> Headers;
+	FName Profile;
+
+	EHttpEventSourceState State;
+
+	FString LastEventId;
+
+	// The reconnection time sent by the server, -1 until it sends one.
+	int64 RetryMilliseconds;
+
+	// Failed attempts since the stream was last open.
+	int32 ReconnectAttempts;
+
+	FTSTicker::FDelegateHandle ReconnectHandle;
+};
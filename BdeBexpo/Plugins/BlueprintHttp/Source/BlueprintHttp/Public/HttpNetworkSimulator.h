@@ -0,0 +1,95 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpNetworkSimulator.generated.h"
+
+class IHttpTransport;
+
+/**
+ *  Network conditions applied to each request while the simulator is enabled.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpNetworkConditions
+{
+	GENERATED_BODY()
+public:
+	/* Round trip time added to each request, half before sending it and half before delivering its response. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Network Simulation", meta = (ClampMin = "0", Units = "ms"))
+	float LatencyMs = 0.f;
+
+	/* Random variation added to each half of the latency, from zero to this value. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Network Simulation", meta = (ClampMin = "0", Units = "ms"))
+	float JitterMs = 0.f;
+
+	/**
+	 * Download speed in kilobytes per second used to delay the response by the time its body would take.
+	 * The body is still received at full speed, only its completion waits. Zero adds no delay.
+	 **/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Network Simulation", meta = (ClampMin = "0"))
+	float DownloadDelayKBps = 0.f;
+
+	/* Upload speed in kilobytes per second used to delay sending the request by the time its body would take. Zero adds no delay. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Network Simulation", meta = (ClampMin = "0"))
+	float UploadDelayKBps = 0.f;
+
+	/* Chance for a request to fail with a connection error without being sent. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Network Simulation", meta = (ClampMin = "0", ClampMax = "1"))
+	float FailureRate = 0.f;
+
+	/* Chance for a response to be held for CompletionStallDuration once received, before its completion is delivered. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Network Simulation", meta = (ClampMin = "0", ClampMax = "1"))
+	float CompletionStallRate = 0.f;
+
+	/* How long a stalled response is held. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Network Simulation", meta = (ClampMin = "0", Units = "s"))
+	float CompletionStallDuration = 0.f;
+};
+
+/**
+ *  Simulates degraded networks by delaying and failing requests.
+ *  The simulator wraps whichever transport is active, so it also applies to
+ *  loopback servers and replayed archives.
+ *
+ *  Built-in profiles: ExpoWifi, 3G, Edge, Lossy and HighLatency.
+ *  The simulator only acts on when requests start and complete: bandwidth and stalls are
+ *  turned into delays, while the transfer itself, its progress events and response streams
+ *  run at the speed of the inner transport.
+ **/
+class BLUEPRINTHTTP_API FHttpNetworkSimulator
+{
+public:
+	/**
+	 * Enables one of the registered profiles. NAME_None disables the simulation.
+	 * @return If the profile exists. The current conditions are kept otherwise.
+	 **/
+	static bool SetProfile(const FName ProfileName);
+
+	/* Enables the simulation with custom conditions. */
+	static void SetConditions(const FHttpNetworkConditions& Conditions);
+
+	/* Disables the simulation. Requests already started keep their conditions. */
+	static void Disable();
+
+	/* Returns if new requests are simulated. */
+	static bool IsEnabled();
+
+	/* Returns the active profile, "Custom" for custom conditions or NAME_None when disabled. */
+	static FName GetProfileName();
+
+	/* Returns the conditions applied to new requests. */
+	static FHttpNetworkConditions GetConditions();
+
+	/* Adds or replaces a profile. */
+	static void RegisterProfile(const FName ProfileName, const FHttpNetworkConditions& Conditions);
+
+	/* Returns the names of the registered profiles. */
+	static TArray<FName> GetProfileNames();
+
+	/* Seeds the random failures, stalls and jitter so that runs can be reproduced. */
+	static void SetSeed(const int32 Seed);
+
+	/* Returns a transport simulating the current conditions on top of Inner, for a single request. */
+	static TSharedRef<IHttpTransport> Wrap(const TSharedRef<IHttpTransport>& Inner);
+};
@@ -0,0 +1,251 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Engine/StreamableManager.h"
+#include "HttpContentHash.h"
+#include "HttpPakChunkSubsystem.generated.h"
+
+class UHttpRequest;
+class UHttpResponse;
+class UHttpPakChunkSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnPakChunkProgress, const FName, ChunkName, const int64, BytesDownloaded, const int64, BytesToDownload);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams  (FOnPakChunkMounted,  const FName, ChunkName, const bool, bSucceeded);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams  (FOnPakChunkEvent,    const FName, ChunkName, const float, Progress);
+
+/**
+ *	A file of a chunk: the .pak, and the .utoc and .ucas of IoStore chunks.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpPakChunkFile
+{
+	GENERATED_BODY()
+public:
+	/* Where the file is downloaded from. It's saved in the directory of its chunk under the last segment of the URL. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	FString Url;
+
+	/* Digest of the file, in hexadecimal or Base64. Files without one are downloaded each time their chunk is requested. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	FString Hash;
+
+	/* Size of the file, used to report the progress. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	int64 Size = 0;
+};
+
+/**
+ *	A pak chunk that can be downloaded and mounted at runtime.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpPakChunk
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	FName Name;
+
+	/* The files of the chunk. The .pak file is mounted once they are all verified. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	TArray<FHttpPakChunkFile> Files;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	EHttpHashAlgorithm HashAlgorithm = EHttpHashAlgorithm::SHA256;
+
+	/* Priority of the chunk over the other paks when they contain the same files. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	int32 MountOrder = 10;
+};
+
+/**
+ *  Streams a single chunk file to its partial file and keeps its request alive.
+ **/
+UCLASS(Transient)
+class UHttpPakChunkDownload final : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION()
+	void OnRequestCompleted(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	UFUNCTION()
+	void OnRequestProgress(UHttpRequest* const InRequest, const int32 BytesSent, const int32 InBytesReceived);
+
+	UPROPERTY()
+	UHttpRequest* Request;
+
+	/* The partial file the response is written to as it's received, by the HTTP thread. */
+	TSharedPtr<FArchive, ESPMode::ThreadSafe> FileWriter;
+
+	UPROPERTY()
+	UHttpPakChunkSubsystem* Owner;
+
+	FName ChunkName;
+	int32 FileIndex;
+	int64 BytesReceived;
+};
+
+/**
+ *  Downloads pak chunks on demand and mounts them, so heavy content isn't part of the
+ *  installed package.
+ *
+ *  Chunks are registered with their files, then made available when a screen needs them.
+ *  Their files are streamed to the disk next to their destination in the persistent download
+ *  directory, verified as they are received, moved in place and the chunk is mounted. The hashes verified
+ *  are kept in an index next to the chunks, files downloaded by a previous session are only
+ *  reused when their verified hash is the one of the chunk.
+ *
+ *  Mounting requires the pak platform file, which packaged builds use.
+ **/
+UCLASS()
+class BLUEPRINTHTTP_API UHttpPakChunkSubsystem final : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+public:
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/* Makes a chunk known to the subsystem. A chunk registered again replaces the previous one if it isn't mounted. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Pak Chunks")
+	void RegisterChunk(const FHttpPakChunk& Chunk);
+
+	/**
+	 * Downloads the chunk if needed then mounts it. OnChunkMounted is broadcast once it's done.
+	 * @return False if the chunk isn't registered.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Pak Chunks")
+	bool RequestChunk(const FName ChunkName);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Pak Chunks")
+	bool IsChunkMounted(const FName ChunkName) const;
+
+	/* Returns if all the files of the chunk are on the disk and match their hash. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Pak Chunks")
+	bool IsChunkDownloaded(const FName ChunkName) const;
+
+	/* Returns the download progress of the chunk, between 0 and 1. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Pak Chunks")
+	float GetChunkProgress(const FName ChunkName) const;
+
+	/* Unmounts the chunk. Its content must not be in use. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Pak Chunks")
+	bool UnmountChunk(const FName ChunkName);
+
+	/* Unmounts the chunk and deletes its files. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Pak Chunks")
+	void DeleteChunk(const FName ChunkName);
+
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Pak Chunks")
+	FOnPakChunkProgress OnChunkProgress;
+
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|Pak Chunks")
+	FOnPakChunkMounted OnChunkMounted;
+
+	void OnDownloadFinished(UHttpPakChunkDownload* const Download, const bool bSucceeded);
+	void OnDownloadProgress(UHttpPakChunkDownload* const Download);
+
+private:
+	struct FChunkState
+	{
+		FHttpPakChunk Chunk;
+
+		// The mounted .pak file, empty if the chunk isn't mounted.
+		FString MountedPak;
+
+		int64 BytesToDownload = 0;
+		int64 BytesDownloaded = 0;
+
+		int32 PendingFiles = 0;
+
+		bool bDownloading = false;
+		bool bAnyFailure  = false;
+	};
+
+	struct FVerifiedFile
+	{
+		FString Hash;
+		EHttpHashAlgorithm Algorithm;
+	};
+
+	void DownloadFile(FChunkState& State, const int32 FileIndex);
+
+	void Mount(FChunkState& State);
+
+	void Finish(FChunkState& State, const bool bSucceeded);
+
+	/* Returns if the file on disk was verified against the hash the chunk expects. */
+	bool IsFileVerified(const FHttpPakChunk& Chunk, const FHttpPakChunkFile& File) const;
+
+	/* Files are saved in the directory of their chunk so the .pak, .utoc and .ucas stay side by side. */
+	FString GetFilePath(const FName ChunkName, const FHttpPakChunkFile& File) const;
+
+	void LoadIndex();
+	void SaveIndex() const;
+
+	FString GetIndexPath() const;
+
+	UPROPERTY()
+	TArray<UHttpPakChunkDownload*> ActiveDownloads;
+
+	TMap<FName, FChunkState> Chunks;
+
+	/* The hashes the files on disk were verified against, by path. */
+	TMap<FString, FVerifiedFile> VerifiedFiles;
+};
+
+/**
+ *	Makes a pak chunk available and optionally preloads assets from it.
+ **/
+UCLASS()
+class BLUEPRINTHTTP_API UEnsureHttpPakChunkProxy final : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	/* Called while the chunk is downloaded. */
+	UPROPERTY(BlueprintAssignable)
+	FOnPakChunkEvent OnProgress;
+
+	/* Called once the chunk is mounted and the assets to preload are loaded. */
+	UPROPERTY(BlueprintAssignable)
+	FOnPakChunkEvent OnAvailable;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnPakChunkEvent OnFailed;
+
+	virtual void Activate() override;
+
+	/**
+	 * Downloads and mounts a registered chunk if it isn't mounted yet.
+	 * @param ChunkName		The name the chunk was registered with.
+	 * @param PreloadAssets	Assets of the chunk loaded asynchronously before OnAvailable is called.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Pak Chunks", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", AutoCreateRefTerm = "PreloadAssets", DisplayName = "Ensure Pak Chunk Available"))
+	static UEnsureHttpPakChunkProxy* EnsurePakChunkAvailable(UObject* WorldContextObject, const FName ChunkName, const TArray<TSoftObjectPtr<UObject>>& PreloadAssets);
+
+private:
+	UFUNCTION()
+	void OnChunkProgress(const FName InChunkName, const int64 BytesDownloaded, const int64 BytesToDownload);
+
+	UFUNCTION()
+	void OnChunkMounted(const FName InChunkName, const bool bSucceeded);
+
+	void Preload();
+
+	void Complete(const bool bSucceeded);
+
+	UPROPERTY()
+	UHttpPakChunkSubsystem* Subsystem;
+
+	UPROPERTY()
+	TArray<TSoftObjectPtr<UObject>> PreloadAssets;
+
+	FName ChunkName;
+
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+};
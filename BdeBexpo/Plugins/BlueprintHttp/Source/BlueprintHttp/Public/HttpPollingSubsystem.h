@@ -0,0 +1,161 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "HttpPollingSubsystem.generated.h"
+
+class UHttpRequest;
+class UHttpResponse;
+class UHttpPollingSubsystem;
+
+/* Called with the new content of a polled endpoint. */
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnHttpPollUpdated, const FString&, Url, UHttpResponse* const, Response);
+
+/**
+ *  An endpoint polled for its subscribers, with its validators and interval.
+ **/
+UCLASS(Transient)
+class UHttpPolledEndpoint final : public UObject
+{
+	GENERATED_BODY()
+public:
+	struct FSubscriber
+	{
+		int32 Handle;
+		FOnHttpPollUpdated OnUpdated;
+		float MinInterval;
+		float MaxInterval;
+	};
+
+	UFUNCTION()
+	void OnResponse(UHttpRequest* const InRequest, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	UPROPERTY()
+	UHttpPollingSubsystem* Owner;
+
+	UPROPERTY()
+	UHttpRequest* Request;
+
+	/* The last content received, given to new subscribers. */
+	UPROPERTY()
+	UHttpResponse* LatestResponse;
+
+	FString Key;
+	FString Url;
+	FName	Profile;
+
+	TArray<FSubscriber> Subscribers;
+
+	FString ETag;
+	FString LastModified;
+
+	// Identifies the content when the server doesn't send validators.
+	uint64 ContentHash = 0;
+	int32  ContentLength = -1;
+
+	/* Bounds of the interval, the smallest asked for by the subscribers. */
+	float MinInterval = 0.f;
+	float MaxInterval = 0.f;
+
+	/* Current interval, adapted to how often the content changes. */
+	float Interval = 0.f;
+
+	/* When the last poll completed. */
+	double LastPollTime = 0.;
+	double NextPollTime = 0.;
+};
+
+/**
+ *  Polls endpoints on behalf of any number of subscribers, typically widgets showing the same data.
+ *
+ *  Each endpoint is requested once for all its subscribers with If-None-Match / If-Modified-Since, so unchanged
+ *  content costs a 304. Subscribers are only called when the content changed, and right away with the current
+ *  content when they subscribe to an endpoint already polled.
+ *  The interval of an endpoint adapts to its content: it's halved each time the content changed, grows by a
+ *  quarter with each poll that found it unchanged and doubles after failures, within the bounds the subscribers
+ *  asked for. It's multiplied by BackgroundIntervalScale while the application isn't in the foreground.
+ *  Subscribers whose object was destroyed are removed, endpoints without subscribers stop being polled.
+ **/
+UCLASS()
+class BLUEPRINTHTTP_API UHttpPollingSubsystem final : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+public:
+	UHttpPollingSubsystem();
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/**
+	 * Subscribes to the content of an endpoint.
+	 * @param Url			The URL polled.
+	 * @param OnUpdated		Called each time the content changed.
+	 * @param MinInterval	Shortest delay between two polls, used while the content changes often.
+	 * @param MaxInterval	Longest delay between two polls, reached while the content doesn't change.
+	 * @param Profile		The optional client profile. Url is then a path appended to its base URL.
+	 * @return The handle to unsubscribe.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Polling", meta = (AdvancedDisplay = "Profile"))
+	UPARAM(DisplayName = "Handle") int32 Subscribe(const FString& Url, const FOnHttpPollUpdated& OnUpdated, const float MinInterval = 2.f, const float MaxInterval = 60.f, const FName Profile = NAME_None);
+
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Polling")
+	void Unsubscribe(const int32 Handle);
+
+	/* Removes the subscriptions bound to an object. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Polling")
+	void UnsubscribeAll(const UObject* const Subscriber);
+
+	/* Polls an endpoint now, for instance after sending a change to it. */
+	UFUNCTION(BlueprintCallable, Category = "HTTP|Polling", meta = (AdvancedDisplay = "Profile"))
+	void PollNow(const FString& Url, const FName Profile = NAME_None);
+
+	/* Returns the last content received from an endpoint, or null. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Polling", meta = (AdvancedDisplay = "Profile"))
+	UPARAM(DisplayName = "Response") UHttpResponse* GetLatestResponse(const FString& Url, const FName Profile = NAME_None) const;
+
+	/* Returns if the application is in the foreground. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|Polling")
+	bool IsInForeground() const;
+
+	/* Factor applied to the intervals while the application isn't in the foreground. Zero pauses polling. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|Polling", meta = (ClampMin = "0"))
+	float BackgroundIntervalScale = 4.f;
+
+	void OnEndpointResponse(UHttpPolledEndpoint* const Endpoint, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+private:
+	bool Tick(float DeltaTime);
+
+	void Poll(UHttpPolledEndpoint* const Endpoint);
+
+	/* Removes the subscribers that were destroyed and the endpoints left without one. Returns false if the endpoint was removed. */
+	bool PruneSubscribers(UHttpPolledEndpoint* const Endpoint);
+
+	void RemoveEndpoint(UHttpPolledEndpoint* const Endpoint);
+
+	/* Sets the bounds of the interval from the subscribers. */
+	void UpdateIntervalBounds(UHttpPolledEndpoint* const Endpoint) const;
+
+	void SchedulePoll(UHttpPolledEndpoint* const Endpoint) const;
+
+	void SetForeground(const bool bInForeground);
+
+	UHttpPolledEndpoint* FindEndpoint(const FString& Url, const FName Profile) const;
+
+	UPROPERTY()
+	TMap<FString, UHttpPolledEndpoint*> Endpoints;
+
+	int32 NextHandle;
+	bool  bForeground;
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	FDelegateHandle ActivationHandle;
+	FDelegateHandle EnterBackgroundHandle;
+	FDelegateHandle EnterForegroundHandle;
+};
@@ -3,12 +3,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HttpContentHash.h"
+#include "HttpUrl.h"
+#include "Containers/Ticker.h"
 #include "HttpRequest.generated.h"
 
 class IHttpRequest;
 class IHttpResponse;
 class UHttpRequest;
 class UHttpResponse;
+class IHttpTransport;
+class UHttpDeadlineBudget;
+class FHttpResponseBody;
+struct FHttpWorkerCompletion;
 
 /**
  *  A non hexaustive list of common MIME-Types to use for Content-Type. 
@@ -74,7 +81,126 @@ enum class EBlueprintHttpRequestStatus : uint8
 	Processing				UMETA(DisplayName="Processing",					ToolTip = "Currently being ticked and processed."),
 	Failed					UMETA(DisplayName="Failed",						ToolTip = "Finished but failed."),
 	Failed_ConnectionError	UMETA(DisplayName="Failed: Connection Error",	ToolTip = "Failed because it was unable to connect (safe to retry)."),
-	Succeeded				UMETA(DisplayName="Succeeded",					ToolTip = "Finished and was successful.")
+	Succeeded				UMETA(DisplayName="Succeeded",					ToolTip = "Finished and was successful."),
+	Failed_Timeout			UMETA(DisplayName="Failed: Timeout",			ToolTip = "Cancelled because one of its timeouts or its deadline budget expired."),
+	Failed_IntegrityCheck	UMETA(DisplayName="Failed: Integrity Check",	ToolTip = "The response was received but its content didn't match the expected digest.")
+};
+
+/**
+ *	Importance of a request, used to order the work done for it.
+ **/
+UENUM(BlueprintType)
+enum class EHttpRequestPriority : uint8
+{
+	Background	UMETA(ToolTip = "Prefetches and other requests nobody waits for."),
+	Normal		UMETA(ToolTip = "Default priority."),
+	Interactive	UMETA(ToolTip = "Requests the player is waiting for. Their completion is delivered before the others.")
+};
+
+/**
+ *	How often OnRequestProgress is broadcast.
+ **/
+UENUM(BlueprintType)
+enum class EHttpProgressReporting : uint8
+{
+	EveryFrame	UMETA(DisplayName="Every Frame",	ToolTip = "Broadcast at most once per frame."),
+	Throttled	UMETA(DisplayName="Throttled",		ToolTip = "Broadcast once the policy's interval and delta are reached, at most once per frame. Progress held back is broadcast once the transfer stalls."),
+	Off			UMETA(DisplayName="Off",			ToolTip = "Never broadcast. The Download File node keeps reporting its progress.")
+};
+
+/**
+ *	Limits how often a request reports its progress.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpProgressPolicy
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	EHttpProgressReporting Reporting = EHttpProgressReporting::EveryFrame;
+
+	/* Minimum time between two progress events when throttled. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0", Units = "s"))
+	float MinInterval = 0.f;
+
+	/* Minimum number of bytes transferred between two progress events when throttled. Zero to ignore. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0"))
+	int32 MinBytesDelta = 0;
+
+	/* Minimum percentage of the response downloaded between two progress events when throttled. Zero to ignore. Needs a Content-Length. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0", ClampMax = "100"))
+	float MinPercentDelta = 0.f;
+};
+
+/**
+ *	Time limits of a request, in seconds. Zero disables a limit.
+ *	Expired requests are cancelled and complete with the Failed: Timeout status.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpRequestTimeouts
+{
+	GENERATED_BODY()
+public:
+	/* Maximum time between sending the request and the first byte exchanged with the server. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0", Units = "s"))
+	float ConnectionTimeout = 0.f;
+
+	/* Maximum time without any byte exchanged once connected. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0", Units = "s"))
+	float ActivityTimeout = 0.f;
+
+	/* Maximum time from ProcessRequest() to the completion, including the time spent queued. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0", Units = "s"))
+	float TotalTimeout = 0.f;
+
+	bool HasAny() const { return ConnectionTimeout > 0.f || ActivityTimeout > 0.f || TotalTimeout > 0.f; }
+};
+
+/**
+ *	When and how fast a failed request is sent again.
+ *	Each retry broadcasts OnRequestWillRetry, OnRequestComplete is only broadcast for the last attempt.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpRetryPolicy
+{
+	GENERATED_BODY()
+public:
+	/* Number of times a request is sent again after its first attempt. Zero disables retries. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0"))
+	int32 MaxRetries = 0;
+
+	/* Delay before the first retry. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0", Units = "s"))
+	float InitialDelay = 1.f;
+
+	/* Factor applied to the delay after each retry. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "1"))
+	float BackoffMultiplier = 2.f;
+
+	/* Longest delay between two attempts, Retry-After included. Zero to not limit it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0", Units = "s"))
+	float MaxDelay = 30.f;
+
+	/* Waits a random time between half and all of the delay, so that clients don't retry together. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	bool bJitter = true;
+
+	/* Retries on 408, 429, 500, 502, 503 and 504 responses. Connection errors are always retried. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	bool bRetryOnServerErrors = true;
+
+	/* Retries requests cancelled by one of their timeouts. Never done once the deadline budget expired. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	bool bRetryOnTimeout = false;
+
+	/* Retries POST and PATCH requests, which the server may have already applied. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP)
+	bool bRetryNonIdempotent = false;
+
+	bool IsEnabled() const { return MaxRetries > 0; }
+
+	/* Returns the delay before the attempt following Attempt failed ones, with the backoff, jitter and limit applied. */
+	float GetBackoffDelay(const int32 Attempt) const;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRequestComplete,       UHttpRequest*const, Request, UHttpResponse*const, Response,   const bool,     bConnectedSuccessfully);
@@ -82,6 +208,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRequestProgress,       UHttpRe
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRequestHeaderReceived, UHttpRequest*const, Request, const FString&,      HeaderName, const FString&, NewHeaderValue);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRequestWillRetry,		 UHttpRequest*const, Request, UHttpResponse*const, Response,   const float,    SecondsToRetry);
 
+/* Native delegate called on a task-graph worker. */
+DECLARE_DELEGATE_OneParam(FOnRequestCompleteOnWorker, const FHttpWorkerCompletion& /* Completion */);
+
 /**
  *  Wrapper class around native HTTP request pointer.
  **/
@@ -197,10 +326,14 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
 	UPARAM(DisplayName = "URL") FString GetURL() const;
 
-	/* Returns the value of the specified parameter in the URL. */
+	/* Returns the decoded value of the specified parameter in the URL. The URL is parsed once. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
 	UPARAM(DisplayName = "Parameter") FString GetURLParameter(const FString& ParameterName) const;
 
+	/* Returns the URL split into its parts. Not valid if the URL isn't absolute. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "URL") FHttpUrl GetParsedURL() const;
+
 	/* Returns the verb used by this request. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
 	UPARAM(DisplayName = "Verb") FString GetVerb() const;
@@ -218,6 +351,78 @@ public:
 	UFUNCTION(BlueprintCallable, Category = HTTP)
 	void CancelRequest();
 
+	/* Sets how often OnRequestProgress is broadcast. Requests start with the default policy. */
+	UFUNCTION(BlueprintCallable, Category = HTTP)
+	void SetProgressPolicy(const FHttpProgressPolicy& Policy);
+
+	/* Returns how often OnRequestProgress is broadcast. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Policy") FHttpProgressPolicy GetProgressPolicy() const;
+
+	/* Sets the importance of the request. */
+	UFUNCTION(BlueprintCallable, Category = HTTP)
+	void SetPriority(const EHttpRequestPriority InPriority);
+
+	/* Returns the importance of the request. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Priority") EHttpRequestPriority GetPriority() const;
+
+	/* Sets the time limits of the request. Applied the next time the request is processed. */
+	UFUNCTION(BlueprintCallable, Category = HTTP)
+	void SetTimeouts(const FHttpRequestTimeouts& InTimeouts);
+
+	/* Returns the time limits of the request. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Timeouts") FHttpRequestTimeouts GetTimeouts() const;
+
+	/* Sets when the request is sent again after failing. Applied the next time the request is processed. */
+	UFUNCTION(BlueprintCallable, Category = HTTP)
+	void SetRetryPolicy(const FHttpRetryPolicy& InRetryPolicy);
+
+	/* Returns when the request is sent again after failing. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Retry Policy") FHttpRetryPolicy GetRetryPolicy() const;
+
+	/* Returns how many times the request was sent again since ProcessRequest() was called. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Retries") int32 GetRetryCount() const;
+
+	/**
+	 * Makes the request share a deadline with the other requests of the budget.
+	 * Once the budget expired, the request fails with the Failed: Timeout status and isn't sent anymore.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = HTTP)
+	void SetDeadlineBudget(UHttpDeadlineBudget* const Budget);
+
+	/* Returns the deadline budget of the request, if any. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Budget") UHttpDeadlineBudget* GetDeadlineBudget() const;
+
+	/**
+	 * Verifies the content of successful responses with a hash computed as the bytes arrive.
+	 * A response that doesn't match fails with the Failed: Integrity Check status and its content is discarded.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = HTTP)
+	void SetIntegrityCheck(const FHttpIntegrityCheck& InIntegrityCheck);
+
+	/* Returns how the content of responses is verified. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Integrity Check") FHttpIntegrityCheck GetIntegrityCheck() const;
+
+	/* Returns the time between sending the request and receiving the first byte of the response, or zero. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "Seconds") float GetTimeToFirstByte() const;
+
+	/**
+	 * Writes the content of the next responses to Stream as it's received instead of keeping it.
+	 * Stream is written by the HTTP thread. Pass nullptr to keep the content again.
+	 **/
+	void SetResponseStream(const TSharedPtr<FArchive, ESPMode::ThreadSafe>& Stream);
+
+	/* Sets the progress policy of requests created afterwards. */
+	static void SetDefaultProgressPolicy(const FHttpProgressPolicy& Policy);
+	static const FHttpProgressPolicy& GetDefaultProgressPolicy();
+
 	/**
 	 * Delegate called when the request is completed.
 	*/
@@ -237,7 +442,71 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintAssignable, Category = HTTP)
 	FOnRequestWillRetry OnRequestWillRetry;
 
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	//~ End UObject Interface
+
+	/**
+	 * Delegate called on a task-graph worker when the request completes, before OnRequestComplete
+	 * is broadcast on the game thread. Lets C++ consumers hash, save or decompress responses off
+	 * the game thread. Bind it with a lambda, a raw or a shared pointer: UObjects must not be used
+	 * from the worker, use FHttpWorkerCompletion::MarshalToGameThread() to get back to them.
+	 **/
+	FORCEINLINE FOnRequestCompleteOnWorker& OnRequestCompleteOnWorker() { return RequestCompleteOnWorker; }
+
+	/* Returns the native request. */
+	FORCEINLINE const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>& GetNativeRequest() const { return Request; }
+
+	/**
+	 * Completes the request with a response that doesn't come from the native request.
+	 * Used by transports which serve requests themselves.
+	 **/
+	void CompleteFromTransport(UHttpResponse* const Response, const bool bConnectedSuccessfully, const EBlueprintHttpRequestStatus Status, const float ElapsedTime);
+
+	/**
+	 * Cancels the request without notifying anyone: the delegates are cleared first.
+	 * Used when the objects listening to the request are going away.
+	 **/
+	void Abandon();
+
+	/* Counts Bytes of the response against the response memory budget until its size is known. Called by the scheduler on admission. */
+	void ReserveResponseMemory(const int64 Bytes);
+
+	/* Returns if the request was started and hasn't completed yet, waiting for a retry included. */
+	FORCEINLINE bool IsInFlight() const { return bInFlight || RetryHandle.IsValid(); }
+
+	/**
+	 * Cancels the request if one of its time limits expired. Called by the timeout watchdog.
+	 * @return False once the request no longer needs to be checked.
+	 **/
+	bool CheckTimeouts(const double Now);
+
+	/* Starts the request on its transport once admitted. Called by FHttpRequestScheduler. */
+	void StartOnTransport();
+
+	/* Broadcasts OnRequestComplete. Called by FHttpCompletionDispatcher. */
+	void DeliverCompletion(UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	/* Reports the progress of a request served by a transport. */
+	void ReportProgressFromTransport(const int32 BytesSent, const int32 BytesReceived);
+
+	/* Reports a header received by a request served by a transport. */
+	void ReportHeaderFromTransport(const FString& HeaderName, const FString& HeaderValue);
+
 private:
+	/* Sends the request once. Called by ProcessRequest() and for each retry. */
+	bool StartAttempt();
+
+	void CompleteRequest(UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+	/* Returns if the attempt that just completed must be sent again. */
+	bool ShouldRetry(UHttpResponse* const Response, const bool bSucceeded) const;
+
+	/* Returns how long to wait before the next attempt. */
+	float GetRetryDelay(UHttpResponse* const Response) const;
+
+	void ScheduleRetry(UHttpResponse* const Response);
+
 	void OnRequestCompleteInternal (TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> RawResponse, bool bConnectedSuccessfully);
 	void OnRequestProgressInternal (TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, const int32 BytesSent, const int32 BytesReceived);
 	void OnHeaderReceivedInternal  (TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RawRequest, const FString& HeaderName, const FString& HeaderValue);
@@ -247,6 +516,119 @@ private:
 
 	FString ConvertEnumVerbToString(const EHttpVerb InVerb);
 
+	void ReportProgress(const int32 BytesSent, const int32 BytesReceived);
+	void ReportHeader  (const FString& HeaderName, const FString& HeaderValue);
+
+	/* Returns if the policy lets a progress event through now. */
+	bool ShouldBroadcastProgress(const int32 BytesSent, const int32 BytesReceived) const;
+
+	/* Broadcasts the progress held back since the last event. */
+	void FlushProgress();
+
+	/* Broadcasts the progress held back once no event came for the policy's interval. */
+	void ScheduleProgressFlush();
+
+	/* Starts the connection and activity clocks. */
+	void MarkDispatched();
+
+	/* Returns when the request must have completed, or zero. */
+	double GetDeadline() const;
+
+	void TimeOut(const TCHAR* const Reason);
+
+	/* Measures the time to first byte the first time it's called. */
+	void NoteFirstByte();
+
+	/* Compares the digest of the response with the expected one. Returns false on a mismatch. */
+	bool VerifyIntegrity(UHttpResponse* const Response);
+
+	/* Returns the URL, parsed on first use. */
+	const FHttpUrl& GetCachedUrl() const;
+
 	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request;
 
+	// If the request was started and hasn't completed yet.
+	bool bInFlight;
+
+	// Bytes received when progress was last reported, to measure the throughput.
+	int32 LastBytesReceived;
+
+	FOnRequestCompleteOnWorker RequestCompleteOnWorker;
+
+	UPROPERTY()
+	EHttpRequestPriority Priority;
+
+	UPROPERTY()
+	FHttpProgressPolicy ProgressPolicy;
+
+	// Progress held back by the policy, broadcast with the next event, once the transfer stalled or before completing.
+	int32  PendingBytesSent;
+	int32  PendingBytesReceived;
+	bool   bProgressPending;
+	double LastProgressEventTime;
+
+	FTSTicker::FDelegateHandle ProgressFlushHandle;
+
+	// Last progress broadcast.
+	uint64 LastProgressFrame;
+	double LastProgressTime;
+	int32  LastBroadcastBytes;
+	int32  LastBroadcastBytesReceived;
+
+	// Content-Length of the response, used by percentage thresholds.
+	int64 ExpectedContentLength;
+
+	static FHttpProgressPolicy DefaultProgressPolicy;
+
+	// The transport the request was started with.
+	TSharedPtr<IHttpTransport> Transport;
+
+	// Set when the request was served by a transport instead of the native request.
+	TOptional<EBlueprintHttpRequestStatus> TransportStatus;
+	float TransportElapsedTime;
+
+	UPROPERTY()
+	FHttpRequestTimeouts Timeouts;
+
+	UPROPERTY()
+	UHttpDeadlineBudget* DeadlineBudget;
+
+	// Clocks of the time limits.
+	double StartTime;
+	double DispatchTime;
+	double LastActivityTime;
+	bool   bDispatched;
+	bool   bHadActivity;
+	bool   bTimedOut;
+	int64  LastActivityBytes;
+
+	// Zero until the first byte of the response was received.
+	float TimeToFirstByte;
+
+	UPROPERTY()
+	FHttpIntegrityCheck IntegrityCheck;
+
+	// Receives the response content in place of the body when set.
+	TSharedPtr<FArchive, ESPMode::ThreadSafe> ResponseStream;
+
+	bool bIntegrityFailed;
+
+	// Receives the response content when the response memory is managed or the content is verified.
+	TSharedPtr<FHttpResponseBody, ESPMode::ThreadSafe> ResponseBody;
+
+	// The URL parsed the first time it's queried, reset by SetURL().
+	mutable TOptional<FHttpUrl> ParsedUrl;
+
+	UPROPERTY()
+	FHttpRetryPolicy RetryPolicy;
+
+	// Attempts sent again since ProcessRequest().
+	int32 RetryCount;
+
+	// Set while waiting for the next attempt.
+	FTSTicker::FDelegateHandle RetryHandle;
+
+	// If CancelRequest() was called during the current attempt.
+	bool bCancelled;
+
 };
@@ -0,0 +1,110 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRequest.h"
+#include "HttpRequestScheduler.generated.h"
+
+/**
+ *  Bandwidth allowed to a class of requests.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpBandwidthLimit
+{
+	GENERATED_BODY()
+public:
+	/* Download rate in kilobytes per second. Zero means unlimited. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0"))
+	float DownloadKBps = 0.f;
+
+	/* Upload rate in kilobytes per second. Zero means unlimited. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = HTTP, meta = (ClampMin = "0"))
+	float UploadKBps = 0.f;
+
+	bool IsUnlimited() const { return DownloadKBps <= 0.f && UploadKBps <= 0.f; }
+};
+
+/**
+ *  Token bucket refilled at a fixed rate. Tokens are bytes.
+ *  The bucket can go in debt: transfers are charged once they happened.
+ **/
+struct BLUEPRINTHTTP_API FHttpTokenBucket
+{
+	/* Bytes per second, zero or less is unlimited. */
+	double Rate = 0.;
+
+	double Tokens = 0.;
+
+	double LastRefillTime = 0.;
+
+	void SetRate(const double InRate);
+
+	void Refill(const double Now);
+
+	bool IsLimited() const { return Rate > 0.; }
+
+	bool IsInDebt() const { return IsLimited() && Tokens < 0.; }
+
+	/* Tokens that can be taken without going in debt. */
+	double GetAvailable() const { return IsLimited() ? FMath::Max(Tokens, 0.) : 0.; }
+
+	void Consume(const double Bytes);
+};
+
+/**
+ *  Admits requests once the bandwidth they belong to allows it.
+ *
+ *  This is admission control, not traffic shaping: requests are held before they start, an
+ *  admitted transfer runs at the speed of the connection. Requests are limited by a global
+ *  bucket, a per host bucket and a per priority bucket, each with a download and an upload rate.
+ *  A request waits until none of its buckets is in debt. Uploads are charged when the request
+ *  is admitted and downloads as they progress, so a large download delays the requests that
+ *  follow it rather than being slowed itself. The rates are only met on average over many requests.
+ *
+ *  Normal and Interactive requests borrow from the Background tokens when their own
+ *  bucket is empty, so background prefetching gives way to foreground traffic.
+ *  Queued requests are admitted by priority, then in submission order.
+ *
+ *  Requests also wait until the response memory budget has room for their reservation,
+ *  see FHttpResponseMemory.
+ **/
+class BLUEPRINTHTTP_API FHttpRequestScheduler
+{
+public:
+	/* Sets the limit shared by all the requests. */
+	static void SetGlobalLimit(const FHttpBandwidthLimit& Limit);
+
+	/**
+	 * Sets the limit of the requests to a host, an unlimited one exempts the host from the default limit.
+	 * An empty host sets the default limit of the hosts without their own.
+	 **/
+	static void SetHostLimit(const FString& Host, const FHttpBandwidthLimit& Limit);
+
+	/* Sets the limit of the requests of a priority. */
+	static void SetPriorityLimit(const EHttpRequestPriority Priority, const FHttpBandwidthLimit& Limit);
+
+	/* Removes all the limits and admits the queued requests. */
+	static void ClearLimits();
+
+	/**
+	 * Admits the request or queues it.
+	 * @return True if the request can start now. Otherwise, UHttpRequest::StartOnTransport() is called once admitted.
+	 **/
+	static bool Admit(UHttpRequest* const Request);
+
+	/* Removes a queued request. Returns false if it wasn't queued. */
+	static bool Dequeue(UHttpRequest* const Request);
+
+	/* Charges downloaded bytes to the buckets of the request. */
+	static void NotifyBytesReceived(const UHttpRequest* const Request, const int64 Bytes);
+
+	/* Called when an admitted request completed. */
+	static void NotifyFinished(const UHttpRequest* const Request);
+
+	/* Returns the number of requests waiting for bandwidth. */
+	static int32 GetQueuedCount();
+
+	/* Drops the queued requests without starting them. */
+	static void Reset();
+};
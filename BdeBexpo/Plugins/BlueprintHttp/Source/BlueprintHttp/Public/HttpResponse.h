@@ -3,10 +3,36 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HttpUrl.h"
 #include "HttpResponse.generated.h"
 
 class IHttpResponse;
 class IHttpRequest;
+class FHttpResponseBody;
+
+/**
+ *  Response data held outside of the engine's HTTP module.
+ *  Used by transports that serve requests themselves.
+ **/
+struct BLUEPRINTHTTP_API FHttpResponseSnapshot
+{
+	FString URL;
+
+	int32 ResponseCode = 0;
+
+	/* Raw "Key: Value" header lines, as returned by IHttpBase::GetAllHeaders(). */
+	TArray<FString> Headers;
+
+	TArray<uint8> Content;
+
+	/* Returns the value of the header or an empty string. */
+	FString GetHeader(const FString& Key) const;
+
+	/* Copies the data of a native response. */
+	static TSharedRef<FHttpResponseSnapshot, ESPMode::ThreadSafe> Capture(const IHttpResponse& Response);
+
+	friend BLUEPRINTHTTP_API FArchive& operator<<(FArchive& Ar, FHttpResponseSnapshot& Snapshot);
+};
 
 /**
  *
@@ -55,21 +81,48 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
 	UPARAM(DisplayName = "URL") FString GetURL() const;
 
-	/* Returns the value of the specified parameter in the URL. */
+	/* Returns the decoded value of the specified parameter in the URL. The URL is parsed once. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
 	UPARAM(DisplayName = "Parameter") FString GetURLParameter(const FString& ParameterName) const;
 
+	/* Returns the URL split into its parts. Not valid if the URL isn't absolute. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
+	UPARAM(DisplayName = "URL") FHttpUrl GetParsedURL() const;
+
 	/* Returns the time it took the server to fully respond to the request. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = HTTP)
 	UPARAM(DisplayName = "Elapsed Time") float GetElapsedTime() const;
 
+	/* Creates a response backed by a snapshot instead of a native response. */
+	static UHttpResponse* CreateFromSnapshot(TSharedPtr<const FHttpResponseSnapshot, ESPMode::ThreadSafe> InSnapshot, const float InRequestDuration);
+
+	/* Returns the native response. nullptr if the response comes from a snapshot or if the request failed. */
+	FORCEINLINE const TSharedPtr<IHttpResponse, ESPMode::ThreadSafe>& GetNativeResponse() const { return Response; }
+
+	/* Returns the snapshot the response was created from. nullptr for native responses. */
+	FORCEINLINE const TSharedPtr<const FHttpResponseSnapshot, ESPMode::ThreadSafe>& GetSnapshot() const { return Snapshot; }
+
+	/* Returns the body received in place of the native response's content, if any. */
+	FORCEINLINE const TSharedPtr<FHttpResponseBody, ESPMode::ThreadSafe>& GetBody() const { return Body; }
+
 private:
 	// Can't use RAII with UObject.
 	// Because of this workaround, Response can be nullptr.
 	void InitInternal(TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> InResponse, const float &InRequestDuration);
 
+	/* Returns the URL, parsed on first use. */
+	const FHttpUrl& GetCachedUrl() const;
+
 	float RequestDuration;
 
 	TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> Response;
 
+	// Set instead of Response when served by a transport.
+	TSharedPtr<const FHttpResponseSnapshot, ESPMode::ThreadSafe> Snapshot;
+
+	// Holds the content of native responses when the memory budget or spilling is enabled.
+	TSharedPtr<FHttpResponseBody, ESPMode::ThreadSafe> Body;
+
+	mutable TOptional<FHttpUrl> ParsedUrl;
+
 };
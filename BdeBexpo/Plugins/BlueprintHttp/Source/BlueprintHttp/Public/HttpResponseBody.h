@@ -0,0 +1,138 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "HAL/CriticalSection.h"
+#include "HttpContentHash.h"
+
+/**
+ *  Receives the body of a response in place of the native response.
+ *
+ *  The body is buffered in memory and counted against the response memory budget until
+ *  the request completes, at least for the bytes reserved when the request was admitted.
+ *  Bodies larger than the spill threshold, or that would exceed the budget, are moved to
+ *  a temporary file, deleted with the body unless it was moved elsewhere. The body can be hashed as
+ *  it arrives to verify it without reading it again, and forwarded to another archive
+ *  instead of being kept.
+ *
+ *  Written by the HTTP thread, read once the request completed.
+ **/
+class BLUEPRINTHTTP_API FHttpResponseBody : public FArchive
+{
+public:
+	/* @param InSpillThreshold	Size above which the body is moved to the disk. Zero keeps it in memory. */
+	explicit FHttpResponseBody(const int64 InSpillThreshold);
+	virtual ~FHttpResponseBody();
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Length) override;
+	virtual FString GetArchiveName() const override { return TEXT("FHttpResponseBody"); }
+	//~ End FArchive Interface
+
+	/* Counts Bytes against the budget until the body is larger, it completes or its size is announced. */
+	void Reserve(const int64 Bytes);
+
+	/* Replaces the reservation with the announced size. Spills the body right away if it's above the threshold or doesn't fit in the budget. */
+	void SetExpectedSize(const int64 ExpectedSize);
+
+	/* Writes the bytes received from now on to Stream instead of keeping them. Stream is written by the HTTP thread. */
+	void SetForwardStream(const TSharedPtr<FArchive, ESPMode::ThreadSafe>& Stream);
+
+	/* Hashes the bytes received from now on. */
+	void SetHashAlgorithm(const EHttpHashAlgorithm Algorithm);
+
+	/* Returns the digest of the body, empty if it isn't hashed. Must be called once the request completed. */
+	TArray<uint8> GetDigest();
+
+	/* Called when the request completed. The body stops counting against the budget. */
+	void Complete();
+
+	/* Returns the number of bytes received. */
+	int64 GetSize() const;
+
+	/* Returns if the body was moved to a temporary file. */
+	bool IsSpilled() const;
+
+	/* Returns the temporary file the body was moved to, if any. */
+	FString GetSpillFilename() const;
+
+	/* Returns the body. A spilled body is read back from the disk the first time. */
+	const TArray<uint8>& GetContent() const;
+
+	/* Moves the spilled body to a file so it isn't read back in memory. Returns false if it isn't spilled. */
+	bool MoveSpilledFileTo(const FString& Filename);
+
+	/* Frees the body and deletes its temporary file. */
+	void Discard();
+
+private:
+	void Spill();
+
+	/* Counts the larger of the reservation and the buffered bytes, nothing once spilled, forwarded or completed. */
+	void Recount();
+
+	void Uncount();
+
+	mutable FCriticalSection Lock;
+
+	mutable TArray<uint8> Memory;
+
+	TUniquePtr<FArchive> FileWriter;
+
+	FString SpillFilename;
+
+	TSharedPtr<FArchive, ESPMode::ThreadSafe> ForwardStream;
+
+	TUniquePtr<FHttpStreamingHash> Hash;
+	TArray<uint8> Digest;
+
+	int64 Size;
+	int64 SpillThreshold;
+
+	// Bytes counted against the budget.
+	int64 CountedBytes;
+	int64 ReservedBytes;
+
+	bool bSpillRequested;
+	bool bCanSpill;
+	bool bCompleted;
+	mutable bool bLoaded;
+};
+
+/**
+ *  Budget of the response bytes buffered by the requests in flight.
+ *  Admitted requests reserve an estimate of their response, replaced by its Content-Length once known.
+ *  Requests are held in the scheduler's queue while their reservation doesn't fit in the budget, and
+ *  responses in flight that would exceed it are moved to temporary files.
+ **/
+class BLUEPRINTHTTP_API FHttpResponseMemory
+{
+public:
+	/* Sets the budget, zero to disable it. */
+	static void SetBudget(const int64 Bytes);
+	static int64 GetBudget();
+
+	/* Sets the size above which responses are moved to temporary files, zero to disable it. */
+	static void SetSpillThreshold(const int64 Bytes);
+	static int64 GetSpillThreshold();
+
+	/* Returns if responses are received through FHttpResponseBody. */
+	static bool IsEnabled();
+
+	/* Sets the bytes reserved for a response when its request is admitted, until its size is known. */
+	static void SetReservation(const int64 Bytes);
+	static int64 GetReservation();
+
+	/* Returns if Bytes more can be buffered. Always true while nothing is buffered, so a response larger than the budget isn't held forever. */
+	static bool HasRoom(const int64 Bytes);
+
+	/* Returns the response bytes held in memory by the requests in flight. */
+	static int64 GetBufferedBytes();
+
+private:
+	friend class FHttpResponseBody;
+
+	static void AddBufferedBytes(const int64 Bytes);
+};
@@ -0,0 +1,94 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpThreadTuner.generated.h"
+
+/**
+ *	How the HTTP thread's frame and sleep times are chosen.
+ **/
+UENUM(BlueprintType)
+enum class EHttpThreadTuningPreset : uint8
+{
+	Manual		UMETA(ToolTip="The frame and sleep times are only changed by the GLOBAL HTTP setters."),
+	Latency		UMETA(ToolTip="Retunes the HTTP thread for responsiveness, ticking fast as soon as requests are in flight."),
+	Efficiency	UMETA(ToolTip="Retunes the HTTP thread to save power, only ticking fast under sustained load.")
+};
+
+/**
+ *	Hint about the power available to the device.
+ **/
+UENUM(BlueprintType)
+enum class EHttpPowerHint : uint8
+{
+	Auto		UMETA(ToolTip="Reads the battery state from the platform."),
+	Plugged		UMETA(ToolTip="The device isn't running on battery."),
+	OnBattery	UMETA(ToolTip="The device is running on battery."),
+	LowBattery	UMETA(ToolTip="The device is running low on battery.")
+};
+
+/**
+ *  HTTP thread frame and sleep times, in seconds.
+ **/
+struct BLUEPRINTHTTP_API FHttpThreadTiming
+{
+	float ActiveFrameTime	 = 0.f;
+	float ActiveMinimumSleep = 0.f;
+	float IdleFrameTime		 = 0.f;
+	float IdleMinimumSleep	 = 0.f;
+
+	static FHttpThreadTiming Lerp(const FHttpThreadTiming& A, const FHttpThreadTiming& B, const float Alpha);
+	bool IsNearlyEqual(const FHttpThreadTiming& Other, const float Tolerance) const;
+};
+
+/**
+ *  Retunes the HTTP thread from the number of requests in flight, the observed
+ *  throughput and the power available. Each preset tunes between a relaxed timing,
+ *  used when idle, and a busy timing, used under load. Running on battery limits
+ *  how far towards the busy timing the controller goes.
+ *
+ *  The chosen values are recorded in the BlueprintHttp stats group.
+ **/
+class BLUEPRINTHTTP_API FHttpThreadTuner
+{
+public:
+	/* Selects the preset. Manual stops retuning and leaves the last applied values. */
+	static void SetPreset(const EHttpThreadTuningPreset Preset);
+	static EHttpThreadTuningPreset GetPreset();
+
+	/* Overrides the power state read from the platform. */
+	static void SetPowerHint(const EHttpPowerHint Hint);
+	static EHttpPowerHint GetPowerHint();
+
+	/* Bookkeeping of the requests, called by UHttpRequest. */
+	static void NotifyRequestStarted();
+	static void NotifyRequestFinished();
+	static void NotifyBytesReceived(const int64 Bytes);
+
+	/* Returns the number of requests in flight. */
+	static int32 GetRequestsInFlight();
+
+	/* Returns the smoothed download throughput in bytes per second. */
+	static float GetThroughput();
+
+private:
+	static bool Tick(float DeltaTime);
+
+	static void Apply(const FHttpThreadTiming& Timing);
+
+	static EHttpPowerHint ResolvePowerHint();
+
+	static EHttpThreadTuningPreset Preset;
+	static EHttpPowerHint PowerHint;
+
+	static FTSTicker::FDelegateHandle TickerHandle;
+
+	static int32 RequestsInFlight;
+	static int64 BytesSinceLastTick;
+	static double LastTickTime;
+	static float Throughput;
+
+	static TOptional<FHttpThreadTiming> AppliedTiming;
+};
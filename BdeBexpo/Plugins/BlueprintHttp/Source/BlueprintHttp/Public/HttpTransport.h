@@ -0,0 +1,94 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpTransport.generated.h"
+
+class UHttpRequest;
+class UHttpResponse;
+
+/**
+ *	How requests reach their server.
+ **/
+UENUM(BlueprintType)
+enum class EHttpTransportMode : uint8
+{
+	Network	UMETA(ToolTip="Requests are sent to their server."),
+	Record	UMETA(ToolTip="Requests are sent to their server and each exchange is recorded to an archive."),
+	Replay	UMETA(ToolTip="Requests are served from a recorded archive. Nothing is sent on the network.")
+};
+
+/**
+ *  Carries a UHttpRequest to its server, or to something that answers like one,
+ *  and brings the response back through UHttpRequest::CompleteFromTransport()
+ *  or the native request's own delegates.
+ *  Transports are only used from the game thread.
+ **/
+class BLUEPRINTHTTP_API IHttpTransport
+{
+public:
+	virtual ~IHttpTransport() = default;
+
+	/**
+	 * Starts processing the request.
+	 * @return If the request was started. If it was, it must complete, even when cancelled.
+	 **/
+	virtual bool ProcessRequest(UHttpRequest* const Request) = 0;
+
+	/* Cancels a request previously started by this transport. */
+	virtual void CancelRequest(UHttpRequest* const Request) = 0;
+
+	/**
+	 * Lets the transport hold the completion of a request back.
+	 * @return True to take over the delivery, the transport then calls UHttpRequest::CompleteFromTransport() later.
+	 **/
+	virtual bool DeferCompletion(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully) { return false; }
+
+	/* Called before a request started by this transport broadcasts its completion. */
+	virtual void OnRequestCompleted(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully) {}
+
+	/* Returns the mode this transport implements. */
+	virtual EHttpTransportMode GetMode() const = 0;
+};
+
+/**
+ *  Registry of the transport new requests go through.
+ *  A request keeps the transport it was started with until it completes.
+ **/
+class BLUEPRINTHTTP_API FHttpTransports
+{
+public:
+	/* Returns the transport new requests are started with, wrapped by the network simulator when enabled. */
+	static TSharedRef<IHttpTransport> Get();
+
+	/* Returns the mode of the current transport without wrapping it for a request. */
+	static EHttpTransportMode GetMode();
+
+	/* Sets the transport new requests are started with. nullptr restores the network transport. */
+	static void Set(TSharedPtr<IHttpTransport> InTransport);
+
+	/* Returns the transport sending requests through the engine's HTTP module. */
+	static TSharedRef<IHttpTransport> GetNetwork();
+
+	/**
+	 * Switches to one of the built-in transports.
+	 * @param Mode					The transport to use.
+	 * @param ArchivePath			The archive to record to or to replay from.
+	 * @param bReplayOriginalTiming	When replaying, completes requests after the time they originally took.
+	 * @return If the transport could be set up. The current transport is kept otherwise.
+	 **/
+	static bool SetMode(const EHttpTransportMode Mode, const FString& ArchivePath, const bool bReplayOriginalTiming);
+
+	/* Saves the exchanges recorded so far. Returns false if not recording or if saving failed. */
+	static bool FlushRecording();
+
+	/* Reads -HttpRecord=<Archive>, -HttpReplay=<Archive> and -HttpReplayTiming from the command line. */
+	static void InitFromCommandLine();
+
+	/* Restores the network transport, saving any pending recording. */
+	static void Shutdown();
+
+private:
+	static TSharedPtr<IHttpTransport> Transport;
+};
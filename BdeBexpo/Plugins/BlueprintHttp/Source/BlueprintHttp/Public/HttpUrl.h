@@ -0,0 +1,102 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpUrl.generated.h"
+
+/**
+ *  A URL parsed once into its parts.
+ *
+ *  Path segments and query parameters are stored decoded. When a parameter is repeated,
+ *  the first value is kept. Parameter names are compared without case, as with GetURLParameter.
+ **/
+USTRUCT(BlueprintType)
+struct BLUEPRINTHTTP_API FHttpUrl
+{
+	GENERATED_BODY()
+public:
+	/* Lowercase scheme, such as "https". */
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|URL")
+	FString Scheme;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|URL")
+	FString Host;
+
+	/* The port written in the URL, 0 if it has none. */
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|URL")
+	int32 Port = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|URL")
+	TArray<FString> PathSegments;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|URL")
+	TMap<FString, FString> Query;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HTTP|URL")
+	FString Fragment;
+
+	/**
+	 * Parses an absolute URL.
+	 * @return False if it has no scheme or no host.
+	 **/
+	static bool Parse(FStringView Url, FHttpUrl& OutUrl);
+
+	/* Returns the decoded value of a query parameter, nullptr if the URL doesn't have it. */
+	const FString* FindQueryParameter(const FString& Name) const { return Query.Find(Name); }
+
+	/* Returns the port written in the URL, or the default port of its scheme. */
+	int32 GetEffectivePort() const;
+
+	/* Returns the encoded path, "/" if the URL has none. */
+	FString GetPath() const;
+
+	/* Returns the encoded URL. */
+	FString ToString() const;
+
+	bool IsValid() const { return !Scheme.IsEmpty() && !Host.IsEmpty(); }
+};
+
+/**
+ *  Builds URLs in one reserved buffer.
+ *
+ *  Path segments and query parameters are encoded in place. Rewind() goes back to the base
+ *  URL without freeing the buffer, so one builder can serve every request of a loop.
+ **/
+class BLUEPRINTHTTP_API FHttpUrlBuilder
+{
+public:
+	FHttpUrlBuilder() = default;
+
+	/* @param ExtraCapacity	Characters reserved for what will be added to the base URL. */
+	explicit FHttpUrlBuilder(FStringView BaseUrl, const int32 ExtraCapacity = 128);
+
+	/* Starts a new base URL, without its fragment. Keeps the buffer. */
+	FHttpUrlBuilder& Reset(FStringView BaseUrl, const int32 ExtraCapacity = 128);
+
+	/* Removes what was added since the base URL was set. */
+	FHttpUrlBuilder& Rewind();
+
+	/* Appends a path segment, with '/' encoded. Inserted before the query if there is one. */
+	FHttpUrlBuilder& AddPathSegment(FStringView Segment);
+
+	/* Appends each segment of a '/'-separated path. */
+	FHttpUrlBuilder& AddPath(FStringView Path);
+
+	FHttpUrlBuilder& AddQueryParameter(FStringView Name, FStringView Value);
+	FHttpUrlBuilder& AddQueryParameters(const TMap<FString, FString>& Parameters);
+
+	/* Returns the URL built so far. Valid until the builder changes. */
+	const FString& ToString() const { return Buffer; }
+
+	/* Returns a copy of the URL built so far. */
+	FString Build() const { return Buffer; }
+
+private:
+	FString Base;
+	FString Buffer;
+
+	// Where the query starts in the buffer, INDEX_NONE until there is one.
+	int32 BaseQueryStart = INDEX_NONE;
+	int32 QueryStart	 = INDEX_NONE;
+};
@@ -0,0 +1,213 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpRequest.h"
+#include "HttpWebSocket.generated.h"
+
+class IWebSocket;
+class UHttpWebSocket;
+
+UENUM(BlueprintType)
+enum class EHttpWebSocketState : uint8
+{
+	Closed		UMETA(ToolTip = "Not connected and not reconnecting."),
+	Connecting	UMETA(ToolTip = "Connecting or waiting to reconnect."),
+	Open		UMETA(ToolTip = "Connected, messages are sent and received.")
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam	  (FOnWebSocketConnected,		 UHttpWebSocket* const, Socket);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams  (FOnWebSocketMessage,			 UHttpWebSocket* const, Socket, const FString&,		 Message);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams  (FOnWebSocketBinaryMessage,	 UHttpWebSocket* const, Socket, const TArray<uint8>&, Data);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams (FOnWebSocketClosed,			 UHttpWebSocket* const, Socket, const int32, StatusCode, const FString&, Reason, const bool, bWillReconnect);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam	  (FOnWebSocketSendQueueDrained, UHttpWebSocket* const, Socket);
+
+/**
+ *  WebSocket client for the features that need the server to push messages and the client to answer
+ *  with a low latency, such as live counters and queues.
+ *
+ *  Messages are queued and handed to the socket with a byte budget per frame. A full queue refuses messages,
+ *  OnSendQueueDrained tells when sending can resume. Messages sent before the socket is open or while it
+ *  reconnects are delivered once connected.
+ *  The budget only limits what is handed to IWebSocket::Send, whose own buffer is unbounded: it doesn't follow
+ *  what the network actually sent, so a slow link still buffers in the socket. It also caps the throughput,
+ *  64KB a frame is about 3.8MB/s at 60 FPS.
+ *  Lost connections are reconnected with the backoff of ReconnectPolicy. Events are delivered on the game thread.
+ *  Keep a reference to the socket, it's closed when collected.
+ **/
+UCLASS(BlueprintType)
+class BLUEPRINTHTTP_API UHttpWebSocket : public UObject
+{
+	GENERATED_BODY()
+public:
+	UHttpWebSocket();
+
+	/**
+	 * Creates a WebSocket. Bind its events then call Connect().
+	 * @param Url		The ws:// or wss:// URL. http:// and https:// are converted.
+	 * @param Headers	Headers sent with the upgrade request.
+	 * @param Protocols	The subprotocols offered to the server.
+	 * @param Profile	The optional client profile. Url is then a path appended to its base URL, its headers are sent
+	 *					and its retry policy, when enabled, becomes the reconnect policy.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|WebSocket", meta = (AutoCreateRefTerm = "Headers,Protocols", AdvancedDisplay = "Protocols,Profile"))
+	static UPARAM(DisplayName = "WebSocket") UHttpWebSocket* CreateWebSocket(const FString& Url, const TMap<FString, FString>& Headers, const TArray<FString>& Protocols, const FName Profile = NAME_None);
+
+	/**
+	 * Opens the connection, closing the current one first. Queued messages are kept.
+	 * @return False if the URL isn't a WebSocket URL.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|WebSocket")
+	bool Connect();
+
+	/**
+	 * Closes the connection and stops reconnecting. Queued messages are dropped and no event is broadcast afterwards.
+	 * @param StatusCode	The close code sent to the server.
+	 * @param Reason		The close reason sent to the server.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|WebSocket", meta = (AdvancedDisplay = "StatusCode,Reason"))
+	void Close(const int32 StatusCode = 1000, const FString& Reason = TEXT(""));
+
+	/**
+	 * Queues a text message.
+	 * @return False if the queue is full, the message isn't sent.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|WebSocket")
+	UPARAM(DisplayName = "Queued") bool SendText(const FString& Message);
+
+	/**
+	 * Queues a binary message.
+	 * @return False if the queue is full, the message isn't sent.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "HTTP|WebSocket")
+	UPARAM(DisplayName = "Queued") bool SendBinary(const TArray<uint8>& Data);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|WebSocket")
+	UPARAM(DisplayName = "State") EHttpWebSocketState GetState() const;
+
+	/* Returns the size of the messages waiting to be handed to the socket, after compression. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|WebSocket")
+	UPARAM(DisplayName = "Bytes") int64 GetQueuedBytes() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|WebSocket")
+	UPARAM(DisplayName = "Messages") int32 GetQueuedMessageCount() const;
+
+	/* Returns the URL connected to, with the base URL of the profile. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HTTP|WebSocket")
+	UPARAM(DisplayName = "URL") FString GetUrl() const;
+
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|WebSocket")
+	FOnWebSocketConnected OnConnected;
+
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|WebSocket")
+	FOnWebSocketMessage OnMessage;
+
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|WebSocket")
+	FOnWebSocketBinaryMessage OnBinaryMessage;
+
+	/**
+	 * Called when the connection was lost or refused. The status code is zero for connection errors.
+	 * Connections are reconnected after connection errors, unclean closes and the 1001, 1006 and 1011 to 1014 codes.
+	 **/
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|WebSocket")
+	FOnWebSocketClosed OnClosed;
+
+	/* Called when the queue emptied after it refused a message. */
+	UPROPERTY(BlueprintAssignable, Category = "HTTP|WebSocket")
+	FOnWebSocketSendQueueDrained OnSendQueueDrained;
+
+	/* Backoff between reconnections. MaxRetries is the number of failed attempts in a row before giving up, zero disables reconnecting. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|WebSocket")
+	FHttpRetryPolicy ReconnectPolicy;
+
+	/* Size of the queued messages above which messages are refused. Zero to not limit it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|WebSocket", meta = (ClampMin = "0", Units = "Bytes"))
+	int64 MaxQueuedBytes = 1024 * 1024;
+
+	/**
+	 * Bytes handed to the socket each frame, at least one message is. Zero to send the whole queue at once.
+	 * This bounds the sending rate to MaxBytesPerFrame times the frame rate, not to what the connection sent.
+	 **/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|WebSocket", meta = (ClampMin = "0", Units = "Bytes"))
+	int32 MaxBytesPerFrame = 64 * 1024;
+
+	/* Largest message accepted from the server, after decompression. The connection is closed with 1009 above it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|WebSocket", meta = (ClampMin = "0", Units = "Bytes"))
+	int32 MaxMessageSize = 16 * 1024 * 1024;
+
+	/**
+	 * Compresses the messages larger than CompressionThreshold with zlib, each on its own, in a framing of this plugin.
+	 * This isn't the standard permessage-deflate extension, which the engine doesn't expose: compressed messages are binary
+	 * messages starting with "BHZ", the type of the original message ('T' or 'B') and its size on 4 little-endian bytes.
+	 * Both ends must enable it, an echo server returns them unchanged.
+	 **/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|WebSocket")
+	bool bUseCustomCompressionFraming = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HTTP|WebSocket", meta = (ClampMin = "0", Units = "Bytes", EditCondition = "bUseCustomCompressionFraming"))
+	int32 CompressionThreshold = 1024;
+
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	//~ End UObject Interface
+
+private:
+	struct FQueuedMessage
+	{
+		TArray<uint8> Data;
+		bool bBinary;
+	};
+
+	bool StartConnection();
+
+	/* Unbinds the native socket and closes it without broadcasting. */
+	void ReleaseSocket(const int32 StatusCode, const FString& Reason, const bool bCloseSocket = true);
+
+	void HandleDisconnect(const int32 StatusCode, const FString& Reason, const bool bWasClean);
+	void ScheduleReconnect();
+
+	bool Enqueue(TArray<uint8>&& Data, const bool bBinary);
+
+	/* Hands queued messages to the socket within the budget of the frame. Returns true while messages remain. */
+	bool FlushQueue();
+
+	/* Flushes the queue and ticks until what remains is sent. */
+	void ScheduleFlush();
+
+	void DeliverMessage(const uint8* const Data, const int64 Length, const bool bBinary);
+
+	void OnSocketConnected();
+	void OnSocketConnectionError(const FString& Error);
+	void OnSocketClosed(const int32 StatusCode, const FString& Reason, const bool bWasClean);
+	void OnSocketMessage(const FString& Message);
+	void OnSocketBinaryMessage(const void* Data, SIZE_T Size, bool bIsLastFragment);
+
+	TSharedPtr<IWebSocket> Socket;
+
+	FString Url;
+	TMap<FString, FString> Headers;
+	TArray<FString> Protocols;
+
+	EHttpWebSocketState State;
+
+	// Failed attempts since the socket was last open.
+	int32 ReconnectAttempts;
+
+	TArray<FQueuedMessage> Queue;
+	int64 QueuedBytes;
+
+	// Set when a message was refused, until the queue drained.
+	bool bBackpressured;
+
+	// Bytes handed to the socket during FrameCounter.
+	uint64 FrameCounter;
+	int64  FrameBytesSent;
+
+	// The fragments of the binary message being received.
+	TArray<uint8> PartialMessage;
+
+	FTSTicker::FDelegateHandle ReconnectHandle;
+	FTSTicker::FDelegateHandle FlushHandle;
+};
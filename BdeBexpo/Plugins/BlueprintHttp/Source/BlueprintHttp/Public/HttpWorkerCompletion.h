@@ -0,0 +1,56 @@
+// Copyright Pandores Marketplace 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+
+class IHttpResponse;
+
+/**
+ *  Result of a request, safe to read from any thread.
+ *  UObjects must not be touched from a worker: use MarshalToGameThread() to get back
+ *  to the game thread and to the UHttpRequest.
+ **/
+struct BLUEPRINTHTTP_API FHttpWorkerCompletion
+{
+	FString URL;
+
+	int32 ResponseCode = 0;
+
+	bool bConnectedSuccessfully = false;
+
+	EBlueprintHttpRequestStatus Status = EBlueprintHttpRequestStatus::Failed;
+
+	/* Time it took for the request to complete, in seconds. */
+	float ElapsedTime = 0.f;
+
+	/* Returns the response body. */
+	const TArray<uint8>& GetContent() const;
+
+	/* Returns the value of the response header or an empty string. */
+	FString GetHeader(const FString& Key) const;
+
+	/* Returns the raw "Key: Value" response header lines. */
+	TArray<FString> GetAllHeaders() const;
+
+	/**
+	 * Runs Callback on the game thread with the request, or with nullptr if it was destroyed meanwhile.
+	 * The completion is copied and can be captured by Callback.
+	 **/
+	void MarshalToGameThread(TUniqueFunction<void(UHttpRequest* const Request)> Callback) const;
+
+	/* Captures the completion of a request. Game thread only. */
+	static TSharedRef<const FHttpWorkerCompletion, ESPMode::ThreadSafe> Capture(UHttpRequest* const Request, UHttpResponse* const Response, const bool bConnectedSuccessfully);
+
+private:
+	TWeakObjectPtr<UHttpRequest> Request;
+
+	// One of them is set when a response was received.
+	TSharedPtr<IHttpResponse, ESPMode::ThreadSafe> NativeResponse;
+	TSharedPtr<const FHttpResponseSnapshot, ESPMode::ThreadSafe> Snapshot;
+
+	// Holds the content instead of NativeResponse when set.
+	TSharedPtr<FHttpResponseBody, ESPMode::ThreadSafe> Body;
+};